@@ -58,6 +58,9 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) override;
 
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& w,
+                                                              const PreComputation&) override;
+
  protected:
   LinearSystemDynamics(const LinearSystemDynamics& other) = default;
 
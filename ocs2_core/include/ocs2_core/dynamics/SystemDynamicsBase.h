@@ -83,6 +83,21 @@ class SystemDynamicsBase : public ControlledSystemBase {
   /** Computes the guard surfaces linear approximation */
   virtual VectorFunctionLinearApproximation guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the Hessian of the flow map contracted with a weight vector, i.e. the second derivatives of \f$ w^T f(t,x,u) \f$
+   * with respect to the state and the input. The second-order DDP uses it with the gradient of the value function as the weight.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in] u: The current input.
+   * @param [in] w: The weight vector of size \f$ n_x \f$.
+   * @param [in] preComp: pre-computation module, safely ignore this parameter if not used.
+   *                      @see PreComputation class documentation.
+   * @return The second-order terms dfdxx, dfdux, and dfduu of \f$ w^T f \f$. The value and the first-order terms are set to zero.
+   */
+  virtual ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& w,
+                                                                      const PreComputation& preComp);
+
   /**
    * Get partial time derivative of the system flow map.
    * \f$ \frac{\partial f}{\partial t}  \f$.
@@ -59,9 +59,11 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
    * @param modelFolder : folder to save the model library files to
    * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
    * @param verbose : print information.
+   * @param generateFlowMapHessian : If true, the flow map library also contains the second-order derivatives which are required by
+   *                                 flowMapWeightedHessian().
    */
   void initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
-                  bool recompileLibraries = true, bool verbose = true);
+                  bool recompileLibraries = true, bool verbose = true, bool generateFlowMapHessian = false);
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComputation) final;
 
@@ -76,6 +78,10 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
 
   VectorFunctionLinearApproximation guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) final;
 
+  /** @note: Requires the library to be generated with generateFlowMapHessian set to true */
+  ScalarFunctionQuadraticApproximation flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u, const vector_t& w,
+                                                              const PreComputation& preComputation) final;
+
   /** @note: Requires linear approximation to be called before */
   vector_t flowMapDerivativeTime(scalar_t t, const vector_t& x, const vector_t& u) final;
 
@@ -172,6 +178,8 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   std::unique_ptr<CppAdInterface> jumpMapADInterfacePtr_;
   std::unique_ptr<CppAdInterface> guardSurfacesADInterfacePtr_;
 
+  bool flowMapHessianAvailable_ = false;
+
   vector_t tapedTimeStateInput_;
   vector_t tapedTimeState_;
 
@@ -87,4 +87,16 @@ using DynamicsSensitivityDiscretizer =
  */
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType);
 
+/**
+ * A function handle to compute the linear approximation of the discretized system's flowmap into the given storage.
+ * The arguments are the same as DynamicsSensitivityDiscretizer, followed by the output approximation.
+ */
+using DynamicsSensitivityDiscretizerInPlace = std::function<void(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t,
+                                                                 VectorFunctionLinearApproximation&)>;
+
+/**
+ * Select available in-place integrator based on enum
+ */
+DynamicsSensitivityDiscretizerInPlace selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType integratorType);
+
 }  // namespace ocs2
\ No newline at end of file
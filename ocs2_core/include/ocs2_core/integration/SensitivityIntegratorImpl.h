@@ -48,6 +48,12 @@ vector_t eulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vecto
 VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
                                                                  const vector_t& u, scalar_t dt);
 
+/**
+ * Same as above, but writes the approximation into the given storage.
+ */
+void eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                    VectorFunctionLinearApproximation& approximation);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 2nd order discretization.
  * Returns x_{k+1}
@@ -62,6 +68,13 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Same as above, but writes the approximation into the given storage. Its memory is re-used for the temporaries of the discretization,
+ * therefore only the system's linear approximations allocate if the approximation already has the right size.
+ */
+void rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  VectorFunctionLinearApproximation& approximation);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 4th order discretization.
  * Returns x_{k+1}
@@ -76,4 +89,11 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Same as above, but writes the approximation into the given storage. Its memory is re-used for the temporaries of the discretization,
+ * therefore only the system's linear approximations allocate if the approximation already has the right size.
+ */
+void rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  VectorFunctionLinearApproximation& approximation);
+
 }  // namespace ocs2
\ No newline at end of file
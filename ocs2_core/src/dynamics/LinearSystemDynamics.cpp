@@ -88,4 +88,12 @@ VectorFunctionLinearApproximation LinearSystemDynamics::jumpMapLinearApproximati
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation LinearSystemDynamics::flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                                  const vector_t& w, const PreComputation&) {
+  return ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
+}
+
 }  // namespace ocs2
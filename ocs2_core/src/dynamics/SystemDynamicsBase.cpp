@@ -83,6 +83,14 @@ VectorFunctionLinearApproximation SystemDynamicsBase::guardSurfacesLinearApproxi
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SystemDynamicsBase::flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                                const vector_t& w, const PreComputation& preComp) {
+  throw std::runtime_error("[SystemDynamicsBase::flowMapWeightedHessian] The second-order derivatives of the flow map are not provided!");
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
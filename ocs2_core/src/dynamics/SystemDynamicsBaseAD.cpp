@@ -44,6 +44,7 @@ SystemDynamicsBaseAD::SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs)
       flowMapADInterfacePtr_(new CppAdInterface(*rhs.flowMapADInterfacePtr_)),
       jumpMapADInterfacePtr_(new CppAdInterface(*rhs.jumpMapADInterfacePtr_)),
       guardSurfacesADInterfacePtr_(new CppAdInterface(*rhs.guardSurfacesADInterfacePtr_)),
+      flowMapHessianAvailable_(rhs.flowMapHessianAvailable_),
       tapedTimeStateInput_(rhs.tapedTimeStateInput_.size()),
       tapedTimeState_(rhs.tapedTimeState_.size()),
       flowJacobian_(rhs.flowJacobian_.rows(), rhs.flowJacobian_.cols()),
@@ -54,7 +55,8 @@ SystemDynamicsBaseAD::SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder,
-                                      bool recompileLibraries, bool verbose) {
+                                      bool recompileLibraries, bool verbose, bool generateFlowMapHessian) {
+  flowMapHessianAvailable_ = generateFlowMapHessian;
   tapedTimeStateInput_.resize(1 + stateDim + inputDim);
   tapedTimeState_.resize(1 + stateDim);
 
@@ -64,8 +66,9 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
     const ad_vector_t input = x.tail(inputDim);
     y = this->systemFlowMap(time, state, input, p);
   };
-  flowMapADInterfacePtr_.reset(
-      new CppAdInterface(flowMap, 1 + stateDim + inputDim, getNumFlowMapParameters(), modelName + "_flow_map", modelFolder));
+  // a separate library for the second-order model, such that a previously generated first-order library is not loaded instead
+  const std::string flowMapName = modelName + (generateFlowMapHessian ? "_flow_map_second_order" : "_flow_map");
+  flowMapADInterfacePtr_.reset(new CppAdInterface(flowMap, 1 + stateDim + inputDim, getNumFlowMapParameters(), flowMapName, modelFolder));
 
   auto jumpMap = [this, stateDim](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
     const ad_scalar_t time = x(0);
@@ -82,12 +85,13 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   guardSurfacesADInterfacePtr_.reset(
       new CppAdInterface(guardSurfaces, 1 + stateDim, getNumGuardSurfacesParameters(), modelName + "_guard_surfaces", modelFolder));
 
+  const auto flowMapOrder = generateFlowMapHessian ? CppAdInterface::ApproximationOrder::Second : CppAdInterface::ApproximationOrder::First;
   if (recompileLibraries) {
-    flowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    flowMapADInterfacePtr_->createModels(flowMapOrder, verbose);
     jumpMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
     guardSurfacesADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    flowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    flowMapADInterfacePtr_->loadModelsIfAvailable(flowMapOrder, verbose);
     jumpMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
     guardSurfacesADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
   }
@@ -167,6 +171,29 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::guardSurfacesLinearAppro
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation SystemDynamicsBaseAD::flowMapWeightedHessian(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                                  const vector_t& w, const PreComputation& preComputation) {
+  if (!flowMapHessianAvailable_) {
+    throw std::runtime_error(
+        "[SystemDynamicsBaseAD::flowMapWeightedHessian] The flow map library is generated without the second-order derivatives!");
+  }
+
+  tapedTimeStateInput_ << t, x, u;
+  const vector_t parameters = getFlowMapParameters(t, preComputation);
+  // the weighted Hessian is a single forward-reverse sweep of the generated model, the tensor is never formed
+  const matrix_t hessian = flowMapADInterfacePtr_->getHessian(w, tapedTimeStateInput_, parameters);
+
+  ScalarFunctionQuadraticApproximation approximation;
+  approximation.setZero(x.rows(), u.rows());
+  approximation.dfdxx = hessian.block(1, 1, x.rows(), x.rows());
+  approximation.dfdux = hessian.block(1 + x.rows(), 1, u.rows(), x.rows());
+  approximation.dfduu = hessian.bottomRightCorner(u.rows(), u.rows());
+  return approximation;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -55,13 +55,32 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
 /******************************************************************************************************/
 /******************************************************************************************************/
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType) {
+  using Discretizer = VectorFunctionLinearApproximation (*)(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t);
   switch (integratorType) {
     case SensitivityIntegratorType::EULER:
-      return eulerSensitivityDiscretization;
+      return static_cast<Discretizer>(eulerSensitivityDiscretization);
     case SensitivityIntegratorType::RK2:
-      return rk2SensitivityDiscretization;
+      return static_cast<Discretizer>(rk2SensitivityDiscretization);
     case SensitivityIntegratorType::RK4:
-      return rk4SensitivityDiscretization;
+      return static_cast<Discretizer>(rk4SensitivityDiscretization);
+    default:
+      throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsSensitivityDiscretizerInPlace selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType integratorType) {
+  using Discretizer =
+      void (*)(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t, VectorFunctionLinearApproximation&);
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      return static_cast<Discretizer>(eulerSensitivityDiscretization);
+    case SensitivityIntegratorType::RK2:
+      return static_cast<Discretizer>(rk2SensitivityDiscretization);
+    case SensitivityIntegratorType::RK4:
+      return static_cast<Discretizer>(rk4SensitivityDiscretization);
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
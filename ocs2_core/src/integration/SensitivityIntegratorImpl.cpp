@@ -45,16 +45,25 @@ vector_t eulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vecto
 /******************************************************************************************************/
 VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
                                                                  const vector_t& u, scalar_t dt) {
+  VectorFunctionLinearApproximation approximation;
+  eulerSensitivityDiscretization(system, t, x, u, dt, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                    VectorFunctionLinearApproximation& approximation) {
   // x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
   // A_{k} = Id + dt * dfdx
   // B_{k} = dt * dfdu
   // b_{k} = x_{n} + dt * f(x_{n},u_{n})
-  auto continuousApproximation = system.linearApproximation(t, x, u);
-  continuousApproximation.dfdx *= dt;
-  continuousApproximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
-  continuousApproximation.dfdu *= dt;
-  continuousApproximation.f = x + dt * continuousApproximation.f;
-  return continuousApproximation;
+  approximation = system.linearApproximation(t, x, u);
+  approximation.dfdx *= dt;
+  approximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  approximation.dfdu *= dt;
+  approximation.f = x + dt * approximation.f;
 }
 
 /******************************************************************************************************/
@@ -78,11 +87,23 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 /******************************************************************************************************/
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
+  VectorFunctionLinearApproximation approximation;
+  rk2SensitivityDiscretization(system, t, x, u, dt, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  VectorFunctionLinearApproximation& approximation) {
   const scalar_t dt_halve = dt / 2.0;
 
   // System evaluations
-  VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt, x + dt * k1.f, u);
+  // Re-use the memory of the result as the temporary state
+  const VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
+  approximation.f = x + dt * k1.f;
+  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt, approximation.f, u);
 
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
@@ -92,15 +113,14 @@ VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBas
   // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
   // Re-use memory from k.dfdx as dkdxk
   // dk1dxk = k1.dfdx;
-  k2.dfdx += dt * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  approximation.dfdx.noalias() = dt * k2.dfdx * k1.dfdx;  // the memory of the result avoids the alias
+  k2.dfdx += approximation.dfdx;
 
   // Assemble discrete approximation
-  // Re-use k1 to collect the result
-  k1.dfdx = dt_halve * k1.dfdx + dt_halve * k2.dfdx;
-  k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
-  k1.dfdu = dt_halve * k1.dfdu + dt_halve * k2.dfdu;
-  k1.f = x + dt_halve * k1.f + dt_halve * k2.f;
-  return k1;
+  approximation.dfdx = dt_halve * k1.dfdx + dt_halve * k2.dfdx;
+  approximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  approximation.dfdu = dt_halve * k1.dfdu + dt_halve * k2.dfdu;
+  approximation.f = x + dt_halve * k1.f + dt_halve * k2.f;
 }
 
 /******************************************************************************************************/
@@ -129,18 +149,29 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 /******************************************************************************************************/
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
+  VectorFunctionLinearApproximation approximation;
+  rk4SensitivityDiscretization(system, t, x, u, dt, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  VectorFunctionLinearApproximation& approximation) {
   const scalar_t dt_halve = dt / 2.0;
   const scalar_t dt_sixth = dt / 6.0;
   const scalar_t dt_third = dt / 3.0;
 
   // System evaluations
+  // Re-use the memory of the result as the temporary state
   VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  vector_t tmpV = x + dt_halve * k1.f;
-  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, tmpV, u);
-  tmpV = x + dt_halve * k2.f;
-  VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt_halve, tmpV, u);
-  tmpV = x + dt * k3.f;
-  VectorFunctionLinearApproximation k4 = system.linearApproximation(t + dt, tmpV, u);
+  approximation.f = x + dt_halve * k1.f;
+  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, approximation.f, u);
+  approximation.f = x + dt_halve * k2.f;
+  VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt_halve, approximation.f, u);
+  approximation.f = x + dt * k3.f;
+  VectorFunctionLinearApproximation k4 = system.linearApproximation(t + dt, approximation.f, u);
 
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
@@ -152,20 +183,18 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
   // Re-use memory from k.dfdx as dkdxk
   // dk1dxk = k1.dfdx;
-  matrix_t tmp = dt_halve * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
-  k2.dfdx += tmp;
-  tmp.noalias() = dt_halve * k3.dfdx * k2.dfdx;
-  k3.dfdx += tmp;
-  tmp.noalias() = dt * k4.dfdx * k3.dfdx;
-  k4.dfdx += tmp;
+  approximation.dfdx.noalias() = dt_halve * k2.dfdx * k1.dfdx;  // the memory of the result avoids the alias
+  k2.dfdx += approximation.dfdx;
+  approximation.dfdx.noalias() = dt_halve * k3.dfdx * k2.dfdx;
+  k3.dfdx += approximation.dfdx;
+  approximation.dfdx.noalias() = dt * k4.dfdx * k3.dfdx;
+  k4.dfdx += approximation.dfdx;
 
   // Assemble discrete approximation
-  // Re-use k1 to collect the result
-  k1.dfdx = dt_sixth * k1.dfdx + dt_third * k2.dfdx + dt_third * k3.dfdx + dt_sixth * k4.dfdx;
-  k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
-  k1.dfdu = dt_sixth * k1.dfdu + dt_third * k2.dfdu + dt_third * k3.dfdu + dt_sixth * k4.dfdu;
-  k1.f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
-  return k1;
+  approximation.dfdx = dt_sixth * k1.dfdx + dt_third * k2.dfdx + dt_third * k3.dfdx + dt_sixth * k4.dfdx;
+  approximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  approximation.dfdu = dt_sixth * k1.dfdu + dt_third * k2.dfdu + dt_third * k3.dfdu + dt_sixth * k4.dfdu;
+  approximation.f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
 }
 
 }  // namespace ocs2
\ No newline at end of file
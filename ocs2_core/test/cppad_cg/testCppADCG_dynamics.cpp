@@ -142,3 +142,51 @@ TEST_F(testCppADCG_dynamicsFixture, multithread_test) {
 
   ASSERT_TRUE(success && successClone);
 }
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
+TEST(testCppADCG_dynamics, flow_map_weighted_hessian) {
+  // dx/dt = [cos(x2) * u0, sin(x2) * u0, x0 * x1 * u1]
+  class NonlinearSystemDynamicsAD final : public SystemDynamicsBaseAD {
+   public:
+    NonlinearSystemDynamicsAD() = default;
+    ~NonlinearSystemDynamicsAD() override = default;
+    NonlinearSystemDynamicsAD* clone() const override { return new NonlinearSystemDynamicsAD(*this); }
+
+   protected:
+    NonlinearSystemDynamicsAD(const NonlinearSystemDynamicsAD& rhs) = default;
+
+    ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                              const ad_vector_t& parameters) const override {
+      ad_vector_t dxdt(3);
+      dxdt << cos(state(2)) * input(0), sin(state(2)) * input(0), state(0) * state(1) * input(1);
+      return dxdt;
+    }
+  };
+
+  boost::filesystem::path filePath(__FILE__);
+  const std::string libraryFolder = filePath.parent_path().generic_string() + "/testCppADCG_generated";
+  NonlinearSystemDynamicsAD system;
+  system.initialize(3, 2, "testCppADCG_dynamics_hessian", libraryFolder, true, false, true);
+  std::unique_ptr<SystemDynamicsBase> systemPtr(system.clone());
+
+  for (size_t i = 0; i < 10; i++) {
+    const vector_t x = vector_t::Random(3);
+    const vector_t u = vector_t::Random(2);
+    const vector_t w = vector_t::Random(3);
+
+    matrix_t dfdxx = matrix_t::Zero(3, 3);
+    dfdxx(0, 1) = dfdxx(1, 0) = w(2) * u(1);
+    dfdxx(2, 2) = -(w(0) * std::cos(x(2)) + w(1) * std::sin(x(2))) * u(0);
+    matrix_t dfdux = matrix_t::Zero(2, 3);
+    dfdux(0, 2) = -w(0) * std::sin(x(2)) + w(1) * std::cos(x(2));
+    dfdux(1, 0) = w(2) * x(1);
+    dfdux(1, 1) = w(2) * x(0);
+
+    const auto hessian = systemPtr->flowMapWeightedHessian(0.0, x, u, w, PreComputation());
+    EXPECT_TRUE(hessian.dfdxx.isApprox(dfdxx, 1e-9));
+    EXPECT_TRUE(hessian.dfdux.isApprox(dfdux, 1e-9));
+    EXPECT_TRUE(hessian.dfduu.isZero());
+  }
+}
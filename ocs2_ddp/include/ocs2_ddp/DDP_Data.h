@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/ModelData.h>
@@ -40,6 +43,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * Resizes a trajectory while preserving the heap memory owned by its elements, e.g. the matrices of ModelData. Unlike
+ * std::vector::resize, the elements removed from the end of the trajectory are not destroyed but moved to the spare array, and
+ * they are moved back when the trajectory grows again. Therefore, the storage is kept at the high-water mark of the trajectory
+ * size and the elements can be overwritten in place without heap allocation as long as their dimensions do not change.
+ *
+ * @param [in] size: The new size of the trajectory.
+ * @param [in, out] trajectory: The trajectory to be resized.
+ * @param [in, out] spare: The storage of the elements which are currently not used.
+ */
+template <typename Data>
+void resizeTrajectory(size_t size, std::vector<Data>& trajectory, std::vector<Data>& spare) {
+  if (trajectory.size() > size && spare.capacity() < trajectory.capacity()) {
+    spare.reserve(trajectory.capacity());  // the total number of elements never exceeds the capacity of the trajectory
+  }
+  while (trajectory.size() > size) {
+    spare.push_back(std::move(trajectory.back()));
+    trajectory.pop_back();
+  }
+  while (trajectory.size() < size && !spare.empty()) {
+    trajectory.push_back(std::move(spare.back()));
+    spare.pop_back();
+  }
+  trajectory.resize(size);
+}
+
 /**
  * Primal data container
  *
@@ -58,8 +87,17 @@ struct PrimalDataContainer {
   ModelData modelDataFinalTime;
   // event times model data
   std::vector<ModelData> modelDataEventTimes;
-  // intermediate model data trajectory
+  // intermediate model data trajectory. SLQ only stores it if the LQ approximation is reused by the next iteration.
   std::vector<ModelData> modelDataTrajectory;
+  // model data which are currently not used, they are kept to preserve their memory
+  std::vector<ModelData> modelDataEventTimesSpare;
+  std::vector<ModelData> modelDataTrajectorySpare;
+
+  /** Resizes modelDataEventTimes while preserving the memory of the model data, see resizeTrajectory(). */
+  void resizeModelDataEventTimes(size_t size) { resizeTrajectory(size, modelDataEventTimes, modelDataEventTimesSpare); }
+
+  /** Resizes modelDataTrajectory while preserving the memory of the model data, see resizeTrajectory(). */
+  void resizeModelDataTrajectory(size_t size) { resizeTrajectory(size, modelDataTrajectory, modelDataTrajectorySpare); }
 
   void swap(PrimalDataContainer& other) {
     primalSolution.swap(other.primalSolution);
@@ -67,13 +105,16 @@ struct PrimalDataContainer {
     std::swap(modelDataFinalTime, other.modelDataFinalTime);
     modelDataEventTimes.swap(other.modelDataEventTimes);
     modelDataTrajectory.swap(other.modelDataTrajectory);
+    modelDataEventTimesSpare.swap(other.modelDataEventTimesSpare);
+    modelDataTrajectorySpare.swap(other.modelDataTrajectorySpare);
   }
 
+  /** Clears the content. The model data are kept in the spare arrays to be reused. */
   void clear() {
     primalSolution.clear();
     problemMetrics.clear();
-    modelDataEventTimes.clear();
-    modelDataTrajectory.clear();
+    resizeModelDataEventTimes(0);
+    resizeModelDataTrajectory(0);
   }
 };
 
@@ -87,25 +128,41 @@ struct PrimalDataContainer {
 struct DualDataContainer {
   // Dual solution
   DualSolution dualSolution;
-  // projected model data trajectory
+  // projected model data trajectory. ILQR only stores the projected state-input equality constraints.
   std::vector<ModelData> projectedModelDataTrajectory;
   // Riccati modification
   std::vector<riccati_modification::Data> riccatiModificationTrajectory;
   // Riccati solution coefficients
   std::vector<ScalarFunctionQuadraticApproximation> valueFunctionTrajectory;
+  // data which are currently not used, they are kept to preserve their memory
+  std::vector<ModelData> projectedModelDataSpare;
+  std::vector<riccati_modification::Data> riccatiModificationSpare;
+  std::vector<ScalarFunctionQuadraticApproximation> valueFunctionSpare;
+
+  /** Resizes projectedModelDataTrajectory and riccatiModificationTrajectory while preserving their memory, see resizeTrajectory(). */
+  void resizeProjectedModelData(size_t size) {
+    resizeTrajectory(size, projectedModelDataTrajectory, projectedModelDataSpare);
+    resizeTrajectory(size, riccatiModificationTrajectory, riccatiModificationSpare);
+  }
+
+  /** Resizes valueFunctionTrajectory while preserving the memory of its elements, see resizeTrajectory(). */
+  void resizeValueFunction(size_t size) { resizeTrajectory(size, valueFunctionTrajectory, valueFunctionSpare); }
 
   void swap(DualDataContainer& other) {
     dualSolution.swap(other.dualSolution);
     projectedModelDataTrajectory.swap(other.projectedModelDataTrajectory);
     riccatiModificationTrajectory.swap(other.riccatiModificationTrajectory);
     valueFunctionTrajectory.swap(other.valueFunctionTrajectory);
+    projectedModelDataSpare.swap(other.projectedModelDataSpare);
+    riccatiModificationSpare.swap(other.riccatiModificationSpare);
+    valueFunctionSpare.swap(other.valueFunctionSpare);
   }
 
+  /** Clears the content. The elements of the trajectories are kept in the spare arrays to be reused. */
   void clear() {
     dualSolution.clear();
-    projectedModelDataTrajectory.clear();
-    riccatiModificationTrajectory.clear();
-    valueFunctionTrajectory.clear();
+    resizeProjectedModelData(0);
+    resizeValueFunction(0);
   }
 };
 
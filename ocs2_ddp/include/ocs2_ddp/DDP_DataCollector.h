@@ -95,6 +95,9 @@ class DDP_DataCollector {
   // model data trajectory
   std::vector<std::vector<ModelData>> modelDataTrajectoriesStock_;
 
+  // number of nodes whose LQ approximation was reused from the previous iteration instead of being re-approximated
+  size_t numReusedLqNodes_ = 0;
+
   // event times model data
   std::vector<std::vector<ModelData>> modelDataEventTimesStock_;
 
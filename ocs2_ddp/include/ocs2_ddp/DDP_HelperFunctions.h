@@ -91,6 +91,17 @@ scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector
 void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjector, const matrix_t& constraintNullProjector,
                ModelData& projectedModelData);
 
+/**
+ * Corrects an LQ approximation to first order for a small deviation of its state and input. The cost is shifted along its
+ * quadratic model, and the flow map and the constant terms of the constraints along their linear models. The Jacobians, the
+ * Hessians, and dynamicsBias are kept unchanged.
+ *
+ * @param [in] deltaState: The deviation of the state from the point of the LQ approximation.
+ * @param [in] deltaInput: The deviation of the input from the point of the LQ approximation.
+ * @param [in, out] modelData: The LQ approximation.
+ */
+void correctIntermediateLQ(const vector_t& deltaState, const vector_t& deltaInput, ModelData& modelData);
+
 /**
  * Extract a primal solution for the range [initTime, finalTime] from a given primal solution. It assumes that the
  * given range is within the solution time of input primal solution.
@@ -41,9 +41,11 @@ namespace ddp {
 
 /**
  * @brief The DDP algorithm enum
- * Enum used in selecting either SLQ, ILQR algorithms.
+ * Enum used in selecting either SLQ, ILQR, or DDP algorithms. DDP is the discrete-time ILQR which additionally includes the
+ * second-order derivatives of the dynamics in the backward pass. It requires SystemDynamicsBase::flowMapWeightedHessian(), the
+ * EIGENVALUE_MODIFICATION Hessian correction of the line search settings, and incrementalLqApproximation_ to be disabled.
  */
-enum class Algorithm { SLQ, ILQR };
+enum class Algorithm { SLQ, ILQR, DDP };
 
 /**
  * Get string name of DDP algorithm type
@@ -61,7 +63,7 @@ Algorithm fromAlgorithmName(std::string name);
  * This structure contains the settings for the DDP algorithm.
  */
 struct Settings {
-  /** It should be either SLQ or ILQR */
+  /** It should be either SLQ, ILQR, or DDP */
   Algorithm algorithm_ = Algorithm::SLQ;
 
   /** Number of threads used in the multi-threading scheme. */
@@ -95,6 +97,12 @@ struct Settings {
   scalar_t timeStep_ = 1e-2;
   /** The backward pass integrator type: SLQ uses it for solving Riccati equation and ILQR uses it for discretizing LQ approximation. */
   IntegratorType backwardPassIntegratorType_ = IntegratorType::ODE45;
+  /**
+   * If positive, SLQ integrates the Riccati equations with this fixed number of RK4 substeps per interval of the nominal time
+   * trajectory instead of using backwardPassIntegratorType_. The backward pass then evaluates the Riccati flow map exactly
+   * 4 * backwardPassNumSubsteps_ times per interval, which bounds its runtime. This option is ignored by ILQR.
+   */
+  size_t backwardPassNumSubsteps_ = 0;
 
   /** The initial coefficient of the quadratic penalty function in the merit function. It should be greater than one. */
   scalar_t constraintPenaltyInitialValue_ = 2.0;
@@ -104,6 +112,24 @@ struct Settings {
   /** If true, terms of the Riccati equation will be pre-computed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
 
+  /**
+   * If true, ILQR solves the Riccati equations in parallel over the horizon with an associative scan, which gives the same result as
+   * the sequential solution. Otherwise, the horizon is partitioned and each partition is initialized by the previous iteration's
+   * value function. This option is ignored by SLQ.
+   */
+  bool parallelRiccatiScan_ = false;
+
+  /**
+   * If true, the intermediate LQ approximation of a node is reused from the previous iteration of the same run when its time
+   * stamp, state, input, and multipliers have changed less than lqReuseTolerance_ (infinity norm). Otherwise, all the nodes are
+   * re-approximated at every iteration.
+   */
+  bool incrementalLqApproximation_ = false;
+  /** The maximum deviation (infinity norm) of a node for which its LQ approximation is reused. */
+  scalar_t lqReuseTolerance_ = 1e-6;
+  /** If true, the cost and constraints of a reused LQ approximation are corrected to first order for the node's deviation. */
+  bool lqReuseFirstOrderCorrection_ = true;
+
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
 
@@ -109,6 +109,27 @@ class GaussNewtonDDP : public SolverBase {
 
   std::string getBenchmarkingInfo() const override;
 
+  /**
+   * Gets the timer of the backward pass. It keeps the duration of the last, the longest, and the average backward pass since the
+   * last reset, which can be used to validate the worst-case runtime of an iteration.
+   */
+  const benchmark::RepeatedTimer& getBackwardPassTimer() const { return backwardPassTimer_; }
+
+  /**
+   * Gets the number of nodes of the last iteration whose intermediate LQ approximation was reused from the previous iteration
+   * (see ddp::Settings::incrementalLqApproximation_).
+   */
+  size_t getNumReusedLqNodes() const { return numReusedLqNodes_; }
+
+  /** Gets the number of nodes whose intermediate LQ approximation was reused, summed over all the iterations since the last reset. */
+  size_t getTotalNumReusedLqNodes() const { return totalNumReusedLqNodes_; }
+
+  /** Gets the number of nodes whose intermediate LQ approximation was required, summed over all the iterations since the last reset. */
+  size_t getTotalNumLqNodes() const { return totalNumLqNodes_; }
+
+  /** Const access to the search strategy, e.g., to inspect its state between the runs. */
+  const SearchStrategyBase& getSearchStrategy() const { return *searchStrategyPtr_; }
+
   /**
    * Const access to ddp settings
    */
@@ -129,7 +150,8 @@ class GaussNewtonDDP : public SolverBase {
    * Takes the following steps: (1) Computes the Hessian of the Hamiltonian (i.e., Hm) (2) Based on Hm, it calculates
    * the range space and the null space projections of the input-state equality constraints. (3) Based on these two
    * projections, defines the projected LQ model. (4) Finally, defines the Riccati equation modifiers based on the
-   * search strategy.
+   * search strategy. The coefficients to recover the Lagrangian of the state-input equality constraints are stored in the
+   * Riccati modification, such that the unprojected model data is not needed after this call.
    *
    * @param [in] modelData: The model data.
    * @param [in] Sm: The Riccati matrix.
@@ -151,10 +173,23 @@ class GaussNewtonDDP : public SolverBase {
   /**
    * Calculates an LQ approximate of the optimal control problem for the nodes.
    *
-   * @param [in] dualSolution: The dual solution
-   * @param [in,out] primalData: The primal Data
+   * @param [in,out] dualData: The dual data. Its dual solution provides the multipliers, and the solver may store the quantities of
+   * the backward pass that only depend on the LQ approximation in it.
+   * @param [in,out] primalData: The primal Data. The unprojected LQ approximation is only stored in its modelDataTrajectory if it is
+   * read after this call, i.e. for reuse by the next iteration or by a backward pass that needs the value function to project it.
+   */
+  virtual void approximateIntermediateLQ(DualDataContainer& dualData, PrimalDataContainer& primalData) = 0;
+
+  /**
+   * Reuses the intermediate LQ approximation of the previous iteration for the given node if the node has changed less than
+   * ddp::Settings::lqReuseTolerance_. If requested, the reused approximation is corrected to first order for the deviation.
+   *
+   * @param [in] timeIndex: The time index of the node in primalData.
+   * @param [in] primalData: The primal data for which the LQ approximation is computed.
+   * @param [out] modelData: The reused LQ approximation. It is not modified if the approximation is not reusable.
+   * @return True if the LQ approximation is reused.
    */
-  virtual void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) = 0;
+  bool reuseIntermediateLQ(size_t timeIndex, const PrimalDataContainer& primalData, ModelData& modelData) const;
 
   /**
    * Calculate controller for the timeIndex by using primal and dual and write the result back to dstController
@@ -183,6 +218,15 @@ class GaussNewtonDDP : public SolverBase {
    */
   scalar_t solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction);
 
+  /**
+   * Solves the Riccati equations exactly in parallel over the whole horizon. The default implementation does not support it and
+   * returns false, in which case the Riccati equations are solved over partitions of the horizon.
+   *
+   * @param [in] finalValueFunction The final Sm(dfdxx), Sv(dfdx), s(f), for Riccati equation.
+   * @return True if the Riccati equations are solved.
+   */
+  virtual bool solveParallelRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) { return false; }
+
   /**
    * Solves a Riccati equations and type_1 constraints error correction compensation for the partition in the given index.
    *
@@ -291,6 +335,12 @@ class GaussNewtonDDP : public SolverBase {
    */
   void approximateOptimalControlProblem();
 
+  /**
+   * Matches the nodes of the nominal primal data to the nodes of the cached LQ approximation of the previous iteration, and
+   * determines the nodes for which reuseIntermediateLQ() can reuse the LQ approximation.
+   */
+  void updateReusableIntermediateLQ();
+
   /**
    *
    * @param [in] Hm: inv(Hm) defines the oblique projection for state-input equality constraints.
@@ -383,6 +433,14 @@ class GaussNewtonDDP : public SolverBase {
   DualDataContainer cachedDualData_;
   PrimalDataContainer cachedPrimalData_;
 
+  // incremental LQ approximation: the index of the node in cachedPrimalData_ whose LQ approximation is reused for each node of
+  // nominalPrimalData_ (-1 if it should be approximated). The cached LQ approximation is only valid within a run.
+  std::vector<int> reusableLqNodeIndices_;
+  bool cachedLqApproximationValid_ = false;
+  size_t numReusedLqNodes_ = 0;
+  size_t totalNumLqNodes_ = 0;
+  size_t totalNumReusedLqNodes_ = 0;
+
   struct ConstraintPenaltyCoefficients {
     scalar_t penaltyTol = 1e-3;
     scalar_t penaltyCoeff = 0.0;
@@ -59,6 +59,7 @@ class GaussNewtonDDP_MPC final : public MPC_BASE {
         ddpPtr_.reset(new SLQ(std::move(ddpSettings), rollout, optimalControlProblem, initializer));
         break;
       case ddp::Algorithm::ILQR:
+      case ddp::Algorithm::DDP:
         ddpPtr_.reset(new ILQR(std::move(ddpSettings), rollout, optimalControlProblem, initializer));
         break;
       default:
@@ -34,11 +34,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/DiscreteTimeRiccatiEquations.h"
+#include "riccati_equations/DiscreteTimeRiccatiScan.h"
 
 namespace ocs2 {
 
 /**
- * This class is an interface class for the single-thread and multi-thread ILQR.
+ * This class is an interface class for the single-thread and multi-thread ILQR. With ddp::Algorithm::DDP, the backward pass
+ * additionally includes the second-order derivatives of the dynamics contracted with the gradient of the value function.
  */
 class ILQR : public GaussNewtonDDP {
  public:
@@ -64,12 +66,19 @@ class ILQR : public GaussNewtonDDP {
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  /**
+   * Solves the Riccati equations with a parallel associative scan over the horizon. The scan assumes a Riccati modification which
+   * does not depend on the value function of the next node. This is verified afterwards, and the nodes before the last violating
+   * node are solved sequentially. Therefore, the result is the same as the one of the sequential solution.
+   */
+  bool solveParallelRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
+
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
-  void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
+  void approximateIntermediateLQ(DualDataContainer& dualData, PrimalDataContainer& primalData) override;
 
   /**
    * Calculates the discrete-time LQ approximation from the continuous-time LQ approximation.
@@ -85,14 +94,47 @@ class ILQR : public GaussNewtonDDP {
   void discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vector_t& state, const vector_t& input, scalar_t timeStep,
                         const ModelData& continuousTimeModelData, ModelData& modelData);
 
+  /**
+   * Adds the second-order terms of the dynamics in place to the cost Hessians of the discrete-time LQ approximation, i.e. the Hessian
+   * of \f$ S_v^T x_{k+1} \f$ where \f$ S_v \f$ is the gradient of the next value function. The discrete-time dynamics is approximated
+   * by the explicit Euler step for this term. The joint state-input Hessian is corrected by the EIGENVALUE_MODIFICATION strategy of
+   * the line search settings, which the constructor enforces.
+   *
+   * @param [in] workerIndex: The index of the worker which determines the optimal control problem instance.
+   * @param [in] timeIndex: The time index of the node.
+   * @param [in] SvNext: The gradient of the value function at the next node.
+   * @param [in, out] modelData: The discrete-time LQ approximation of the node.
+   */
+  void addDynamicsSecondOrderTerms(size_t workerIndex, size_t timeIndex, const vector_t& SvNext, ModelData& modelData);
+
+  /**
+   * Computes the projected feedback and feedforward gains at a node without a subsequent stage, i.e. the final node or a pre-event node.
+   *
+   * @param [in] workerIndex: The index of the worker which determines the scratch of the projected model data.
+   * @param [in] index: The time index of the node.
+   * @param [in] valueFunction: The value function at the node.
+   */
+  void computeFinalProjectedGains(size_t workerIndex, size_t index, const ScalarFunctionQuadraticApproximation& valueFunction);
+
+  /**
+   * Stores the part of the projected model data which is read after the backward pass, i.e. the projected state-input equality
+   * constraints used by the controller. The rest of the projected model data only lives in the scratch of the worker.
+   *
+   * @param [in] projectedModelData: The projected model data of the node.
+   * @param [out] storedModelData: The node of DualDataContainer::projectedModelDataTrajectory.
+   */
+  static void storeProjectedConstraint(const ModelData& projectedModelData, ModelData& storedModelData);
+
   /****************
    *** Variables **
    ****************/
   matrix_array_t projectedKmTrajectoryStock_;  // projected feedback
   vector_array_t projectedLvTrajectoryStock_;  // projected feedforward
 
-  DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  DynamicsSensitivityDiscretizerInPlace sensitivityDiscretizer_;
   std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> riccatiEquationsPtrStock_;
+  std::vector<riccati_scan::Element> riccatiScanElements_;
+  std::vector<ModelData> projectedModelDataStock_;  // projected LQ approximation, per worker
 };
 
 }  // namespace ocs2
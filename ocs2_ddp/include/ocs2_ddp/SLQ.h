@@ -61,7 +61,7 @@ class SLQ final : public GaussNewtonDDP {
  protected:
   matrix_t computeHamiltonianHessian(const ModelData& modelData, const matrix_t& Sm) const override;
 
-  void approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) override;
+  void approximateIntermediateLQ(DualDataContainer& dualData, PrimalDataContainer& primalData) override;
 
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
@@ -89,6 +89,19 @@ class SLQ final : public GaussNewtonDDP {
                                            scalar_array_t& SsNormalizedTime, size_array_t& SsNormalizedPostEventIndices,
                                            vector_array_t& allSsTrajectory);
 
+  /**
+   * Integrates the riccati equation with a fixed number of RK4 substeps per interval of the given time trajectory. It is used instead
+   * of the adaptive integrator when DDP_Settings::backwardPassNumSubsteps_ is positive.
+   *
+   * @param riccatiEquation [in] : Riccati equation object
+   * @param beginTimeItr [in] : Iterator to the first normalized time of the segment.
+   * @param endTimeItr [in] : Past-the-end iterator to the normalized times of the segment.
+   * @param allSs [in] : Value function at the first normalized time.
+   * @param allSsTrajectory [out] : The value function at the normalized times of the segment are appended to this array.
+   */
+  void integrateRiccatiEquationFixedStep(ContinuousTimeRiccatiEquations& riccatiEquation, scalar_array_t::const_iterator beginTimeItr,
+                                         scalar_array_t::const_iterator endTimeItr, vector_t allSs, vector_array_t& allSsTrajectory) const;
+
   /****************
    *** Variables **
    ****************/
@@ -97,6 +110,7 @@ class SLQ final : public GaussNewtonDDP {
   vector_array2_t allSsTrajectoryStock_;
   scalar_array2_t SsNormalizedTimeTrajectoryStock_;
   size_array2_t SsNormalizedEventsPastTheEndIndecesStock_;
+  std::vector<ModelData> modelDataStock_;  // per-worker scratch of the unprojected LQ approximation
 };
 
 }  // namespace ocs2
@@ -69,7 +69,6 @@ struct ContinuousTimeRiccatiData {
   vector_t projectedLv_;
 
   matrix_t SmTrans_projectedAm_;
-  matrix_t projectedKm_T_projectedGm_;
   matrix_t projectedRm_projectedKm_;
   vector_t projectedRm_projectedLv_;
 
@@ -196,15 +195,26 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   vector_t computeFlowMap(scalar_t z, const vector_t& allSs) override;
 
  private:
+  /**
+   * Transcribes the stacked vector allSs into the upper triangular part of Sm, a vector, Sv and a single scalar, s.
+   * The strictly lower triangular part of Sm is not written.
+   *
+   * @param [in] allSs: Single vector constructed by concatenating Sm, Sv and s.
+   * @param [out] Sm: \f$ S_m \f$ of which only the upper triangular part is set.
+   * @param [out] Sv: \f$ S_v \f$
+   * @param [out] s: \f$ s \f$
+   */
+  static void convert2UpperTriangular(const vector_t& allSs, matrix_t& Sm, vector_t& Sv, scalar_t& s);
+
   /**
    * Computes the Riccati equations for SLQ problem.
    *
    * @param [in] indexAlpha: The index and interpolation coefficient (alpha) pair.
-   * @param [in] Sm: The current Riccati matrix.
+   * @param [in] Sm: The current Riccati matrix. Only its upper triangular part is read.
    * @param [in] Sv: The current Riccati vector.
    * @param [in] s: The current Riccati scalar.
    * @param [out] creCache: The continuous-time Riccati equation cache date.
-   * @param [out] dSm: The time derivative of the Riccati matrix.
+   * @param [out] dSm: The time derivative of the Riccati matrix. Only its upper triangular part is computed.
    * @param [out] dSv: The time derivative of the  Riccati vector.
    * @param [out] ds: The time derivative of the  Riccati scalar.
    */
@@ -215,11 +225,11 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
    * Computes the Riccati equations for ILEG problem.
    *
    * @param [in] indexAlpha: The index and interpolation coefficient (alpha) pair.
-   * @param [in] Sm: The current Riccati matrix.
+   * @param [in] Sm: The current Riccati matrix. Only its upper triangular part is read.
    * @param [in] Sv: The current Riccati vector.
    * @param [in] s: The current Riccati scalar.
    * @param [out] creCache: The continuous-time Riccati equation cache date.
-   * @param [out] dSm: The time derivative of the Riccati matrix.
+   * @param [out] dSm: The time derivative of the Riccati matrix. Only its upper triangular part is computed.
    * @param [out] dSv: The time derivative of the  Riccati vector.
    * @param [out] ds: The time derivative of the  Riccati scalar.
    */
@@ -0,0 +1,95 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+namespace ocs2 {
+namespace riccati_scan {
+
+/**
+ * An element of the associative scan over the discrete-time Riccati recursion. An element represents the conditional value
+ * function of an interval, i.e. the optimal cost of reaching the state y at the end of the interval from the state x at its start:
+ *
+ *    V(x, y) = 1/2 x' J x - eta' x + max_lambda { lambda' (y - A x - b) - 1/2 lambda' C lambda }
+ *
+ * where the constant terms are dropped. The element of the final node has A = 0, b = 0, and C = 0. Therefore, the product of the
+ * elements from a node to the final node is the value function at that node, V(x) = 1/2 x' J x - eta' x.
+ *
+ * Since the product of the elements is associative, the value functions at all nodes can be computed with a parallel prefix scan.
+ * Reference: S. Sarkka and A. F. Garcia-Fernandez, "Temporal Parallelization of Dynamic Programming and Linear Quadratic Control",
+ * IEEE Transactions on Automatic Control, 2023.
+ */
+struct Element {
+  matrix_t A;
+  vector_t b;
+  matrix_t C;
+  vector_t eta;
+  matrix_t J;
+};
+
+/**
+ * Sets the element of a projected LQ stage. The Riccati modification is limited to deltaQm, i.e. deltaGm and deltaGv are zero.
+ *
+ * @param [in] projectedModelData: The projected model data.
+ * @param [in] deltaQm: The Riccati modification of the state Hessian.
+ * @param [out] element: The element of the stage.
+ */
+void setStageElement(const ModelData& projectedModelData, const matrix_t& deltaQm, Element& element);
+
+/**
+ * Sets the element of the jump map at an event.
+ *
+ * @param [in] jumpModelData: The model data at the event time.
+ * @param [out] element: The element of the event.
+ */
+void setJumpElement(const ModelData& jumpModelData, Element& element);
+
+/**
+ * Sets the element of the final node.
+ *
+ * @param [in] finalValueFunction: The final value function.
+ * @param [out] element: The element of the final node.
+ */
+void setFinalElement(const ScalarFunctionQuadraticApproximation& finalValueFunction, Element& element);
+
+/**
+ * Combines the element of an interval [i, j] with the element of the subsequent interval [j, k] into the element of [i, k].
+ *
+ * @param [in] first: The element of the interval [i, j].
+ * @param [in] second: The element of the interval [j, k].
+ * @param [out] result: The element of the interval [i, k]. It should not alias the inputs.
+ */
+void combine(const Element& first, const Element& second, Element& result);
+
+}  // namespace riccati_scan
+}  // namespace ocs2
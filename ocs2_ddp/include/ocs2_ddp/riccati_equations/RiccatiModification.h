@@ -50,6 +50,14 @@ struct Data {
   matrix_t constraintRangeProjector_;
   /** \f$DmNull inv(DmNull^T * Hm * DmNull) * DmNull^T = (I - invHm * Dm^T * inv(Dm * invHm * Dm^T) * Dm) * invHm\f$ */
   matrix_t constraintNullProjector_;
+
+  /**
+   * The Lagrange multiplier of the state-input equality constraints is recovered as
+   * \f$nu = constraintLagrangianBias + constraintLagrangianStateGain * dx + constraintLagrangianCostateGain * costate\f$.
+   */
+  vector_t constraintLagrangianBias_;
+  matrix_t constraintLagrangianStateGain_;
+  matrix_t constraintLagrangianCostateGain_;
 };
 
 /**
@@ -52,6 +52,10 @@ CREATE_INTERPOLATION_ACCESS_FUNCTION(hamiltonianHessian)
 CREATE_INTERPOLATION_ACCESS_FUNCTION(constraintRangeProjector)
 CREATE_INTERPOLATION_ACCESS_FUNCTION(constraintNullProjector)
 
+CREATE_INTERPOLATION_ACCESS_FUNCTION(constraintLagrangianBias)
+CREATE_INTERPOLATION_ACCESS_FUNCTION(constraintLagrangianStateGain)
+CREATE_INTERPOLATION_ACCESS_FUNCTION(constraintLagrangianCostateGain)
+
 }  // namespace riccati_modification
 }  // namespace ocs2
 
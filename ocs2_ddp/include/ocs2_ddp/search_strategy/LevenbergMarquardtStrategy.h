@@ -82,6 +82,9 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
 
   matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const override;
 
+  /** Gets the current Riccati multiple. After reset(), it is the initial multiple of the next run. */
+  scalar_t getRiccatiMultiple() const { return lmModule_.riccatiMultiple; }
+
  private:
   /** computes the ratio between actual reduction and predicted reduction */
   scalar_t reductionToPredictedReduction(const scalar_t actualReduction, const scalar_t expectedReduction) const {
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -70,7 +72,12 @@ class LineSearchStrategy final : public SearchStrategyBase {
   LineSearchStrategy(const LineSearchStrategy&) = delete;
   LineSearchStrategy& operator=(const LineSearchStrategy&) = delete;
 
-  void reset() override {}
+  void reset() override {
+    previousInitTime_ = 0.0;
+    previousTimeTrajectory_.clear();
+    previousStateTrajectory_.clear();
+    numSegmentedRollouts_ = 0;
+  }
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
            const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
@@ -84,6 +91,9 @@ class LineSearchStrategy final : public SearchStrategyBase {
 
   matrix_t augmentHamiltonianHessian(const ModelData& /*modelData*/, const matrix_t& Hm) const override { return Hm; }
 
+  /** Number of rollouts since the last reset which were integrated as more than one segment (see line_search::Settings). */
+  size_t getNumSegmentedRollouts() const { return numSegmentedRollouts_; }
+
  private:
   struct LineSearchInputRef {
     const std::pair<scalar_t, scalar_t>* timePeriodPtr;
@@ -96,8 +106,49 @@ class LineSearchStrategy final : public SearchStrategyBase {
   /** number of line search iterations (the if statements order is important) */
   size_t maxNumOfSearches() const;
 
-  /** Computes the solution on a thread and a given stepLength  */
-  void computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution);
+  /** A segment of the segmented rollout */
+  struct RolloutSegment {
+    scalar_t initTime;
+    scalar_t finalTime;
+    vector_t initState;
+    ModeSchedule modeSchedule;
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    std::exception_ptr errorPtr;
+  };
+
+  /** The segments of a rollout of a task. Its segments are integrated by the rollout instances of the task's group. */
+  struct SegmentedRollout {
+    std::vector<RolloutSegment> segments;
+    std::vector<size_t> defectSegmentIndices;
+    std::atomic_size_t nextSegmentId{0};
+  };
+
+  /**
+   * Computes the solution on a thread and a given stepLength. If segmentedRollout is true, the rollout is distributed over the
+   * rollout instances of the task's group.
+   */
+  void computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution, bool segmentedRollout = false);
+
+  /**
+   * Rolls out the controller of the primal solution by integrating segments of the time horizon concurrently with the rollout instances
+   * of the task's group, i.e. [taskId * rolloutGroupSize_, (taskId + 1) * rolloutGroupSize_). The segments start from the states of a
+   * guess trajectory. The segments whose initial state deviates from the final state of their preceding segment more
+   * than rolloutDefectTolerance are integrated again, concurrently, from that final state until all defects are within the tolerance.
+   * Since the first segment is exact, each pass makes at least one more segment exact. Falls back to a single rollout if the guess is not
+   * a rollout from the same initial time and state.
+   *
+   * @param [in] taskId: The task which determines the group of rollout instances.
+   * @return average time step
+   */
+  scalar_t segmentedRolloutTrajectory(size_t taskId, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                      scalar_t guessInitTime, const scalar_array_t& guessTime, const vector_array_t& guessState,
+                                      PrimalSolution& primalSolution);
+
+  /** Integrates a segment of the segmented rollout with the given rollout instance. */
+  void rolloutSegment(size_t rolloutIndex, ControllerBase* controllerPtr, const ModeSchedule& modeSchedule, RolloutSegment& segment);
 
   /**
    * Defines line search task on a thread with various learning rates and choose the largest acceptable step-size.
@@ -112,6 +163,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
   ThreadPool& threadPoolRef_;
   std::vector<DualSolution> tempDualSolutions_;
   std::vector<search_strategy::Solution> workersSolution_;
+  std::vector<std::atomic<scalar_t>> activeStepLengths_;  // the step length that each task evaluates
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
@@ -122,9 +174,21 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::atomic<scalar_t> bestStepSize_{0.0};
   search_strategy::SolutionRef* bestSolutionRef_;
 
+  // segmented rollout: the previous solution's states are used as the initial states of the segments of the zero step length, and the
+  // zero step length rollout's states as the initial states of the segments of the other step lengths
+  scalar_t previousInitTime_ = 0.0;
+  scalar_array_t previousTimeTrajectory_;
+  vector_array_t previousStateTrajectory_;
+  scalar_array_t baselineTimeTrajectory_;
+  vector_array_t baselineStateTrajectory_;
+  size_t rolloutGroupSize_ = 1;  // the number of rollout instances of each task
+  std::vector<SegmentedRollout> segmentedRollouts_;
+  std::atomic_size_t numSegmentedRollouts_{0};
+
   // convergence check
   scalar_t baselineMerit_ = 0.0;                  // the merit of the rollout for zero learning rate
   scalar_t unoptimizedControllerUpdateIS_ = 0.0;  // integral of the squared (IS) norm of the controller update.
+  std::chrono::steady_clock::duration baselineDuration_{0};  // the duration of the rollout for zero learning rate
 
   // threading
   std::atomic_size_t nextTaskId_{0};
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -73,6 +74,12 @@ class SearchStrategyBase {
    */
   virtual void reset() = 0;
 
+  /**
+   * Sets the wall-clock deadline of the next searches. A strategy which evaluates several step lengths stops evaluating new ones when
+   * they are not expected to finish before the deadline. The best solution found so far is kept.
+   */
+  void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
   /**
    * Finds the optimal trajectories, controller, and performance index based on the given controller and its increment.
    *
@@ -125,6 +132,7 @@ class SearchStrategyBase {
 
  protected:
   const search_strategy::Settings baseSettings_;
+  std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
 };
 
 }  // namespace ocs2
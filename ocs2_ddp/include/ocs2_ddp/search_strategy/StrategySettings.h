@@ -97,6 +97,15 @@ struct Settings {
   hessian_correction::Strategy hessianCorrectionStrategy = hessian_correction::Strategy::DIAGONAL_SHIFT;
   /** The multiple used for correcting the Hessian for numerical stability of the Riccati backward pass.*/
   scalar_t hessianCorrectionMultiple = numeric_traits::limitEpsilon<scalar_t>();
+  /**
+   * If larger than one, each rollout of the line search is split into this number of segments which are integrated concurrently. The
+   * threads are split into groups of this size, and the step lengths are evaluated concurrently by the groups. The segments of the
+   * zero step length start from the states of the previous solution, and the segments of the other step lengths start from the states
+   * of the zero step length rollout. It is bounded by the number of threads.
+   */
+  size_t numRolloutSegments = 1;
+  /** A segment is integrated again from the final state of its preceding segment if the defect between them exceeds this value. */
+  scalar_t rolloutDefectTolerance = 1e-6;
 };  // end of Settings
 
 /**
@@ -129,6 +138,8 @@ struct Settings {
   scalar_t riccatiMultipleDefaultFactor = 1e-6;
   /** Maximum number of successive rejections of the iteration's solution. */
   size_t maxNumSuccessiveRejections = 5;
+  /** Whether reset() keeps the converged Riccati multiple as the initial multiple of the next run, e.g., the next MPC cycle. */
+  bool warmStartRiccatiMultiple = false;
 };  // end of Settings
 
 /**
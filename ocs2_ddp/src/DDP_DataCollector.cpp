@@ -82,6 +82,7 @@ void DDP_DataCollector::collect(const GaussNewtonDDP* constDdpPtr) {
   nominalTimeTrajectoriesStock_ = ddpPtr->cachedTimeTrajectoriesStock_;
   nominalStateTrajectoriesStock_ = ddpPtr->cachedStateTrajectoriesStock_;
   nominalInputTrajectoriesStock_ = ddpPtr->cachedInputTrajectoriesStock_;
+  numReusedLqNodes_ = ddpPtr->getNumReusedLqNodes();
 
   /*
    * Data which can be swapped. Note that these variables should have correct size.
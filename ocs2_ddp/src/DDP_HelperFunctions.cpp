@@ -248,6 +248,36 @@ void projectLQ(const ModelData& modelData, const matrix_t& constraintRangeProjec
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void correctIntermediateLQ(const vector_t& deltaState, const vector_t& deltaInput, ModelData& modelData) {
+  auto& cost = modelData.cost;
+  const vector_t costHessianTimesDeltaState = cost.dfdxx * deltaState + cost.dfdux.transpose() * deltaInput;
+  const vector_t costHessianTimesDeltaInput = cost.dfdux * deltaState + cost.dfduu * deltaInput;
+  cost.f += cost.dfdx.dot(deltaState) + cost.dfdu.dot(deltaInput) +
+            0.5 * (deltaState.dot(costHessianTimesDeltaState) + deltaInput.dot(costHessianTimesDeltaInput));
+  cost.dfdx += costHessianTimesDeltaState;
+  cost.dfdu += costHessianTimesDeltaInput;
+
+  auto& dynamics = modelData.dynamics;
+  if (dynamics.f.size() > 0) {
+    dynamics.f.noalias() += dynamics.dfdx * deltaState;
+    dynamics.f.noalias() += dynamics.dfdu * deltaInput;
+  }
+
+  auto correctConstraint = [&](VectorFunctionLinearApproximation& constraint) {
+    if (constraint.f.size() > 0) {
+      constraint.f.noalias() += constraint.dfdx * deltaState;
+      if (constraint.dfdu.size() > 0) {
+        constraint.f.noalias() += constraint.dfdu * deltaInput;
+      }
+    }
+  };
+  correctConstraint(modelData.stateEqConstraint);
+  correctConstraint(modelData.stateInputEqConstraint);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -342,10 +372,11 @@ scalar_t computeControllerUpdateIS(const LinearController& controller) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void incrementController(scalar_t stepLength, const LinearController& unoptimizedController, LinearController& controller) {
-  controller.clear();
+  // assign rather than clear to reuse the memory of the controller
   controller.timeStamp_ = unoptimizedController.timeStamp_;
   controller.gainArray_ = unoptimizedController.gainArray_;
   controller.biasArray_.resize(unoptimizedController.size());
+  controller.deltaBiasArray_.clear();
   for (size_t k = 0; k < unoptimizedController.size(); k++) {
     controller.biasArray_[k] = unoptimizedController.biasArray_[k] + stepLength * unoptimizedController.deltaBiasArray_[k];
   }
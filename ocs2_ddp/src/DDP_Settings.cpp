@@ -42,12 +42,14 @@ namespace ocs2 {
 namespace ddp {
 
 std::string toAlgorithmName(Algorithm type) {
-  static const std::unordered_map<Algorithm, std::string> strategyMap{{Algorithm::SLQ, "SLQ"}, {Algorithm::ILQR, "ILQR"}};
+  static const std::unordered_map<Algorithm, std::string> strategyMap{
+      {Algorithm::SLQ, "SLQ"}, {Algorithm::ILQR, "ILQR"}, {Algorithm::DDP, "DDP"}};
   return strategyMap.at(type);
 }
 
 Algorithm fromAlgorithmName(std::string name) {
-  static const std::unordered_map<std::string, Algorithm> strategyMap{{"SLQ", Algorithm::SLQ}, {"ILQR", Algorithm::ILQR}};
+  static const std::unordered_map<std::string, Algorithm> strategyMap{
+      {"SLQ", Algorithm::SLQ}, {"ILQR", Algorithm::ILQR}, {"DDP", Algorithm::DDP}};
   std::transform(name.begin(), name.end(), name.begin(), ::toupper);
   return strategyMap.at(name);
 }
@@ -86,11 +88,17 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = integrator_type::toString(settings.backwardPassIntegratorType_);  // keep default
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".backwardPassIntegratorType", verbose);
   settings.backwardPassIntegratorType_ = integrator_type::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.backwardPassNumSubsteps_, fieldName + ".backwardPassNumSubsteps", verbose);
 
   loadData::loadPtreeValue(pt, settings.constraintPenaltyInitialValue_, fieldName + ".constraintPenaltyInitialValue", verbose);
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
 
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
+  loadData::loadPtreeValue(pt, settings.parallelRiccatiScan_, fieldName + ".parallelRiccatiScan", verbose);
+
+  loadData::loadPtreeValue(pt, settings.incrementalLqApproximation_, fieldName + ".incrementalLqApproximation", verbose);
+  loadData::loadPtreeValue(pt, settings.lqReuseTolerance_, fieldName + ".lqReuseTolerance", verbose);
+  loadData::loadPtreeValue(pt, settings.lqReuseFirstOrderCorrection_, fieldName + ".lqReuseFirstOrderCorrection", verbose);
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
@@ -162,6 +162,10 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
                << searchStrategyTotal / benchmarkTotal * 100 << "%)\n";
     infoStream << "\tDual Solution      :\t" << totalDualSolutionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << dualSolutionTotal / benchmarkTotal * 100 << "%)\n\n";
+    if (ddpSettings_.incrementalLqApproximation_ && totalNumLqNodes_ > 0) {
+      infoStream << "Incremental LQ approximation: reused the LQ approximation of " << totalNumReusedLqNodes_ << " out of "
+                 << totalNumLqNodes_ << " nodes (" << 100.0 * totalNumReusedLqNodes_ / totalNumLqNodes_ << "%)\n\n";
+    }
   }
   return infoStream.str();
 }
@@ -178,6 +182,8 @@ void GaussNewtonDDP::reset() {
   nominalPrimalData_.clear();
   cachedDualData_.clear();
   cachedPrimalData_.clear();
+  reusableLqNodeIndices_.clear();
+  cachedLqApproximationValid_ = false;
 
   // optimized data
   optimizedDualSolution_.clear();
@@ -188,6 +194,9 @@ void GaussNewtonDDP::reset() {
   avgTimeStepFP_ = 0.0;
   avgTimeStepBP_ = 0.0;
   totalNumIterations_ = 0;
+  numReusedLqNodes_ = 0;
+  totalNumLqNodes_ = 0;
+  totalNumReusedLqNodes_ = 0;
   performanceIndexHistory_.clear();
 
   // benchmarking timers
@@ -344,31 +353,19 @@ vector_t GaussNewtonDDP::getStateInputEqualityConstraintLagrangianImpl(scalar_t
   const auto indexAlpha = LinearInterpolation::timeSegment(time, primalData.primalSolution.timeTrajectory_);
   const vector_t xNominal = LinearInterpolation::interpolate(indexAlpha, primalData.primalSolution.stateTrajectory_);
 
-  const matrix_t Bm = LinearInterpolation::interpolate(indexAlpha, primalData.modelDataTrajectory, model_data::dynamics_dfdu);
-  const matrix_t Pm = LinearInterpolation::interpolate(indexAlpha, primalData.modelDataTrajectory, model_data::cost_dfdux);
-  const vector_t Rv = LinearInterpolation::interpolate(indexAlpha, primalData.modelDataTrajectory, model_data::cost_dfdu);
-
-  const vector_t EvProjected =
-      LinearInterpolation::interpolate(indexAlpha, dualData.projectedModelDataTrajectory, model_data::stateInputEqConstraint_f);
-  const matrix_t CmProjected =
-      LinearInterpolation::interpolate(indexAlpha, dualData.projectedModelDataTrajectory, model_data::stateInputEqConstraint_dfdx);
-  const matrix_t Hm =
-      LinearInterpolation::interpolate(indexAlpha, dualData.riccatiModificationTrajectory, riccati_modification::hamiltonianHessian);
-  const matrix_t DmDagger =
-      LinearInterpolation::interpolate(indexAlpha, dualData.riccatiModificationTrajectory, riccati_modification::constraintRangeProjector);
+  const auto& riccatiModificationTrajectory = dualData.riccatiModificationTrajectory;
+  vector_t nu = LinearInterpolation::interpolate(indexAlpha, riccatiModificationTrajectory, riccati_modification::constraintLagrangianBias);
+  const matrix_t stateGain =
+      LinearInterpolation::interpolate(indexAlpha, riccatiModificationTrajectory, riccati_modification::constraintLagrangianStateGain);
+  const matrix_t costateGain =
+      LinearInterpolation::interpolate(indexAlpha, riccatiModificationTrajectory, riccati_modification::constraintLagrangianCostateGain);
 
   const vector_t deltaX = state - xNominal;
   const vector_t costate = getValueFunction(time, state).dfdx;
 
-  vector_t err = EvProjected;
-  err.noalias() += CmProjected * deltaX;
-
-  vector_t temp = -Rv;
-  temp.noalias() -= Pm * deltaX;
-  temp.noalias() -= Bm.transpose() * costate;
-  temp.noalias() += Hm * err;
-
-  return DmDagger.transpose() * temp;
+  nu.noalias() += stateGain * deltaX;
+  nu.noalias() += costateGain * costate;
+  return nu;
 }
 
 /******************************************************************************************************/
@@ -516,8 +513,7 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-  nominalDualData_.valueFunctionTrajectory.clear();
-  nominalDualData_.valueFunctionTrajectory.resize(outputN);
+  nominalDualData_.resizeValueFunction(outputN);
 
   // the last index of the partition is excluded, namely [first, last), so the value function approximation of the end point of the end
   // partition is filled manually.
@@ -525,8 +521,9 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   // [first1,last1), [first2(last1), last2).
   nominalDualData_.valueFunctionTrajectory.back() = finalValueFunction;
 
-  // solve it sequentially for the first iteration
-  if (totalNumIterations_ == 0) {
+  if (solveParallelRiccatiEquations(finalValueFunction)) {
+    // solved exactly in parallel by the derived class
+  } else if (totalNumIterations_ == 0) {  // solve it sequentially for the first iteration
     const std::pair<int, int> partitionInterval{0, outputN - 1};
     riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
   } else {  // solve it in parallel
@@ -588,7 +585,7 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 void GaussNewtonDDP::calculateController() {
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  unoptimizedController_.clear();
+  // the arrays are resized rather than cleared to reuse the memory of the gains and biases of the previous iteration
   unoptimizedController_.timeStamp_ = nominalPrimalData_.primalSolution.timeTrajectory_;
   unoptimizedController_.gainArray_.resize(N);
   unoptimizedController_.biasArray_.resize(N);
@@ -649,15 +646,15 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
    * compute and augment the LQ approximation of intermediate times
    */
   // perform the LQ approximation for intermediate times
-  approximateIntermediateLQ(nominalDualData_.dualSolution, nominalPrimalData_);
+  updateReusableIntermediateLQ();
+  approximateIntermediateLQ(nominalDualData_, nominalPrimalData_);
 
   /*
    * compute and augment the LQ approximation of the event times.
    * also call shiftHessian on the event time's cost 2nd order derivative.
    */
   const size_t NE = nominalPrimalData_.primalSolution.postEventIndices_.size();
-  nominalPrimalData_.modelDataEventTimes.clear();
-  nominalPrimalData_.modelDataEventTimes.resize(NE);
+  nominalPrimalData_.resizeModelDataEventTimes(NE);
   if (NE > 0) {
     nextTimeIndex_ = 0;
     nextTaskId_ = 0;
@@ -728,6 +725,93 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateReusableIntermediateLQ() {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = nominalPrimalData_.primalSolution.stateTrajectory_;
+  const auto& inputTrajectory = nominalPrimalData_.primalSolution.inputTrajectory_;
+  const auto& multiplierTrajectory = nominalDualData_.dualSolution.intermediates;
+  const auto& cachedTimeTrajectory = cachedPrimalData_.primalSolution.timeTrajectory_;
+  const auto& cachedStateTrajectory = cachedPrimalData_.primalSolution.stateTrajectory_;
+  const auto& cachedInputTrajectory = cachedPrimalData_.primalSolution.inputTrajectory_;
+  const auto& cachedMultiplierTrajectory = cachedDualData_.dualSolution.intermediates;
+
+  const size_t N = timeTrajectory.size();
+  const size_t cachedN = cachedTimeTrajectory.size();
+  reusableLqNodeIndices_.assign(N, -1);
+  numReusedLqNodes_ = 0;
+
+  const bool isCacheConsistent = cachedPrimalData_.modelDataTrajectory.size() == cachedN && cachedMultiplierTrajectory.size() == cachedN;
+  if (!ddpSettings_.incrementalLqApproximation_ || !cachedLqApproximationValid_ || !isCacheConsistent || multiplierTrajectory.size() != N) {
+    return;
+  }
+
+  const scalar_t tolerance = ddpSettings_.lqReuseTolerance_;
+  auto isClose = [tolerance](const vector_t& lhs, const vector_t& rhs) {
+    return lhs.size() == rhs.size() && (lhs.size() == 0 || (lhs - rhs).lpNorm<Eigen::Infinity>() <= tolerance);
+  };
+  auto areMultipliersClose = [&](const MultiplierCollection& lhs, const MultiplierCollection& rhs) {
+    return isClose(toVector(lhs.stateEq), toVector(rhs.stateEq)) && isClose(toVector(lhs.stateIneq), toVector(rhs.stateIneq)) &&
+           isClose(toVector(lhs.stateInputEq), toVector(rhs.stateInputEq)) &&
+           isClose(toVector(lhs.stateInputIneq), toVector(rhs.stateInputIneq));
+  };
+
+  // Both time trajectories are sorted, the pre- and post-event nodes share the same time stamp.
+  size_t j = 0;
+  for (size_t i = 0; i < N; i++) {
+    while (j < cachedN && cachedTimeTrajectory[j] < timeTrajectory[i] && !numerics::almost_eq(cachedTimeTrajectory[j], timeTrajectory[i])) {
+      j++;
+    }
+    if (j == cachedN) {
+      break;
+    } else if (!numerics::almost_eq(cachedTimeTrajectory[j], timeTrajectory[i])) {
+      continue;
+    }
+
+    // ILQR discretizes the LQ approximation over the interval to the next node, therefore it should not change either.
+    const bool isFinalNode = (i + 1 == N);
+    const bool isCachedFinalNode = (j + 1 == cachedN);
+    const bool isSameInterval =
+        (isFinalNode && isCachedFinalNode) ||
+        (!isFinalNode && !isCachedFinalNode && numerics::almost_eq(timeTrajectory[i + 1], cachedTimeTrajectory[j + 1]));
+
+    if (isSameInterval && isClose(stateTrajectory[i], cachedStateTrajectory[j]) && isClose(inputTrajectory[i], cachedInputTrajectory[j]) &&
+        areMultipliersClose(multiplierTrajectory[i], cachedMultiplierTrajectory[j])) {
+      reusableLqNodeIndices_[i] = static_cast<int>(j);
+      ++numReusedLqNodes_;
+    }
+    j++;
+  }  // end of i loop
+
+  totalNumLqNodes_ += N;
+  totalNumReusedLqNodes_ += numReusedLqNodes_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaussNewtonDDP::reuseIntermediateLQ(size_t timeIndex, const PrimalDataContainer& primalData, ModelData& modelData) const {
+  if (timeIndex >= reusableLqNodeIndices_.size() || reusableLqNodeIndices_[timeIndex] < 0) {
+    return false;
+  }
+
+  const size_t cachedIndex = reusableLqNodeIndices_[timeIndex];
+  modelData = cachedPrimalData_.modelDataTrajectory[cachedIndex];
+  modelData.time = primalData.primalSolution.timeTrajectory_[timeIndex];
+
+  if (ddpSettings_.lqReuseFirstOrderCorrection_) {
+    const vector_t deltaState =
+        primalData.primalSolution.stateTrajectory_[timeIndex] - cachedPrimalData_.primalSolution.stateTrajectory_[cachedIndex];
+    const vector_t deltaInput =
+        primalData.primalSolution.inputTrajectory_[timeIndex] - cachedPrimalData_.primalSolution.inputTrajectory_[cachedIndex];
+    correctIntermediateLQ(deltaState, deltaInput, modelData);
+  }
+
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -747,6 +831,24 @@ void GaussNewtonDDP::computeProjectionAndRiccatiModification(const ModelData& mo
   // compute deltaQm, deltaGv, deltaGm
   searchStrategyPtr_->computeRiccatiModification(projectedModelData, riccatiModification.deltaQm_, riccatiModification.deltaGv_,
                                                  riccatiModification.deltaGm_);
+
+  // coefficients of the state-input equality constraints Lagrangian:
+  // nu = DmDagger^T * (Hm * (EvProjected + CmProjected * dx) - Rv - Pm * dx - Bm^T * costate)
+  const auto& DmDagger = riccatiModification.constraintRangeProjector_;
+  if (DmDagger.cols() > 0) {
+    const auto& Hm = riccatiModification.hamiltonianHessian_;
+    vector_t biasTemp = -modelData.cost.dfdu;
+    biasTemp.noalias() += Hm * projectedModelData.stateInputEqConstraint.f;
+    riccatiModification.constraintLagrangianBias_.noalias() = DmDagger.transpose() * biasTemp;
+    matrix_t gainTemp = -modelData.cost.dfdux;
+    gainTemp.noalias() += Hm * projectedModelData.stateInputEqConstraint.dfdx;
+    riccatiModification.constraintLagrangianStateGain_.noalias() = DmDagger.transpose() * gainTemp;
+    riccatiModification.constraintLagrangianCostateGain_.noalias() = -DmDagger.transpose() * modelData.dynamics.dfdu.transpose();
+  } else {
+    riccatiModification.constraintLagrangianBias_.resize(0);
+    riccatiModification.constraintLagrangianStateGain_.resize(0, modelData.stateDim);
+    riccatiModification.constraintLagrangianCostateGain_.resize(0, modelData.stateDim);
+  }
 }
 
 /******************************************************************************************************/
@@ -997,7 +1099,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   finalTime_ = finalTime;
   performanceIndexHistory_.clear();
   const auto initIteration = totalNumIterations_;
+  cachedLqApproximationValid_ = false;  // the references might have changed since the last run
   initializeConstraintPenalties();  // initialize penalty coefficients
+  searchStrategyPtr_->setDeadline(getDeadline());
 
   // display
   if (ddpSettings_.displayInfo_) {
@@ -1069,7 +1173,13 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
         !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
     initialSolutionExists = true;
 
-    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
+    // the expected duration of the next iteration based on the timings of the previous ones
+    const auto expectedIterationTime =
+        linearQuadraticApproximationTimer_.getAverageInMilliseconds() + backwardPassTimer_.getAverageInMilliseconds() +
+        computeControllerTimer_.getAverageInMilliseconds() + searchStrategyTimer_.getAverageInMilliseconds();
+
+    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_ ||
+        !fitsBeforeDeadline(expectedIterationTime)) {
       break;
 
     } else {
@@ -1079,6 +1189,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       // optimized --> nominal: use the optimized solution as the nominal for the next iteration
       nominalDualData_.swap(cachedDualData_);
       nominalPrimalData_.swap(cachedPrimalData_);
+      cachedLqApproximationValid_ = true;
       optimizedDualSolution_.swap(nominalDualData_.dualSolution);
       optimizedPrimalSolution_.swap(nominalPrimalData_.primalSolution);
       optimizedProblemMetrics_.swap(nominalPrimalData_.problemMetrics);
@@ -1100,6 +1211,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
+    } else if (isTerminatedByDeadline()) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The next iteration is not expected to finish before the deadline." << std::endl;
     } else {
       std::cerr << "The algorithm has terminated for an unknown reason!" << std::endl;
     }
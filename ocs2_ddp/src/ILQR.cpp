@@ -28,6 +28,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_ddp/HessianCorrection.h>
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -38,7 +44,7 @@ namespace ocs2 {
 ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
            const Initializer& initializer)
     : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer) {
-  if (settings().algorithm_ != ddp::Algorithm::ILQR) {
+  if (settings().algorithm_ != ddp::Algorithm::ILQR && settings().algorithm_ != ddp::Algorithm::DDP) {
     throw std::runtime_error("[ILQR] In DDP setting the algorithm name is set \"" + ddp::toAlgorithmName(settings().algorithm_) +
                              "\" while ILQR is instantiated!");
   }
@@ -47,13 +53,13 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   sensitivityDiscretizer_ = [&]() {
     switch (settings().backwardPassIntegratorType_) {
       case IntegratorType::EULER:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::EULER);
+        return selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType::EULER);
       case IntegratorType::RK4:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+        return selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType::RK4);
       case IntegratorType::ODE45:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+        return selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType::RK4);
       case IntegratorType::ODE45_OCS2:
-        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+        return selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType::RK4);
       default:
         throw std::runtime_error("[ILQR] Integrator of type " + integrator_type::toString(settings().backwardPassIntegratorType_) +
                                  " is not supported for sensitivity discretization! Modify ddp::Settings::backwardPassIntegratorType_.");
@@ -70,23 +76,38 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
   }  // end of i loop
 
+  // The stage Hessians with the second-order terms of the dynamics are indefinite in general, and they are modified in place
+  if (settings().algorithm_ == ddp::Algorithm::DDP) {
+    if (settings().lineSearch_.hessianCorrectionStrategy != hessian_correction::Strategy::EIGENVALUE_MODIFICATION) {
+      throw std::runtime_error("[ILQR] The algorithm \"DDP\" requires the Hessian correction strategy \"" +
+                               hessian_correction::toString(hessian_correction::Strategy::EIGENVALUE_MODIFICATION) + "\" while \"" +
+                               hessian_correction::toString(settings().lineSearch_.hessianCorrectionStrategy) +
+                               "\" is set! Modify line_search::Settings::hessianCorrectionStrategy.");
+    }
+    if (settings().incrementalLqApproximation_) {
+      throw std::runtime_error(
+          "[ILQR] The algorithm \"DDP\" cannot reuse the LQ approximation of the previous iteration since it modifies it in place! "
+          "Disable ddp::Settings::incrementalLqApproximation_.");
+    }
+  }
+  projectedModelDataStock_.resize(settings().nThreads_);
+
   Eigen::initParallel();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
+void ILQR::approximateIntermediateLQ(DualDataContainer& dualData, PrimalDataContainer& primalData) {
   // create alias
   const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
   const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
   const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
   const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
-  const auto& multiplierTrajectory = dualSolution.intermediates;
+  const auto& multiplierTrajectory = dualData.dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
+  primalData.resizeModelDataTrajectory(timeTrajectory.size());
 
   nextTimeIndex_ = 0;
   nextTaskId_ = 0;
@@ -98,6 +119,13 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
     // get next time index is atomic
     size_t timeIndex;
     while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
+      // reuse the discrete LQ approximation of the previous iteration if the node has not changed. The discrete-time flow map is
+      // expressed in the deviation from the nominal trajectory, hence it stays zero.
+      if (reuseIntermediateLQ(timeIndex, primalData, modelDataTrajectory[timeIndex])) {
+        modelDataTrajectory[timeIndex].dynamics.f.setZero(modelDataTrajectory[timeIndex].stateDim);
+        continue;
+      }
+
       // approximate continuous LQ for the given time index
       ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
                                       inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
@@ -142,7 +170,7 @@ void ILQR::discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vec
 
   // linearize system dynamics
   modelData.dynamicsBias.setZero(modelData.stateDim);
-  modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
+  sensitivityDiscretizer_(system, time, state, input, timeStep, modelData.dynamics);
   modelData.dynamics.f.setZero(modelData.stateDim);
 
   // quadratic approximation to the cost function
@@ -188,27 +216,46 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
   projectedLvTrajectoryStock_.resize(N);
   projectedKmTrajectoryStock_.resize(N);
 
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
+  nominalDualData_.resizeProjectedModelData(N);
+
+  computeFinalProjectedGains(0, N - 1, finalValueFunction);
+
+  return solveSequentialRiccatiEquationsImpl(finalValueFunction);
+}
 
-  const auto& finalModelData = nominalPrimalData_.modelDataTrajectory.back();
-  auto& finalRiccatiModification = nominalDualData_.riccatiModificationTrajectory.back();
-  auto& finalProjectedModelData = nominalDualData_.projectedModelDataTrajectory.back();
-  auto& finalProjectedLvFinal = projectedLvTrajectoryStock_.back();
-  auto& finalProjectedKmFinal = projectedKmTrajectoryStock_.back();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::computeFinalProjectedGains(size_t workerIndex, size_t index, const ScalarFunctionQuadraticApproximation& valueFunction) {
+  const auto& finalModelData = nominalPrimalData_.modelDataTrajectory[index];
+  auto& finalRiccatiModification = nominalDualData_.riccatiModificationTrajectory[index];
+  auto& finalProjectedModelData = projectedModelDataStock_[workerIndex];
+  auto& finalProjectedLvFinal = projectedLvTrajectoryStock_[index];
+  auto& finalProjectedKmFinal = projectedKmTrajectoryStock_[index];
 
   const matrix_t SmDummy = matrix_t::Zero(finalModelData.stateDim, finalModelData.stateDim);
   computeProjectionAndRiccatiModification(finalModelData, SmDummy, finalProjectedModelData, finalRiccatiModification);
 
   // projected feedforward
   finalProjectedLvFinal = -finalProjectedModelData.cost.dfdu - finalRiccatiModification.deltaGv_;
-  finalProjectedLvFinal.noalias() -= finalProjectedModelData.dynamics.dfdu.transpose() * finalValueFunction.dfdx;
+  finalProjectedLvFinal.noalias() -= finalProjectedModelData.dynamics.dfdu.transpose() * valueFunction.dfdx;
 
   // projected feedback
   finalProjectedKmFinal = -finalProjectedModelData.cost.dfdux - finalRiccatiModification.deltaGm_;
-  finalProjectedKmFinal.noalias() -= finalProjectedModelData.dynamics.dfdu.transpose() * finalValueFunction.dfdxx;
+  finalProjectedKmFinal.noalias() -= finalProjectedModelData.dynamics.dfdu.transpose() * valueFunction.dfdxx;
 
-  return solveSequentialRiccatiEquationsImpl(finalValueFunction);
+  storeProjectedConstraint(finalProjectedModelData, nominalDualData_.projectedModelDataTrajectory[index]);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::storeProjectedConstraint(const ModelData& projectedModelData, ModelData& storedModelData) {
+  storedModelData.time = projectedModelData.time;
+  storedModelData.stateDim = projectedModelData.stateDim;
+  storedModelData.inputDim = projectedModelData.inputDim;
+  storedModelData.stateInputEqConstraint.f = projectedModelData.stateInputEqConstraint.f;
+  storedModelData.stateInputEqConstraint.dfdx = projectedModelData.stateInputEqConstraint.dfdx;
 }
 
 /******************************************************************************************************/
@@ -245,9 +292,12 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
   while (curIndex >= stopIndex) {
     auto& curProjectedLv = projectedLvTrajectoryStock_[curIndex];
     auto& curProjectedKm = projectedKmTrajectoryStock_[curIndex];
-    auto& curProjectedModelData = nominalDualData_.projectedModelDataTrajectory[curIndex];
+    auto& curProjectedModelData = projectedModelDataStock_[workerIndex];
     auto& curRiccatiModification = nominalDualData_.riccatiModificationTrajectory[curIndex];
-    const auto& curModelData = nominalPrimalData_.modelDataTrajectory[curIndex];
+    auto& curModelData = nominalPrimalData_.modelDataTrajectory[curIndex];
+    if (settings().algorithm_ == ddp::Algorithm::DDP) {
+      addDynamicsSecondOrderTerms(workerIndex, curIndex, valueFunctionNext->dfdx, curModelData);
+    }
 
     auto& curSm = nominalDualData_.valueFunctionTrajectory[curIndex].dfdxx;
     auto& curSv = nominalDualData_.valueFunctionTrajectory[curIndex].dfdx;
@@ -258,6 +308,7 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
     riccatiEquationsPtrStock_[workerIndex]->computeMap(curProjectedModelData, curRiccatiModification, valueFunctionNext->dfdxx,
                                                        valueFunctionNext->dfdx, valueFunctionNext->f, curProjectedKm, curProjectedLv, curSm,
                                                        curSv, curs);
+    storeProjectedConstraint(curProjectedModelData, nominalDualData_.projectedModelDataTrajectory[curIndex]);
     valueFunctionNext = &(nominalDualData_.valueFunctionTrajectory[curIndex]);
 
     if (std::distance(firstEventItr, nextEventItr) >= 0 && curIndex == *nextEventItr) {
@@ -269,25 +320,7 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
           riccatiTransversalityConditions(nominalPrimalData_.modelDataEventTimes[index], curSm, curSv, curs);
 
       nominalDualData_.valueFunctionTrajectory[curIndex] = finalValueTemp;
-
-      const auto& finalModelData = nominalPrimalData_.modelDataTrajectory[curIndex];
-      auto& finalRiccatiModification = nominalDualData_.riccatiModificationTrajectory[curIndex];
-      auto& finalProjectedModelData = nominalDualData_.projectedModelDataTrajectory[curIndex];
-      auto& finalProjectedLvFinal = projectedLvTrajectoryStock_[curIndex];
-      auto& finalProjectedKmFinal = projectedKmTrajectoryStock_[curIndex];
-
-      const matrix_t SmDummy = matrix_t::Zero(finalModelData.stateDim, finalModelData.stateDim);
-      computeProjectionAndRiccatiModification(finalModelData, SmDummy, finalProjectedModelData, finalRiccatiModification);
-
-      // projected feedforward
-      finalProjectedLvFinal = -finalProjectedModelData.cost.dfdu - finalRiccatiModification.deltaGv_;
-      finalProjectedLvFinal.noalias() -=
-          finalProjectedModelData.dynamics.dfdu.transpose() * nominalDualData_.valueFunctionTrajectory[curIndex].dfdx;
-
-      // projected feedback
-      finalProjectedKmFinal = -finalProjectedModelData.cost.dfdux - finalRiccatiModification.deltaGm_;
-      finalProjectedKmFinal.noalias() -=
-          finalProjectedModelData.dynamics.dfdu.transpose() * nominalDualData_.valueFunctionTrajectory[curIndex].dfdxx;
+      computeFinalProjectedGains(workerIndex, curIndex, finalValueTemp);
 
       valueFunctionNext = &finalValueTemp;
 
@@ -297,4 +330,191 @@ void ILQR::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>&
     --curIndex;
   }  // while
 }
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::addDynamicsSecondOrderTerms(size_t workerIndex, size_t timeIndex, const vector_t& SvNext, ModelData& modelData) {
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const scalar_t timeStep = timeTrajectory[timeIndex + 1] - timeTrajectory[timeIndex];
+  if (numerics::almost_eq(timeStep, 0.0)) {
+    return;
+  }
+
+  const auto& time = timeTrajectory[timeIndex];
+  const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_[timeIndex];
+  const auto& input = nominalPrimalData_.primalSolution.inputTrajectory_[timeIndex];
+
+  // Hessian of SvNext' * (x + timeStep * f(t, x, u))
+  auto& optimalControlProblem = optimalControlProblemStock_[workerIndex];
+  optimalControlProblem.preComputationPtr->request(Request::Dynamics + Request::Approximation, time, state, input);
+  const auto dynamicsHessian =
+      optimalControlProblem.dynamicsPtr->flowMapWeightedHessian(time, state, input, SvNext, *optimalControlProblem.preComputationPtr);
+
+  // The stage Hessian is not necessarily positive semi-definite anymore, which would make the value function indefinite and the
+  // Hamiltonian Hessian singular along the backward pass. Therefore, the joint state-input Hessian is corrected.
+  const auto stateDim = modelData.stateDim;
+  const auto inputDim = modelData.inputDim;
+  matrix_t stageHessian(stateDim + inputDim, stateDim + inputDim);
+  stageHessian.topLeftCorner(stateDim, stateDim) = modelData.cost.dfdxx + timeStep * dynamicsHessian.dfdxx;
+  stageHessian.bottomLeftCorner(inputDim, stateDim) = modelData.cost.dfdux + timeStep * dynamicsHessian.dfdux;
+  stageHessian.topRightCorner(stateDim, inputDim) = stageHessian.bottomLeftCorner(inputDim, stateDim).transpose();
+  stageHessian.bottomRightCorner(inputDim, inputDim) = modelData.cost.dfduu + timeStep * dynamicsHessian.dfduu;
+  hessian_correction::shiftHessian(settings().lineSearch_.hessianCorrectionStrategy, stageHessian,
+                                   settings().lineSearch_.hessianCorrectionMultiple);
+
+  modelData.cost.dfdxx = stageHessian.topLeftCorner(stateDim, stateDim);
+  modelData.cost.dfdux = stageHessian.bottomLeftCorner(inputDim, stateDim);
+  modelData.cost.dfduu = stageHessian.bottomRightCorner(inputDim, inputDim);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ILQR::solveParallelRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  // the second-order terms of the dynamics depend on the next value function, which is not available to the scan elements
+  const bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
+  const bool isSecondOrder = settings().algorithm_ == ddp::Algorithm::DDP;
+  if (!settings().parallelRiccatiScan_ || settings().nThreads_ < 2 || isRiskSensitive || isSecondOrder) {
+    return false;
+  }
+
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const auto& modelDataTrajectory = nominalPrimalData_.modelDataTrajectory;
+  auto& valueFunctionTrajectory = nominalDualData_.valueFunctionTrajectory;
+  const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
+
+  // returns the index of the event if the node is a pre-event node, otherwise -1. Same as riccatiEquationsWorker, an event at the
+  // final node is ignored.
+  auto getEventIndex = [&](size_t k) -> int {
+    const auto eventItr = std::lower_bound(postEventIndices.begin(), postEventIndices.end(), k + 1);
+    const bool isPreEvent = eventItr != postEventIndices.end() && *eventItr == k + 1 && k + 1 < N - 1;
+    return isPreEvent ? std::distance(postEventIndices.begin(), eventItr) : -1;
+  };
+
+  /*
+   * elements of the scan: the Riccati modification of each stage is computed independent of the next value function
+   */
+  riccatiScanElements_.resize(N);
+  riccati_scan::setFinalElement(finalValueFunction, riccatiScanElements_.back());
+
+  nextTimeIndex_ = 0;
+  nextTaskId_ = 0;
+  auto elementTask = [&]() {
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+    auto& projectedModelData = projectedModelDataStock_[taskId];
+
+    size_t k;
+    while ((k = nextTimeIndex_++) < N - 1) {
+      const int eventIndex = getEventIndex(k);
+      if (eventIndex >= 0) {
+        riccati_scan::setJumpElement(nominalPrimalData_.modelDataEventTimes[eventIndex], riccatiScanElements_[k]);
+      } else {
+        auto& riccatiModification = nominalDualData_.riccatiModificationTrajectory[k];
+        const matrix_t SmDummy = matrix_t::Zero(modelDataTrajectory[k].stateDim, modelDataTrajectory[k].stateDim);
+        computeProjectionAndRiccatiModification(modelDataTrajectory[k], SmDummy, projectedModelData, riccatiModification);
+        riccati_scan::setStageElement(projectedModelData, riccatiModification.deltaQm_, riccatiScanElements_[k]);
+      }
+    }
+  };
+  runParallel(elementTask, settings().nThreads_);
+
+  /*
+   * work-efficient inclusive scan over the reversed sequence of the elements, such that the element k becomes the product of the
+   * elements k to N-1. The up-sweep and the down-sweep each take log2(N) levels. Within a level, the combined pairs are disjoint.
+   */
+  auto combineLevel = [&](size_t firstIndex, size_t stride) {
+    if (firstIndex >= N) {
+      return;
+    }
+    const size_t numCombinations = (N - 1 - firstIndex) / (2 * stride) + 1;
+    nextTimeIndex_ = 0;
+    auto combineTask = [&]() {
+      riccati_scan::Element result;
+      size_t j;
+      while ((j = nextTimeIndex_++) < numCombinations) {
+        const size_t k = N - 1 - (firstIndex + 2 * stride * j);
+        riccati_scan::combine(riccatiScanElements_[k], riccatiScanElements_[k + stride], result);
+        std::swap(riccatiScanElements_[k], result);
+      }
+    };
+    runParallel(combineTask, std::min(settings().nThreads_, numCombinations));
+  };
+
+  size_t stride = 1;
+  for (; stride < N; stride *= 2) {
+    combineLevel(2 * stride - 1, stride);
+  }
+  for (stride /= 4; stride > 0; stride /= 2) {
+    combineLevel(3 * stride - 1, stride);
+  }
+
+  for (size_t k = 0; k < N - 1; k++) {
+    valueFunctionTrajectory[k].dfdxx.swap(riccatiScanElements_[k].J);
+    valueFunctionTrajectory[k].dfdx = -riccatiScanElements_[k].eta;
+  }
+
+  /*
+   * gains and the increments of the constant term. The scan is exact up to the last node at which the Riccati modification
+   * based on the next value function differs from the one of its element.
+   */
+  scalar_array_t sIncrements(N - 1);
+  std::atomic_int lastInexactIndex{-1};
+
+  nextTimeIndex_ = 0;
+  nextTaskId_ = 0;
+  auto gainsTask = [&]() {
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+
+    auto& projectedModelData = projectedModelDataStock_[taskId];
+    riccati_modification::Data riccatiModification;
+    matrix_t Sm;
+    vector_t Sv;
+
+    size_t k;
+    while ((k = nextTimeIndex_++) < N - 1) {
+      const auto& valueFunctionNext = valueFunctionTrajectory[k + 1];
+      const int eventIndex = getEventIndex(k);
+
+      if (eventIndex >= 0) {
+        const auto& jumpModelData = nominalPrimalData_.modelDataEventTimes[eventIndex];
+        sIncrements[k] = std::get<2>(riccatiTransversalityConditions(jumpModelData, valueFunctionNext.dfdxx, valueFunctionNext.dfdx, 0.0));
+        computeFinalProjectedGains(taskId, k, valueFunctionTrajectory[k]);
+
+      } else {
+        computeProjectionAndRiccatiModification(modelDataTrajectory[k], valueFunctionNext.dfdxx, projectedModelData, riccatiModification);
+
+        const auto& elementModification = nominalDualData_.riccatiModificationTrajectory[k];
+        const scalar_t tol = numeric_traits::weakEpsilon<scalar_t>() * (1.0 + modelDataTrajectory[k].cost.dfdxx.norm());
+        const bool isExact = (riccatiModification.deltaQm_ - elementModification.deltaQm_).norm() < tol &&
+                             riccatiModification.deltaGm_.norm() < tol && riccatiModification.deltaGv_.norm() < tol;
+        if (!isExact) {
+          int index = lastInexactIndex;
+          while (static_cast<int>(k) > index && !lastInexactIndex.compare_exchange_weak(index, static_cast<int>(k))) {
+          }
+        }
+
+        riccatiEquationsPtrStock_[taskId]->computeMap(projectedModelData, riccatiModification, valueFunctionNext.dfdxx,
+                                                      valueFunctionNext.dfdx, 0.0, projectedKmTrajectoryStock_[k],
+                                                      projectedLvTrajectoryStock_[k], Sm, Sv, sIncrements[k]);
+        storeProjectedConstraint(projectedModelData, nominalDualData_.projectedModelDataTrajectory[k]);
+        std::swap(nominalDualData_.riccatiModificationTrajectory[k], riccatiModification);
+      }
+    }
+  };
+  runParallel(gainsTask, settings().nThreads_);
+
+  for (int k = N - 2; k >= 0; k--) {
+    valueFunctionTrajectory[k].f = valueFunctionTrajectory[k + 1].f + sIncrements[k];
+  }
+
+  // solve the remaining nodes sequentially
+  if (lastInexactIndex >= 0) {
+    const std::pair<int, int> partitionInterval{0, lastInexactIndex + 1};
+    riccatiEquationsWorker(0, partitionInterval, valueFunctionTrajectory[lastInexactIndex + 1]);
+  }
+
+  return true;
+}
+
 }  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/SLQ.h"
 
+#include <iterator>
+
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h"
 
@@ -68,6 +70,7 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
     riccatiIntegratorPtrStock_.emplace_back(newIntegrator(integratorType));
   }  // end of i loop
+  modelDataStock_.resize(settings().nThreads_);
 
   Eigen::initParallel();
 }
@@ -75,46 +78,59 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDataContainer& primalData) {
+void SLQ::approximateIntermediateLQ(DualDataContainer& dualData, PrimalDataContainer& primalData) {
   // create alias
   const auto& timeTrajectory = primalData.primalSolution.timeTrajectory_;
   const auto& stateTrajectory = primalData.primalSolution.stateTrajectory_;
   const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
   const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
-  const auto& multiplierTrajectory = dualSolution.intermediates;
+  const auto& multiplierTrajectory = dualData.dualSolution.intermediates;
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
+  auto& projectedModelDataTrajectory = dualData.projectedModelDataTrajectory;
+  auto& riccatiModificationTrajectory = dualData.riccatiModificationTrajectory;
 
-  modelDataTrajectory.clear();
-  modelDataTrajectory.resize(timeTrajectory.size());
+  // The unprojected LQ approximation is only read after the projection if the next iteration reuses it. Otherwise, each worker
+  // approximates into its own scratch model data and only the projected model data is stored.
+  const bool storeIntermediateLQ = settings().incrementalLqApproximation_;
+  primalData.resizeModelDataTrajectory(storeIntermediateLQ ? timeTrajectory.size() : 0);
+  dualData.resizeProjectedModelData(timeTrajectory.size());
 
   nextTimeIndex_ = 0;
   nextTaskId_ = 0;
   auto task = [&]() {
     const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+    const matrix_t SmDummy = matrix_t::Zero(0, 0);
 
     // get next time index is atomic
     size_t timeIndex;
     while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
-      // approximate LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
-
-      // checking the numerical properties
-      if (settings().checkNumericalStability_) {
-        const auto errSize =
-            checkSize(modelDataTrajectory[timeIndex], stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
-        if (!errSize.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
-        }
-        const std::string errProperties = checkDynamicsProperties(modelDataTrajectory[timeIndex]) +
-                                          checkCostProperties(modelDataTrajectory[timeIndex]) +
-                                          checkConstraintProperties(modelDataTrajectory[timeIndex]);
-        if (!errProperties.empty()) {
-          throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
-                                   std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+      ModelData& modelData = storeIntermediateLQ ? modelDataTrajectory[timeIndex] : modelDataStock_[taskId];
+
+      // approximate LQ for the given time index, unless the approximation of the previous iteration can be reused
+      if (!reuseIntermediateLQ(timeIndex, primalData, modelData)) {
+        ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                        inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelData);
+
+        // checking the numerical properties
+        if (settings().checkNumericalStability_) {
+          const auto errSize = checkSize(modelData, stateTrajectory[timeIndex].rows(), inputTrajectory[timeIndex].rows());
+          if (!errSize.empty()) {
+            throw std::runtime_error("[SLQ::approximateIntermediateLQ] Mismatch in dimensions at intermediate time: " +
+                                     std::to_string(timeTrajectory[timeIndex]) + "\n" + errSize);
+          }
+          const std::string errProperties =
+              checkDynamicsProperties(modelData) + checkCostProperties(modelData) + checkConstraintProperties(modelData);
+          if (!errProperties.empty()) {
+            throw std::runtime_error("[SLQ::approximateIntermediateLQ] Ill-posed problem at intermediate time: " +
+                                     std::to_string(timeTrajectory[timeIndex]) + "\n" + errProperties);
+          }
         }
       }
+
+      // The Hamiltonian's Hessian of SLQ does not depend on the value function. Therefore, the projection and the Riccati
+      // modification are computed here while the LQ approximation of the node is still in cache.
+      computeProjectionAndRiccatiModification(modelData, SmDummy, projectedModelDataTrajectory[timeIndex],
+                                              riccatiModificationTrajectory[timeIndex]);
     }  // end of while loop
   };
 
@@ -172,31 +188,7 @@ void SLQ::calculateControllerWorker(size_t timeIndex, const PrimalDataContainer&
 /******************************************************************************************************/
 /***************************************************************************************************** */
 scalar_t SLQ::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
-  // fully compute the riccatiModifications and projected modelData
-  // number of the intermediate LQ variables
-  const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-
-  nominalDualData_.riccatiModificationTrajectory.resize(N);
-  nominalDualData_.projectedModelDataTrajectory.resize(N);
-
-  if (N > 0) {
-    // perform the computeRiccatiModificationTerms for partition i
-    nextTimeIndex_ = 0;
-    nextTaskId_ = 0;
-    auto task = [this, N]() {
-      int timeIndex;
-      const matrix_t SmDummy = matrix_t::Zero(0, 0);
-
-      // get next time index is atomic
-      while ((timeIndex = nextTimeIndex_++) < N) {
-        computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[timeIndex], SmDummy,
-                                                nominalDualData_.projectedModelDataTrajectory[timeIndex],
-                                                nominalDualData_.riccatiModificationTrajectory[timeIndex]);
-      }
-    };
-    runParallel(task, settings().nThreads_);
-  }
-
+  // the riccatiModifications and the projected modelData are computed in approximateIntermediateLQ
   return solveSequentialRiccatiEquationsImpl(finalValueFunction);
 }
 
@@ -285,10 +277,14 @@ void SLQ::integrateRiccatiEquationNominalTime(IntegratorBase& riccatiIntegrator,
     iterator_t endTimeItr = SsNormalizedSwitchingTimesIndices[i].second;
 
     // solve Riccati equations
-    Observer observer(&allSsTrajectory);
-    const auto maxNumTimeSteps = static_cast<size_t>(settings().maxNumStepsPerSecond_ * std::max(1.0, partitionDuration));
-    riccatiIntegrator.integrateTimes(riccatiEquation, observer, allSsFinal, beginTimeItr, endTimeItr, settings().timeStep_,
-                                     settings().absTolODE_, settings().relTolODE_, maxNumTimeSteps);
+    if (settings().backwardPassNumSubsteps_ > 0) {
+      integrateRiccatiEquationFixedStep(riccatiEquation, beginTimeItr, endTimeItr, allSsFinal, allSsTrajectory);
+    } else {
+      Observer observer(&allSsTrajectory);
+      const auto maxNumTimeSteps = static_cast<size_t>(settings().maxNumStepsPerSecond_ * std::max(1.0, partitionDuration));
+      riccatiIntegrator.integrateTimes(riccatiEquation, observer, allSsFinal, beginTimeItr, endTimeItr, settings().timeStep_,
+                                       settings().absTolODE_, settings().relTolODE_, maxNumTimeSteps);
+    }
 
     if (i < numEvents) {
       allSsFinal = riccatiEquation.computeJumpMap(*endTimeItr, allSsTrajectory.back());
@@ -301,4 +297,32 @@ void SLQ::integrateRiccatiEquationNominalTime(IntegratorBase& riccatiIntegrator,
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::integrateRiccatiEquationFixedStep(ContinuousTimeRiccatiEquations& riccatiEquation, scalar_array_t::const_iterator beginTimeItr,
+                                            scalar_array_t::const_iterator endTimeItr, vector_t allSs,
+                                            vector_array_t& allSsTrajectory) const {
+  const auto numSubsteps = settings().backwardPassNumSubsteps_;
+
+  allSsTrajectory.push_back(allSs);
+  for (auto timeItr = beginTimeItr; std::next(timeItr) < endTimeItr; ++timeItr) {
+    const scalar_t dt = (*std::next(timeItr) - *timeItr) / static_cast<scalar_t>(numSubsteps);
+    // zero-length intervals, e.g. of the extended nominal time at events, do not change the value function
+    if (dt > 0.0) {
+      scalar_t z = *timeItr;
+      for (size_t i = 0; i < numSubsteps; i++) {
+        // classical 4th-order Runge-Kutta step
+        const vector_t k1 = riccatiEquation.computeFlowMap(z, allSs);
+        const vector_t k2 = riccatiEquation.computeFlowMap(z + 0.5 * dt, allSs + (0.5 * dt) * k1);
+        const vector_t k3 = riccatiEquation.computeFlowMap(z + 0.5 * dt, allSs + (0.5 * dt) * k2);
+        const vector_t k4 = riccatiEquation.computeFlowMap(z + dt, allSs + dt * k3);
+        allSs += (dt / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+        z = *timeItr + static_cast<scalar_t>(i + 1) * dt;
+      }
+    }
+    allSsTrajectory.push_back(allSs);
+  }
+}
+
 }  // namespace ocs2
@@ -85,6 +85,15 @@ vector_t ContinuousTimeRiccatiEquations::convert2Vector(const matrix_t& Sm, cons
 /******************************************************************************************************/
 void ContinuousTimeRiccatiEquations::convert2Matrix(const vector_t& allSs, matrix_t& Sm, vector_t& Sv, scalar_t& s) {
   /* Sm is symmetric. Here, we map the first entries from allSs onto the upper triangular part of the symmetric matrix*/
+  convert2UpperTriangular(allSs, Sm, Sv, s);
+  Sm.template triangularView<Eigen::StrictlyLower>() = Sm.template triangularView<Eigen::StrictlyUpper>().transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContinuousTimeRiccatiEquations::convert2UpperTriangular(const vector_t& allSs, matrix_t& Sm, vector_t& Sv, scalar_t& s) {
+  /* Only the upper triangular part of Sm is written. The strictly lower part is left untouched*/
   int count = 0;
   int nRows = 0;
 
@@ -98,7 +107,6 @@ void ContinuousTimeRiccatiEquations::convert2Matrix(const vector_t& allSs, matri
     Sm.block(0, col, nRows, 1) << Eigen::Map<const vector_t>(allSs.data() + count, nRows);
     count += nRows;
   }
-  Sm.template triangularView<Eigen::Lower>() = Sm.template triangularView<Eigen::Upper>().transpose();
 
   /* extract the vector Sv*/
   Sv = Eigen::Map<const vector_t>(allSs.data() + count, state_dim);
@@ -154,7 +162,8 @@ vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector
   const scalar_t t = -z;  // denormalized time
   const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
 
-  convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
+  // the flow map only reads and writes the upper triangular parts of Sm and dSm
+  convert2UpperTriangular(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
     computeFlowMapILEG(indexAlpha, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_,
                        continuousTimeRiccatiData_, continuousTimeRiccatiData_.dSm_, continuousTimeRiccatiData_.dSv_,
@@ -174,11 +183,11 @@ vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector
 void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv,
                                                        const scalar_t& s, ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv,
                                                        scalar_t& ds) const {
-  /* note: according to some discussions on stackoverflow, it does not buy
-   * computation time if multiplications with symmetric matrices are executed
-   * using selfadjointView(). Doing the full multiplication seems to be faster
-   * because of vectorization
+  /* note: only the upper triangular part of Sm is read and only the upper triangular part of dSm is
+   * computed, since convert2Vector only transcribes that part. The symmetric terms of dSm are therefore
+   * accumulated with triangular products which need half of the flops of the dense ones.
    */
+  const auto SmSymmetric = Sm.template selfadjointView<Eigen::Upper>();
 
   // Hv
   creCache.projectedHv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias);
@@ -204,7 +213,7 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   creCache.projectedLv_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv);
 
   // projectedGm = projectedPm + projectedBm^T * Sm [COMPLEXITY: nx^2 * np]
-  creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * Sm;
+  creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * SmSymmetric;
 
   // projectedGv = projectedRv + projectedBm^T * Sv [COMPLEXITY: nx * np]
   creCache.projectedGv_.noalias() += creCache.projectedBm_.transpose() * Sv;
@@ -216,8 +225,7 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
 
   // precomputation
   // [COMPLEXITY: nx^3 + nx^2 * np]
-  creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * creCache.projectedAm_;
-  creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
+  creCache.SmTrans_projectedAm_.noalias() = SmSymmetric * creCache.projectedAm_;
   if (!reducedFormRiccati_) {
     // Rm
     creCache.projectedRm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu);
@@ -231,20 +239,20 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    * Sm
    *
    * reducedFormRiccati:
-   *   [TOTAL COMPLEXITY: (nx^3) + 2(nx^2 * np)]
+   *   [TOTAL COMPLEXITY: (nx^3) + 1.5(nx^2 * np)]
    * other
-   *   [TOTAL COMPLEXITY: (nx^3) + 3(nx^2 * np) + (nx * np^2)]
+   *   [TOTAL COMPLEXITY: (nx^3) + 2.5(nx^2 * np) + (nx * np^2)]
    */
+  auto dSmUpper = dSm.template triangularView<Eigen::Upper>();
   // += deltaQm + Sm^T * Am + Am^T * Sm
-  dSm += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
-  if (reducedFormRiccati_) {
-    // += Km^T * Gm-
-    dSm += creCache.projectedKm_T_projectedGm_;
-  } else {
-    // += Km^T * Gm + Gm^T * Km
-    dSm += creCache.projectedKm_T_projectedGm_ + creCache.projectedKm_T_projectedGm_.transpose();
-    // += Km^T * Hm * Km
-    dSm.noalias() += creCache.projectedKm_.transpose() * creCache.projectedRm_projectedKm_;
+  dSmUpper += creCache.deltaQm_ + creCache.SmTrans_projectedAm_ + creCache.SmTrans_projectedAm_.transpose();
+  // += Km^T * Gm [COMPLEXITY: 0.5(nx^2 * np)]
+  dSmUpper += creCache.projectedKm_.transpose() * creCache.projectedGm_;
+  if (!reducedFormRiccati_) {
+    // += Gm^T * Km [COMPLEXITY: 0.5(nx^2 * np)]
+    dSmUpper += creCache.projectedGm_.transpose() * creCache.projectedKm_;
+    // += Km^T * Hm * Km [COMPLEXITY: 0.5(nx^2 * np)]
+    dSmUpper += creCache.projectedKm_.transpose() * creCache.projectedRm_projectedKm_;
   }
 
   /*
@@ -256,7 +264,7 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    *   [TOTAL COMPLEXITY: 2*(nx^2) + 3(nx * np)]
    */
   // += Sm * Hv
-  dSv.noalias() += Sm.transpose() * creCache.projectedHv_;
+  dSv.noalias() += SmSymmetric * creCache.projectedHv_;
   // += Am^T * Sv
   dSv.noalias() += creCache.projectedAm_.transpose() * Sv;
   if (reducedFormRiccati_) {
@@ -302,10 +310,11 @@ void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t>
   // Sigma
   creCache.dynamicsCovariance_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance);
 
+  const auto SmSymmetric = Sm.template selfadjointView<Eigen::Upper>();
   creCache.Sigma_Sv_.noalias() = creCache.dynamicsCovariance_ * Sv;
-  creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * Sm;
+  creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * SmSymmetric;
 
-  dSm.noalias() += riskSensitiveCoeff_ * Sm.transpose() * creCache.Sigma_Sm_;
+  dSm.noalias() += riskSensitiveCoeff_ * (SmSymmetric * creCache.Sigma_Sm_);
   dSv.noalias() += riskSensitiveCoeff_ * creCache.Sigma_Sm_.transpose() * Sv;
   ds += 0.5 * creCache.Sigma_Sm_.trace() + 0.5 * riskSensitiveCoeff_ * Sv.dot(creCache.Sigma_Sv_);
 }
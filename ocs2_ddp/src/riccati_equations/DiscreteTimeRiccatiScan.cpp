@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h"
+
+namespace ocs2 {
+namespace riccati_scan {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setStageElement(const ModelData& projectedModelData, const matrix_t& deltaQm, Element& element) {
+  const auto& Am = projectedModelData.dynamics.dfdx;
+  const auto& Bm = projectedModelData.dynamics.dfdu;
+  const auto& Hv = projectedModelData.dynamicsBias;
+  const auto& Pm = projectedModelData.cost.dfdux;
+  const auto& Rv = projectedModelData.cost.dfdu;
+
+  // eliminate the state-input cross term: u = w - inv(Rm) * (Pm * x + Rv)
+  const auto RmLlt = projectedModelData.cost.dfduu.llt();
+  const matrix_t RmInvPm = RmLlt.solve(Pm);
+  const vector_t RmInvRv = RmLlt.solve(Rv);
+
+  // A = Am - Bm * inv(Rm) * Pm
+  element.A = Am;
+  element.A.noalias() -= Bm * RmInvPm;
+
+  // b = Hv - Bm * inv(Rm) * Rv
+  element.b = Hv;
+  element.b.noalias() -= Bm * RmInvRv;
+
+  // C = Bm * inv(Rm) * Bm^T
+  element.C.noalias() = Bm * RmLlt.solve(Bm.transpose());
+
+  // eta = -(Qv - Pm^T * inv(Rm) * Rv)
+  element.eta = -projectedModelData.cost.dfdx;
+  element.eta.noalias() += Pm.transpose() * RmInvRv;
+
+  // J = Qm + deltaQm - Pm^T * inv(Rm) * Pm
+  element.J = projectedModelData.cost.dfdxx + deltaQm;
+  element.J.noalias() -= Pm.transpose() * RmInvPm;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setJumpElement(const ModelData& jumpModelData, Element& element) {
+  const auto stateDim = jumpModelData.dynamics.dfdx.rows();
+  element.A = jumpModelData.dynamics.dfdx;
+  element.b = jumpModelData.dynamicsBias;
+  element.C.setZero(stateDim, stateDim);
+  element.eta = -jumpModelData.cost.dfdx;
+  element.J = jumpModelData.cost.dfdxx;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setFinalElement(const ScalarFunctionQuadraticApproximation& finalValueFunction, Element& element) {
+  const auto stateDim = finalValueFunction.dfdx.size();
+  element.A.setZero(stateDim, stateDim);
+  element.b.setZero(stateDim);
+  element.C.setZero(stateDim, stateDim);
+  element.eta = -finalValueFunction.dfdx;
+  element.J = finalValueFunction.dfdxx;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void combine(const Element& first, const Element& second, Element& result) {
+  // M = I + C_ij * J_jk
+  matrix_t M = first.C * second.J;
+  M.diagonal().array() += 1.0;
+
+  // inv(I + C_ij * J_jk) * [A_ij, b_ij + C_ij * eta_jk, C_ij]
+  const auto MLu = M.partialPivLu();
+  const matrix_t MInvA = MLu.solve(first.A);
+  vector_t b = first.b;
+  b.noalias() += first.C * second.eta;
+  const vector_t MInvB = MLu.solve(b);
+  const matrix_t MInvC = MLu.solve(first.C);
+
+  // A_ik = A_jk * inv(I + C_ij * J_jk) * A_ij
+  result.A.noalias() = second.A * MInvA;
+
+  // b_ik = A_jk * inv(I + C_ij * J_jk) * (b_ij + C_ij * eta_jk) + b_jk
+  result.b = second.b;
+  result.b.noalias() += second.A * MInvB;
+
+  // C_ik = A_jk * inv(I + C_ij * J_jk) * C_ij * A_jk^T + C_jk
+  const matrix_t A_MInvC = second.A * MInvC;
+  result.C = second.C;
+  result.C.noalias() += A_MInvC * second.A.transpose();
+
+  // inv(I + J_jk * C_ij) = inv(M)^T
+  const auto MTransLu = M.transpose().partialPivLu();
+
+  // eta_ik = A_ij^T * inv(I + J_jk * C_ij) * (eta_jk - J_jk * b_ij) + eta_ij
+  vector_t eta = second.eta;
+  eta.noalias() -= second.J * first.b;
+  result.eta = first.eta;
+  result.eta.noalias() += first.A.transpose() * MTransLu.solve(eta);
+
+  // J_ik = A_ij^T * inv(I + J_jk * C_ij) * J_jk * A_ij + J_ij
+  const matrix_t J_A = second.J * first.A;
+  result.J = first.J;
+  result.J.noalias() += first.A.transpose() * MTransLu.solve(J_A);
+
+  // keep the Hessians symmetric
+  result.C = 0.5 * (result.C + result.C.transpose()).eval();
+  result.J = 0.5 * (result.J + result.J.transpose()).eval();
+}
+
+}  // namespace riccati_scan
+}  // namespace ocs2
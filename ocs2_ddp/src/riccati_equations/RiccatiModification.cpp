@@ -46,6 +46,9 @@ void display(const Data& data) {
 
   std::cerr << "constraintRangeProjector:\n" << data.constraintRangeProjector_ << "\n";
   std::cerr << "constraintNullProjector: \n" << data.constraintNullProjector_ << "\n";
+  std::cerr << "constraintLagrangianBias:\n" << data.constraintLagrangianBias_.transpose() << "\n";
+  std::cerr << "constraintLagrangianStateGain:\n" << data.constraintLagrangianStateGain_ << "\n";
+  std::cerr << "constraintLagrangianCostateGain:\n" << data.constraintLagrangianCostateGain_ << "\n";
   std::cerr << std::endl;
 }
 
@@ -53,7 +53,11 @@ LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(search_strategy::Settings
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LevenbergMarquardtStrategy::reset() {
+  const auto convergedRiccatiMultiple = lmModule_.riccatiMultiple;
   lmModule_ = LevenbergMarquardtModule();
+  if (settings_.warmStartRiccatiMultiple) {
+    lmModule_.riccatiMultiple = convergedRiccatiMultiple;
+  }
 }
 
 /******************************************************************************************************/
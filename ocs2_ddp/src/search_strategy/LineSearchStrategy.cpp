@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/search_strategy/LineSearchStrategy.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/HessianCorrection.h"
 
@@ -49,6 +52,8 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
       threadPoolRef_(threadPoolRef),
       tempDualSolutions_(threadPoolRef.numThreads() + 1),
       workersSolution_(threadPoolRef.numThreads() + 1),
+      activeStepLengths_(threadPoolRef.numThreads() + 1),
+      segmentedRollouts_(threadPoolRef.numThreads() + 1),
       rolloutRefStock_(std::move(rolloutRefStock)),
       optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
       meritFunc_(std::move(meritFunc)) {
@@ -83,15 +88,26 @@ size_t LineSearchStrategy::maxNumOfSearches() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution) {
+void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, search_strategy::Solution& solution, bool segmentedRollout) {
   auto& problem = optimalControlProblemRefStock_[taskId];
   auto& rollout = rolloutRefStock_[taskId];
 
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  if (segmentedRollout) {
+    // The zero step length reproduces the previous solution. The other step lengths deviate from the rollout of the zero step length.
+    const bool isZeroStep = stepLength == 0.0;
+    const auto guessInitTime = isZeroStep ? previousInitTime_ : lineSearchInputRef_.timePeriodPtr->first;
+    const auto& guessTime = isZeroStep ? previousTimeTrajectory_ : baselineTimeTrajectory_;
+    const auto& guessState = isZeroStep ? previousStateTrajectory_ : baselineStateTrajectory_;
+    solution.avgTimeStep = segmentedRolloutTrajectory(taskId, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                                      lineSearchInputRef_.timePeriodPtr->second, guessInitTime, guessTime,
+                                                      guessState, solution.primalSolution);
+  } else {
+    solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  }
 
   // adjust dual solution only if it is required
   const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
@@ -126,6 +142,151 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LineSearchStrategy::segmentedRolloutTrajectory(size_t taskId, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                                        scalar_t guessInitTime, const scalar_array_t& guessTime,
+                                                        const vector_array_t& guessState, PrimalSolution& primalSolution) {
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+  const auto numNodes = guessTime.size();
+  const bool isGuessValid = numNodes > 2 && numerics::almost_eq(guessInitTime, initTime) &&
+                            (guessState.front() - initState).lpNorm<Eigen::Infinity>() <= settings_.rolloutDefectTolerance;
+
+  // The segments start at the nodes of the guess. Nodes close to an event are skipped.
+  auto& segments = segmentedRollouts_[taskId].segments;
+  auto& defectSegmentIndices = segmentedRollouts_[taskId].defectSegmentIndices;
+  auto& nextSegmentId = segmentedRollouts_[taskId].nextSegmentId;
+  const auto firstRolloutIndex = taskId * rolloutGroupSize_;
+  const auto maxNumSegments = rolloutGroupSize_;
+  segments.resize(1);
+  segments.front().initTime = initTime;
+  segments.front().initState = initState;
+  for (size_t i = 1; isGuessValid && i < maxNumSegments; i++) {
+    const size_t k = i * numNodes / maxNumSegments;
+    if (k == 0 || k + 1 >= numNodes) {
+      continue;
+    }
+    const auto t = guessTime[k];
+    const auto tLower = guessTime[k - 1];
+    const auto tUpper = guessTime[k + 1];
+    const bool isInterior = tLower < t && t < tUpper && segments.back().initTime < tLower && tUpper < finalTime;
+    const bool isCloseToEvent =
+        std::any_of(eventTimes.cbegin(), eventTimes.cend(), [&](scalar_t te) { return tLower <= te && te <= tUpper; });
+    if (isInterior && !isCloseToEvent) {
+      // the rollout starts weakEpsilon after its initial time, therefore the segment's grid starts at the node
+      segments.emplace_back();
+      segments.back().initTime = t - numeric_traits::weakEpsilon<scalar_t>();
+      segments.back().initState = guessState[k];
+    }
+  }
+  for (size_t i = 0; i + 1 < segments.size(); i++) {
+    segments[i].finalTime = segments[i + 1].initTime;
+  }
+  segments.back().finalTime = finalTime;
+
+  // Each segment is integrated by its own rollout instance of the group. An exception is rethrown once all segments are finished, since
+  // the other segments still refer to the controller.
+  auto* controllerPtr = primalSolution.controllerPtr_.get();
+  auto integrateSegment = [&](size_t i) {
+    segments[i].errorPtr = nullptr;
+    try {
+      rolloutSegment(firstRolloutIndex + i, controllerPtr, primalSolution.modeSchedule_, segments[i]);
+    } catch (...) {
+      segments[i].errorPtr = std::current_exception();
+    }
+  };
+  auto rethrowSegmentError = [&]() {
+    for (const auto& segment : segments) {
+      if (segment.errorPtr != nullptr) {
+        std::rethrow_exception(segment.errorPtr);
+      }
+    }
+  };
+
+  // integrate all segments concurrently
+  nextSegmentId = 0;
+  auto task = [&](int) {
+    size_t i;
+    while ((i = nextSegmentId++) < segments.size()) {
+      integrateSegment(i);
+    }
+  };
+  threadPoolRef_.runParallel(task, segments.size());
+  rethrowSegmentError();
+  if (segments.size() > 1) {
+    ++numSegmentedRollouts_;
+  }
+
+  // reconcile the defects: the segments that do not continue their preceding segment are integrated again, concurrently, from the final
+  // state of their preceding segment. The first segment is exact, therefore each pass makes at least one more segment exact.
+  while (true) {
+    defectSegmentIndices.clear();
+    for (size_t i = 1; i < segments.size(); i++) {
+      const auto& precedingFinalState = segments[i - 1].stateTrajectory.back();
+      if ((precedingFinalState - segments[i].initState).lpNorm<Eigen::Infinity>() > settings_.rolloutDefectTolerance) {
+        defectSegmentIndices.push_back(i);
+      }
+    }
+    if (defectSegmentIndices.empty()) {
+      break;
+    }
+
+    for (const auto i : defectSegmentIndices) {
+      segments[i].initState = segments[i - 1].stateTrajectory.back();
+    }
+    nextSegmentId = 0;
+    auto reconcileTask = [&](int) {
+      size_t j;
+      while ((j = nextSegmentId++) < defectSegmentIndices.size()) {
+        integrateSegment(defectSegmentIndices[j]);
+      }
+    };
+    threadPoolRef_.runParallel(reconcileTask, defectSegmentIndices.size());
+    rethrowSegmentError();
+  }
+
+  // concatenate the segments. The final node of each segment is replaced by the initial node of the next one.
+  primalSolution.timeTrajectory_.clear();
+  primalSolution.postEventIndices_.clear();
+  primalSolution.stateTrajectory_.clear();
+  primalSolution.inputTrajectory_.clear();
+  for (const auto& segment : segments) {
+    if (!primalSolution.timeTrajectory_.empty()) {
+      primalSolution.timeTrajectory_.pop_back();
+      primalSolution.stateTrajectory_.pop_back();
+      primalSolution.inputTrajectory_.pop_back();
+    }
+    const auto offset = primalSolution.timeTrajectory_.size();
+    for (const auto index : segment.postEventIndices) {
+      primalSolution.postEventIndices_.push_back(offset + index);
+    }
+    primalSolution.timeTrajectory_.insert(primalSolution.timeTrajectory_.end(), segment.timeTrajectory.cbegin(),
+                                          segment.timeTrajectory.cend());
+    primalSolution.stateTrajectory_.insert(primalSolution.stateTrajectory_.end(), segment.stateTrajectory.cbegin(),
+                                           segment.stateTrajectory.cend());
+    primalSolution.inputTrajectory_.insert(primalSolution.inputTrajectory_.end(), segment.inputTrajectory.cbegin(),
+                                           segment.inputTrajectory.cend());
+  }
+
+  // average time step
+  return (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LineSearchStrategy::rolloutSegment(size_t rolloutIndex, ControllerBase* controllerPtr, const ModeSchedule& modeSchedule,
+                                        RolloutSegment& segment) {
+  RolloutBase& rollout = rolloutRefStock_[rolloutIndex];
+  segment.modeSchedule = modeSchedule;
+  const auto xFinal = rollout.run(segment.initTime, segment.initState, segment.finalTime, controllerPtr, segment.modeSchedule,
+                                  segment.timeTrajectory, segment.postEventIndices, segment.stateTrajectory, segment.inputTrajectory);
+  if (!xFinal.allFinite()) {
+    throw std::runtime_error("[LineSearchStrategy::rolloutSegment] System became unstable during the rollout!");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -140,13 +301,29 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
   bestSolutionRef_ = &solutionRef;
 
-  // perform a rollout with steplength zero.
+  // Without segments, each task evaluates its step lengths with its own rollout instance. With segments, the rollout instances are split
+  // into groups of numRolloutSegments, such that the step lengths are still evaluated concurrently by the groups, and each group
+  // integrates the segments of its rollouts concurrently. Since the groups leave at least one thread of the pool idle, the segment tasks
+  // that the groups submit to the pool are always processed.
+  const bool isSegmented = settings_.numRolloutSegments > 1;
+  rolloutGroupSize_ = isSegmented ? std::min(settings_.numRolloutSegments, rolloutRefStock_.size()) : 1;
+  const size_t numGroups = std::max<size_t>(rolloutRefStock_.size() / rolloutGroupSize_, 1);
+  const size_t numTasks = isSegmented ? std::min(numGroups, std::max<size_t>(threadPoolRef_.numThreads(), 1)) : threadPoolRef_.numThreads();
+
+  // perform a rollout with steplength zero
   constexpr size_t taskId = 0;
   constexpr scalar_t stepLength = 0.0;
   try {
-    computeSolution(taskId, stepLength, workersSolution_[taskId]);
+    const auto rolloutStartTime = std::chrono::steady_clock::now();
+    computeSolution(taskId, stepLength, workersSolution_[taskId], isSegmented);
+    // predicts the evaluation time of a step length. It is a lower bound if the rollout is segmented.
+    baselineDuration_ = std::chrono::steady_clock::now() - rolloutStartTime;
     baselineMerit_ = workersSolution_[taskId].performanceIndex.merit;
     unoptimizedControllerUpdateIS_ = computeControllerUpdateIS(unoptimizedController);
+    if (isSegmented) {
+      baselineTimeTrajectory_ = workersSolution_[taskId].primalSolution.timeTrajectory_;
+      baselineStateTrajectory_ = workersSolution_[taskId].primalSolution.stateTrajectory_;
+    }
 
     // record solution
     bestStepSize_ = stepLength;
@@ -164,14 +341,24 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
+  for (auto& activeStepLength : activeStepLengths_) {
+    activeStepLength = std::numeric_limits<scalar_t>::max();
+  }
   auto task = [&](int) { lineSearchTask(nextTaskId_++); };
-  threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  threadPoolRef_.runParallel(task, numTasks);
 
   // revitalize all integrators
   for (RolloutBase& rollout : rolloutRefStock_) {
     rollout.reactivateRollout();
   }
 
+  // keep the states of the solution to initialize the segments of the next rollout with zero step length
+  if (isSegmented) {
+    previousInitTime_ = timePeriod.first;
+    previousTimeTrajectory_ = bestSolutionRef_->primalSolution.timeTrajectory_;
+    previousStateTrajectory_ = bestSolutionRef_->primalSolution.stateTrajectory_;
+  }
+
   // display
   if (baseSettings_.displayInfo) {
     std::cerr << "The chosen step length is: " + std::to_string(bestStepSize_) << "\n";
@@ -197,6 +384,21 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
       break;
     }
 
+    // Announce the step length before checking it against the best candidate. Hence, either this task skips the step length or a
+    // task that later accepts a larger step length sees it and cancels its rollout.
+    activeStepLengths_[taskId] = stepLength;
+
+    // stop if the rollout is not expected to finish before the deadline. The best candidate so far is kept. The maximum step length is
+    // always evaluated such that every iteration makes progress.
+    const bool isDeadlineSet = deadline_ != std::chrono::steady_clock::time_point::max();
+    if (alphaExp > 0 && isDeadlineSet && std::chrono::steady_clock::now() + baselineDuration_ > deadline_) {
+      if (baseSettings_.displayInfo) {
+        printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                    " is skipped: It does not fit before the deadline!\n");
+      }
+      break;
+    }
+
     // skip if the current learning rate is less than the best candidate
     if (stepLength < bestStepSize_) {
       // display
@@ -210,7 +412,7 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
     }
 
     try {
-      computeSolution(taskId, stepLength, workersSolution_[taskId]);
+      computeSolution(taskId, stepLength, workersSolution_[taskId], settings_.numRolloutSegments > 1);
     } catch (const std::exception& error) {
       if (baseSettings_.displayInfo) {
         printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
@@ -236,16 +438,22 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
         bestStepSize_ = stepLength;
         swap(*bestSolutionRef_, workersSolution_[taskId]);
         terminateLinesearchTasks = std::all_of(alphaProcessed_.cbegin(), alphaProcessed_.cbegin() + alphaExp, [](bool f) { return f; });
+
+        // cancel the ongoing rollouts of the smaller step lengths since they cannot be accepted anymore
+        for (size_t i = 0; i < activeStepLengths_.size(); i++) {
+          if (i != taskId && activeStepLengths_[i] < stepLength) {
+            for (size_t j = i * rolloutGroupSize_; j < std::min((i + 1) * rolloutGroupSize_, rolloutRefStock_.size()); j++) {
+              rolloutRefStock_[j].get().abortRollout();
+            }
+          }
+        }
       }
 
       alphaProcessed_[alphaExp] = true;
     }  // end lock
 
-    // kill other ongoing line search tasks
+    // all the larger step lengths are processed and the rollouts of the smaller ones are already cancelled
     if (terminateLinesearchTasks) {
-      for (RolloutBase& rollout : rolloutRefStock_) {
-        rollout.abortRollout();
-      }
       if (baseSettings_.displayInfo) {
         printString("    LS: interrupt other rollout's integrations.\n");
       }
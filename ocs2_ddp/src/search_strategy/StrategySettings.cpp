@@ -83,6 +83,8 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
   settings.hessianCorrectionStrategy = hessian_correction::fromString(hessianCorrectionStrategyName);
 
   loadData::loadPtreeValue(pt, settings.hessianCorrectionMultiple, fieldName + ".hessianCorrectionMultiple", verbose);
+  loadData::loadPtreeValue(pt, settings.numRolloutSegments, fieldName + ".numRolloutSegments", verbose);
+  loadData::loadPtreeValue(pt, settings.rolloutDefectTolerance, fieldName + ".rolloutDefectTolerance", verbose);
 
   if (verbose) {
     std::cerr << " #### }" << std::endl;
@@ -111,6 +113,7 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
   loadData::loadPtreeValue(pt, settings.riccatiMultipleDefaultRatio, fieldName + ".riccatiMultipleDefaultRatio", verbose);
   loadData::loadPtreeValue(pt, settings.riccatiMultipleDefaultFactor, fieldName + ".riccatiMultipleDefaultFactor", verbose);
   loadData::loadPtreeValue(pt, settings.maxNumSuccessiveRejections, fieldName + ".maxNumSuccessiveRejections", verbose);
+  loadData::loadPtreeValue(pt, settings.warmStartRiccatiMultiple, fieldName + ".warmStartRiccatiMultiple", verbose);
   if (verbose) {
     std::cerr << " #### }" << std::endl;
   }
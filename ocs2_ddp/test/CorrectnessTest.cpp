@@ -264,6 +264,46 @@ TEST_P(DDPCorrectness, TestSLQ) {
   correctnessTest(ddpSettings, performanceIndex, solution);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(DDPCorrectness, TestSLQFixedStepBackwardPass) {
+  // settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, getNumThreads(), getSearchStrategy());
+  ddpSettings.backwardPassNumSubsteps_ = 5;
+
+  // ddp
+  ocs2::SLQ ddp(ddpSettings, *rolloutPtr, *problemPtr, *operatingPointsPtr);
+
+  ddp.getReferenceManager().setTargetTrajectories(targetTrajectories);
+  ddp.run(startTime, initState, finalTime);
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+  const auto solution = ddp.primalSolution(finalTime);
+
+  correctnessTest(ddpSettings, performanceIndex, solution);
+  EXPECT_EQ(ddp.getBackwardPassTimer().getNumTimedIntervals(), ddp.getNumIterations());
+  EXPECT_LE(ddp.getBackwardPassTimer().getLastIntervalInMilliseconds(), ddp.getBackwardPassTimer().getMaxIntervalInMilliseconds());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(DDPCorrectness, TestSLQSegmentedRollout) {
+  // settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, getNumThreads(), getSearchStrategy());
+  ddpSettings.lineSearch_.numRolloutSegments = ddpSettings.nThreads_;
+
+  // ddp
+  ocs2::SLQ ddp(ddpSettings, *rolloutPtr, *problemPtr, *operatingPointsPtr);
+
+  ddp.getReferenceManager().setTargetTrajectories(targetTrajectories);
+  ddp.run(startTime, initState, finalTime);
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+  const auto solution = ddp.primalSolution(finalTime);
+
+  correctnessTest(ddpSettings, performanceIndex, solution);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -282,6 +322,59 @@ TEST_P(DDPCorrectness, TestILQR) {
   correctnessTest(ddpSettings, performanceIndex, solution);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(DDPCorrectness, TestDDP) {
+  // settings: the dynamics is linear, therefore DDP should converge to the same solution as ILQR
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::DDP, getNumThreads(), getSearchStrategy());
+  ddpSettings.lineSearch_.hessianCorrectionStrategy = ocs2::hessian_correction::Strategy::EIGENVALUE_MODIFICATION;
+
+  // ddp
+  ocs2::ILQR ddp(ddpSettings, *rolloutPtr, *problemPtr, *operatingPointsPtr);
+
+  ddp.getReferenceManager().setTargetTrajectories(targetTrajectories);
+  ddp.run(startTime, initState, finalTime);
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+  const auto solution = ddp.primalSolution(finalTime);
+
+  correctnessTest(ddpSettings, performanceIndex, solution);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(DDPCorrectness, TestILQRParallelRiccatiScan) {
+  // settings: the parallel solution of the Riccati equations is exact, therefore no extra iterations are needed
+  auto getScanSettings = [&](size_t numThreads) {
+    auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, numThreads, getSearchStrategy());
+    ddpSettings.maxNumIterations_ = 2;
+    ddpSettings.parallelRiccatiScan_ = true;
+    return ddpSettings;
+  };
+  const auto ddpSettings = getScanSettings(3);
+
+  // ddp
+  ocs2::ILQR ddp(ddpSettings, *rolloutPtr, *problemPtr, *operatingPointsPtr);
+
+  ddp.getReferenceManager().setTargetTrajectories(targetTrajectories);
+  ddp.run(startTime, initState, finalTime);
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+  const auto solution = ddp.primalSolution(finalTime);
+
+  correctnessTest(ddpSettings, performanceIndex, solution);
+
+  // unlike the time partitioning, the solution does not depend on the number of threads
+  ocs2::ILQR otherDdp(getScanSettings(2), *rolloutPtr, *problemPtr, *operatingPointsPtr);
+  otherDdp.getReferenceManager().setTargetTrajectories(targetTrajectories);
+  otherDdp.run(startTime, initState, finalTime);
+  const auto otherSolution = otherDdp.primalSolution(finalTime);
+
+  EXPECT_NEAR(performanceIndex.merit, otherDdp.getPerformanceIndeces().merit, 1e-9);
+  EXPECT_TRUE(solution.inputTrajectory_.front().isApprox(otherSolution.inputTrajectory_.front(), 1e-9));
+  EXPECT_TRUE(solution.stateTrajectory_.back().isApprox(otherSolution.stateTrajectory_.back(), 1e-9));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -222,6 +223,35 @@ TEST_F(Exp0, ddp_moving_horizon) {
   EXPECT_NO_THROW(ddp.run(startTime, initState, finalTime));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_deadline) {
+  // ddp settings
+  constexpr size_t numThreads = 2;
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // an expired deadline: the solver performs a single iteration
+  ddp.setDeadline(std::chrono::steady_clock::now());
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_TRUE(ddp.isTerminatedByDeadline());
+  EXPECT_EQ(ddp.getNumIterations(), 1);
+  EXPECT_DOUBLE_EQ(ddp.primalSolution(finalTime).timeTrajectory_.back(), finalTime);
+
+  // the deadline only applies to a single run
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_FALSE(ddp.isTerminatedByDeadline());
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
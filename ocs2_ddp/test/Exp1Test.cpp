@@ -33,12 +33,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 
 #include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP1.h>
 
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
+#include <ocs2_ddp/search_strategy/LevenbergMarquardtStrategy.h>
 
 class Exp1 : public testing::TestWithParam<std::tuple<ocs2::search_strategy::Type, size_t>> {
  protected:
@@ -273,3 +275,103 @@ INSTANTIATE_TEST_CASE_P(Exp1Case, Exp1,
                           name += std::get<1>(info.param) == 1 ? "SINGLE_THREAD" : "MULTI_THREAD";
                           return name;
                         });
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, incremental_lq_approximation) {
+  // a fixed step rollout keeps the time stamps of the nodes between the iterations
+  auto fixedStepRolloutSettings = rolloutSettings();
+  fixedStepRolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, fixedStepRolloutSettings);
+
+  for (const auto algorithm : {ocs2::ddp::Algorithm::SLQ, ocs2::ddp::Algorithm::ILQR}) {
+    auto ddpSettings = getSettings(algorithm, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+    ddpSettings.maxNumIterations_ = 50;
+    ddpSettings.minRelCost_ = 1e-9;  // to allow more iterations with small steps
+    ddpSettings.lqReuseTolerance_ = 1e-3;
+    ddpSettings.lqReuseFirstOrderCorrection_ = true;
+
+    auto solve = [&](bool incrementalLqApproximation) {
+      ddpSettings.incrementalLqApproximation_ = incrementalLqApproximation;
+      std::unique_ptr<ocs2::GaussNewtonDDP> ddpPtr;
+      if (algorithm == ocs2::ddp::Algorithm::SLQ) {
+        ddpPtr.reset(new ocs2::SLQ(ddpSettings, rollout, problem, *initializerPtr));
+      } else {
+        ddpPtr.reset(new ocs2::ILQR(ddpSettings, rollout, problem, *initializerPtr));
+      }
+      ddpPtr->setReferenceManager(referenceManagerPtr);
+      ddpPtr->run(startTime, initState, finalTime);
+      return ddpPtr;
+    };
+
+    // reference solution which approximates all the nodes at every iteration
+    const auto referencePtr = solve(false);
+    EXPECT_EQ(referencePtr->getTotalNumReusedLqNodes(), 0);
+
+    // the trajectory barely moves in the last iteration, therefore some nodes should be reused
+    const auto ddpPtr = solve(true);
+    const auto testName = getTestName(ddpSettings);
+    EXPECT_GT(ddpPtr->getNumReusedLqNodes(), 0) << "MESSAGE: " << testName << ": no LQ approximation is reused!";
+    EXPECT_GE(ddpPtr->getTotalNumReusedLqNodes(), ddpPtr->getNumReusedLqNodes());
+    EXPECT_LT(ddpPtr->getTotalNumReusedLqNodes(), ddpPtr->getTotalNumLqNodes());
+    EXPECT_NE(ddpPtr->getBenchmarkingInfo().find("Incremental LQ approximation"), std::string::npos);
+    performanceIndexTest(ddpSettings, ddpPtr->getPerformanceIndeces());
+
+    // the reused nodes deviate at most lqReuseTolerance_ from their linearization point and they are corrected to first order
+    const auto& performanceIndex = ddpPtr->getPerformanceIndeces();
+    const auto& referencePerformanceIndex = referencePtr->getPerformanceIndeces();
+    EXPECT_NEAR(performanceIndex.cost, referencePerformanceIndex.cost, ddpSettings.lqReuseTolerance_ * ddpSettings.lqReuseTolerance_)
+        << "MESSAGE: " << testName << ": the incremental LQ approximation changes the solution!";
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, levenberg_marquardt_warm_start) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  // the zero controller with an overly optimistic expected cost, such that every step is rejected
+  ocs2::LinearController zeroController;
+  for (const auto t : {startTime, finalTime}) {
+    zeroController.timeStamp_.push_back(t);
+    zeroController.gainArray_.push_back(ocs2::matrix_t::Zero(INPUT_DIM, STATE_DIM));
+    zeroController.biasArray_.push_back(ocs2::vector_t::Zero(INPUT_DIM));
+    zeroController.deltaBiasArray_.push_back(ocs2::vector_t::Zero(INPUT_DIM));
+  }
+  constexpr ocs2::scalar_t optimisticExpectedCost = -1.0;
+
+  const auto rejectStep = [&](ocs2::LevenbergMarquardtStrategy& strategy) {
+    ocs2::search_strategy::Solution solution;
+    solution.primalSolution.controllerPtr_.reset(new ocs2::LinearController);
+    solution.performanceIndex.merit = 0.0;
+    return strategy.run({startTime, finalTime}, initState, optimisticExpectedCost, zeroController, ocs2::DualSolution(),
+                        referenceManagerPtr->getModeSchedule(), solution);
+  };
+
+  for (const bool warmStartRiccatiMultiple : {true, false}) {
+    ocs2::levenberg_marquardt::Settings settings;
+    settings.warmStartRiccatiMultiple = warmStartRiccatiMultiple;
+    ocs2::search_strategy::Settings baseSettings;
+    baseSettings.minRelCost = minRelCost;
+    auto merit = [](const ocs2::PerformanceIndex& p) { return p.cost; };
+    ocs2::LevenbergMarquardtStrategy strategy(baseSettings, settings, rollout, problem, merit);
+
+    // two rejections increase the Riccati multiple beyond its default factor
+    EXPECT_FALSE(rejectStep(strategy));
+    EXPECT_FALSE(rejectStep(strategy));
+    const auto riccatiMultiple = strategy.getRiccatiMultiple();
+    EXPECT_GT(riccatiMultiple, settings.riccatiMultipleDefaultFactor);
+
+    // with the warm start, the next run begins with this Riccati multiple, otherwise with zero
+    strategy.reset();
+    EXPECT_DOUBLE_EQ(strategy.getRiccatiMultiple(), warmStartRiccatiMultiple ? riccatiMultiple : 0.0);
+  }
+}
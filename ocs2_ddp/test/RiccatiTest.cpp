@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -34,6 +35,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h>
+#include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 class RiccatiInitializer {
  public:
@@ -104,6 +108,38 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+TEST(RiccatiTest, compareFlowMapWithDenseImplementation) {
+  constexpr int STATE_DIM = 23;
+  constexpr int INPUT_DIM = 7;
+
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  riccati_t riccatiEquation(true);
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  ri.initialize(riccatiEquation);
+
+  const ocs2::vector_t S = ocs2::vector_t::Random(ocs2::s_vector_dim(STATE_DIM));
+  const ocs2::vector_t dSdz = riccatiEquation.computeFlowMap(0.6, S);
+
+  // dense reference with full symmetric matrices
+  ocs2::matrix_t Sm;
+  ocs2::vector_t Sv;
+  ocs2::scalar_t s;
+  riccati_t::convert2Matrix(S, Sm, Sv, s);
+  const auto& modelData = ri.projectedModelDataTrajectory.front();
+  const auto& deltaQm = ri.riccatiModificationTrajectory.front().deltaQm_;
+  const auto& Am = modelData.dynamics.dfdx;
+  const auto& Bm = modelData.dynamics.dfdu;
+  const auto& Hv = modelData.dynamicsBias;
+  const ocs2::matrix_t Gm = modelData.cost.dfdux + Bm.transpose() * Sm;
+  const ocs2::vector_t Gv = modelData.cost.dfdu + Bm.transpose() * Sv;
+  const ocs2::matrix_t dSm = modelData.cost.dfdxx + deltaQm + Sm * Am + Am.transpose() * Sm - Gm.transpose() * Gm;
+  const ocs2::vector_t dSv = modelData.cost.dfdx + Sm * Hv + Am.transpose() * Sv - Gm.transpose() * Gv;
+  const ocs2::scalar_t ds = modelData.cost.f + Hv.dot(Sv) - 0.5 * Gv.dot(Gv);
+
+  EXPECT_LE((dSdz - riccati_t::convert2Vector(dSm, dSv, ds)).array().abs().maxCoeff(), 1e-9);
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
@@ -155,3 +191,102 @@ TEST(RiccatiTest, testFlattenAndUnflatten) {
   ASSERT_TRUE(Sv.isApprox(Sv_out));
   ASSERT_TRUE(Sm.isApprox(Sm_out));
 }
+
+TEST(RiccatiTest, discreteTimeAssociativeScan) {
+  constexpr int stateDim = 6;
+  constexpr int inputDim = 3;
+  constexpr int N = 9;
+  constexpr int preEventIndex = 4;
+
+  auto createModelData = [&]() {
+    ocs2::ModelData modelData;
+    modelData.stateDim = stateDim;
+    modelData.inputDim = inputDim;
+    modelData.dynamicsBias = ocs2::vector_t::Random(stateDim);
+    modelData.dynamics.dfdx = ocs2::matrix_t::Random(stateDim, stateDim);
+    modelData.dynamics.dfdu = ocs2::matrix_t::Random(stateDim, inputDim);
+    modelData.cost.f = ocs2::vector_t::Random(1)(0);
+    modelData.cost.dfdx = ocs2::vector_t::Random(stateDim);
+    modelData.cost.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(stateDim);
+    modelData.cost.dfdu = ocs2::vector_t::Random(inputDim);
+    modelData.cost.dfduu = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(inputDim);
+    modelData.cost.dfdux = 0.1 * ocs2::matrix_t::Random(inputDim, stateDim);
+    return modelData;
+  };
+
+  std::vector<ocs2::ModelData> modelDataTrajectory(N);
+  std::generate(modelDataTrajectory.begin(), modelDataTrajectory.end(), createModelData);
+  const ocs2::matrix_t deltaQm = 1e-3 * ocs2::matrix_t::Identity(stateDim, stateDim);
+
+  ocs2::ScalarFunctionQuadraticApproximation finalValueFunction;
+  finalValueFunction.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(stateDim);
+  finalValueFunction.dfdx = ocs2::vector_t::Random(stateDim);
+  finalValueFunction.f = 0.0;
+
+  // sequential solution
+  ocs2::DiscreteTimeRiccatiEquations riccatiEquations(false, false);
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> valueFunctionTrajectory(N);
+  valueFunctionTrajectory.back() = finalValueFunction;
+  for (int k = N - 2; k >= 0; k--) {
+    const auto& modelData = modelDataTrajectory[k];
+    const auto& valueFunctionNext = valueFunctionTrajectory[k + 1];
+    auto& valueFunction = valueFunctionTrajectory[k];
+    if (k == preEventIndex) {
+      std::tie(valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f) =
+          ocs2::riccatiTransversalityConditions(modelData, valueFunctionNext.dfdxx, valueFunctionNext.dfdx, valueFunctionNext.f);
+      continue;
+    }
+
+    // project the input such that the Hessian of the Hamiltonian becomes identity
+    ocs2::riccati_modification::Data riccatiModification;
+    const auto& Bm = modelData.dynamics.dfdu;
+    const ocs2::matrix_t Hm = modelData.cost.dfduu + Bm.transpose() * valueFunctionNext.dfdxx * Bm;
+    ocs2::LinearAlgebra::computeInverseMatrixUUT(Hm, riccatiModification.constraintNullProjector_);
+    const auto& Qu = riccatiModification.constraintNullProjector_;
+    riccatiModification.deltaQm_ = deltaQm;
+    riccatiModification.deltaGm_.setZero(inputDim, stateDim);
+    riccatiModification.deltaGv_.setZero(inputDim);
+
+    auto projectedModelData = modelData;
+    projectedModelData.dynamics.dfdu = modelData.dynamics.dfdu * Qu;
+    projectedModelData.cost.dfdu = Qu.transpose() * modelData.cost.dfdu;
+    projectedModelData.cost.dfduu = Qu.transpose() * modelData.cost.dfduu * Qu;
+    projectedModelData.cost.dfdux = Qu.transpose() * modelData.cost.dfdux;
+
+    ocs2::matrix_t projectedKm;
+    ocs2::vector_t projectedLv;
+    riccatiEquations.computeMap(projectedModelData, riccatiModification, valueFunctionNext.dfdxx, valueFunctionNext.dfdx,
+                                valueFunctionNext.f, projectedKm, projectedLv, valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f);
+  }
+
+  // elements of the scan
+  std::vector<ocs2::riccati_scan::Element> elements(N);
+  for (int k = 0; k < N - 1; k++) {
+    if (k == preEventIndex) {
+      ocs2::riccati_scan::setJumpElement(modelDataTrajectory[k], elements[k]);
+    } else {
+      ocs2::riccati_scan::setStageElement(modelDataTrajectory[k], deltaQm, elements[k]);
+    }
+  }
+  ocs2::riccati_scan::setFinalElement(finalValueFunction, elements.back());
+
+  // the suffix products are the value functions
+  ocs2::riccati_scan::Element suffixProduct = elements.back();
+  for (int k = N - 2; k >= 0; k--) {
+    ocs2::riccati_scan::Element result;
+    ocs2::riccati_scan::combine(elements[k], suffixProduct, result);
+    suffixProduct = std::move(result);
+    EXPECT_TRUE(suffixProduct.J.isApprox(valueFunctionTrajectory[k].dfdxx, 1e-9)) << "at node " << k;
+    EXPECT_TRUE((-suffixProduct.eta).isApprox(valueFunctionTrajectory[k].dfdx, 1e-9)) << "at node " << k;
+  }
+
+  // the product is associative
+  ocs2::riccati_scan::Element prefixProduct = elements.front();
+  for (int k = 1; k < N; k++) {
+    ocs2::riccati_scan::Element result;
+    ocs2::riccati_scan::combine(prefixProduct, elements[k], result);
+    prefixProduct = std::move(result);
+  }
+  EXPECT_TRUE(prefixProduct.J.isApprox(valueFunctionTrajectory.front().dfdxx, 1e-9));
+  EXPECT_TRUE((-prefixProduct.eta).isApprox(valueFunctionTrajectory.front().dfdx, 1e-9));
+}
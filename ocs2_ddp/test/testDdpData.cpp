@@ -0,0 +1,307 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/test/EXP0.h>
+
+#include <ocs2_ddp/DDP_Data.h>
+#include <ocs2_ddp/ILQR.h>
+
+using namespace ocs2;
+
+/*
+ * Counts the heap allocations of the test binary. Both Eigen and the default operator new allocate through malloc, therefore it is
+ * interposed here. This relies on glibc which exports the original implementation as __libc_malloc. The allocations of a thread are
+ * not counted while it is inside an UncountedScope.
+ */
+#ifdef __GLIBC__
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+std::atomic_size_t numMallocCalls{0};
+thread_local int numUncountedScopes = 0;
+}  // unnamed namespace
+
+extern "C" void* malloc(size_t size) {
+  if (numUncountedScopes == 0) {
+    ++numMallocCalls;
+  }
+  return __libc_malloc(size);
+}
+#endif
+
+namespace {
+
+struct UncountedScope {
+#ifdef __GLIBC__
+  UncountedScope() { ++numUncountedScopes; }
+  ~UncountedScope() { --numUncountedScopes; }
+#endif
+};
+
+constexpr int stateDim = 6;
+constexpr int inputDim = 3;
+constexpr int constraintDim = 2;
+
+void setModelData(ModelData& modelData) {
+  modelData.stateDim = stateDim;
+  modelData.inputDim = inputDim;
+  modelData.dynamicsBias.setZero(stateDim);
+  modelData.dynamics.setZero(stateDim, stateDim, inputDim);
+  modelData.cost.setZero(stateDim, inputDim);
+  modelData.stateInputEqConstraint.setZero(constraintDim, stateDim, inputDim);
+}
+
+void setRiccatiModification(riccati_modification::Data& riccatiModification) {
+  riccatiModification.deltaQm_.setZero(stateDim, stateDim);
+  riccatiModification.deltaGm_.setZero(inputDim - constraintDim, stateDim);
+  riccatiModification.deltaGv_.setZero(inputDim - constraintDim);
+  riccatiModification.hamiltonianHessian_.setZero(inputDim, inputDim);
+  riccatiModification.constraintRangeProjector_.setZero(inputDim, constraintDim);
+  riccatiModification.constraintNullProjector_.setZero(inputDim, inputDim - constraintDim);
+}
+
+/** Resizes the containers to the given number of nodes and fills them, similar to an iteration of DDP. */
+void fillContainers(size_t numNodes, size_t numEvents, PrimalDataContainer& primalData, DualDataContainer& dualData) {
+  primalData.resizeModelDataTrajectory(numNodes);
+  primalData.resizeModelDataEventTimes(numEvents);
+  dualData.resizeProjectedModelData(numNodes);
+  dualData.resizeValueFunction(numNodes);
+
+  for (size_t i = 0; i < numNodes; i++) {
+    setModelData(primalData.modelDataTrajectory[i]);
+    setModelData(dualData.projectedModelDataTrajectory[i]);
+    setRiccatiModification(dualData.riccatiModificationTrajectory[i]);
+    dualData.valueFunctionTrajectory[i].setZero(stateDim, 0);
+  }
+  for (auto& modelData : primalData.modelDataEventTimes) {
+    setModelData(modelData);
+  }
+}
+
+}  // unnamed namespace
+
+TEST(testDdpData, resizeTrajectory) {
+  std::vector<vector_t> trajectory(3, vector_t::Ones(2));
+  std::vector<vector_t> spare;
+
+  resizeTrajectory(1, trajectory, spare);
+  EXPECT_EQ(trajectory.size(), 1);
+  EXPECT_EQ(spare.size(), 2);
+
+  // the elements are recycled with their content
+  resizeTrajectory(4, trajectory, spare);
+  EXPECT_EQ(trajectory.size(), 4);
+  EXPECT_TRUE(spare.empty());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(trajectory[i].isApprox(vector_t::Ones(2)));
+  }
+  EXPECT_EQ(trajectory.back().size(), 0);
+}
+
+TEST(testDdpData, allocationFreeReuse) {
+#ifndef __GLIBC__
+  GTEST_SKIP() << "Counting the heap allocations requires glibc.";
+#else
+  constexpr size_t maxNumNodes = 100;
+  constexpr size_t maxNumEvents = 3;
+
+  PrimalDataContainer primalData, cachedPrimalData;
+  DualDataContainer dualData, cachedDualData;
+
+  // sanity check of the counter: a plain std::vector releases the memory of its elements on clear()
+  std::vector<ModelData> modelDataTrajectory(maxNumNodes);
+  std::for_each(modelDataTrajectory.begin(), modelDataTrajectory.end(), setModelData);
+  modelDataTrajectory.clear();
+  const size_t numMallocCallsBeforePlainVector = numMallocCalls;
+  modelDataTrajectory.resize(maxNumNodes);
+  std::for_each(modelDataTrajectory.begin(), modelDataTrajectory.end(), setModelData);
+  EXPECT_GT(numMallocCalls - numMallocCallsBeforePlainVector, maxNumNodes);
+
+  // similar to the iterations and MPC cycles of DDP: the containers are filled, swapped with the cached ones, and cleared
+  auto iterate = [&](size_t numNodes, size_t numEvents) {
+    fillContainers(numNodes, numEvents, primalData, dualData);
+    primalData.swap(cachedPrimalData);
+    dualData.swap(cachedDualData);
+    primalData.clear();
+    dualData.clear();
+  };
+
+  // warm-up up to the high-water mark, both the nominal and the cached containers should be filled and cleared once
+  for (int i = 0; i < 3; i++) {
+    iterate(maxNumNodes, maxNumEvents);
+  }
+
+  // in the steady state, the number of nodes varies below the high-water mark
+  const size_t numMallocCallsBefore = numMallocCalls;
+  for (const size_t numNodes : {maxNumNodes - 1, maxNumNodes - 5, maxNumNodes, size_t(0), maxNumNodes - 2}) {
+    iterate(numNodes, numNodes % (maxNumEvents + 1));
+  }
+  const size_t numMallocCallsAfter = numMallocCalls;
+
+  EXPECT_EQ(numMallocCallsAfter - numMallocCallsBefore, 0);
+#endif
+}
+
+namespace {
+
+/** Wraps the dynamics of a problem such that the allocations of its by-value interface are not counted. */
+class UncountedDynamics final : public SystemDynamicsBase {
+ public:
+  explicit UncountedDynamics(std::unique_ptr<SystemDynamicsBase> dynamicsPtr) : dynamicsPtr_(std::move(dynamicsPtr)) {}
+  ~UncountedDynamics() override = default;
+  UncountedDynamics* clone() const override { return new UncountedDynamics(std::unique_ptr<SystemDynamicsBase>(dynamicsPtr_->clone())); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) override {
+    UncountedScope uncountedScope;
+    return dynamicsPtr_->computeFlowMap(t, x, u, preComp);
+  }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                        const PreComputation& preComp) override {
+    UncountedScope uncountedScope;
+    return dynamicsPtr_->linearApproximation(t, x, u, preComp);
+  }
+
+ private:
+  std::unique_ptr<SystemDynamicsBase> dynamicsPtr_;
+};
+
+/** Wraps the cost of a problem such that the allocations of its by-value interface are not counted. */
+class UncountedCost final : public StateInputCostCollection {
+ public:
+  UncountedCost() = default;
+  ~UncountedCost() override = default;
+  UncountedCost* clone() const override { return new UncountedCost(*this); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    UncountedScope uncountedScope;
+    return StateInputCostCollection::getValue(time, state, input, targetTrajectories, preComp);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    UncountedScope uncountedScope;
+    return StateInputCostCollection::getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
+ private:
+  UncountedCost(const UncountedCost& other) = default;
+};
+
+/** Records the number of allocations of the intermediate LQ approximation of each iteration. */
+class AllocationCountingILQR final : public ILQR {
+ public:
+  using ILQR::ILQR;
+  ~AllocationCountingILQR() override = default;
+
+  std::vector<size_t> numMallocCallsPerIteration;
+  std::vector<size_t> numNodesPerIteration;
+
+ protected:
+  void approximateIntermediateLQ(DualDataContainer& dualData, PrimalDataContainer& primalData) override {
+    const size_t numMallocCallsBefore = numMallocCalls;
+    ILQR::approximateIntermediateLQ(dualData, primalData);
+    numMallocCallsPerIteration.push_back(numMallocCalls - numMallocCallsBefore);
+    numNodesPerIteration.push_back(primalData.primalSolution.timeTrajectory_.size());
+  }
+};
+
+}  // unnamed namespace
+
+class testIntermediateLQAllocations : public testing::TestWithParam<IntegratorType> {};
+
+TEST_P(testIntermediateLQAllocations, ilqrSteadyState) {
+#ifndef __GLIBC__
+  GTEST_SKIP() << "Counting the heap allocations requires glibc.";
+#else
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 2.0;
+  const vector_t initState = (vector_t(2) << 0.0, 2.0).finished();
+
+  auto referenceManagerPtr = getExp0ReferenceManager({0.1897}, {0, 1});
+  auto problem = createExp0Problem(referenceManagerPtr);
+  problem.dynamicsPtr.reset(new UncountedDynamics(std::move(problem.dynamicsPtr)));
+  std::unique_ptr<StateInputCostCollection> costPtr(new UncountedCost);
+  costPtr->add("cost", std::unique_ptr<StateInputCost>(new EXP0_Cost));
+  problem.costPtr = std::move(costPtr);
+
+  // a fixed step rollout keeps the number of nodes constant over the iterations
+  rollout::Settings rolloutSettings;
+  rolloutSettings.integratorType = IntegratorType::RK4;
+  rolloutSettings.timeStep = 1e-2;
+  TimeTriggeredRollout rollout(*problem.dynamicsPtr, rolloutSettings);
+  DefaultInitializer initializer(1);
+
+  ddp::Settings ddpSettings;
+  ddpSettings.algorithm_ = ddp::Algorithm::ILQR;
+  ddpSettings.nThreads_ = 1;
+  ddpSettings.displayInfo_ = false;
+  ddpSettings.displayShortSummary_ = false;
+  ddpSettings.timeStep_ = 1e-2;
+  ddpSettings.backwardPassIntegratorType_ = GetParam();
+  ddpSettings.maxNumIterations_ = 5;
+  ddpSettings.minRelCost_ = 0.0;
+  ddpSettings.strategy_ = search_strategy::Type::LINE_SEARCH;
+  ddpSettings.checkNumericalStability_ = false;  // the checks format their error messages
+
+  AllocationCountingILQR ilqr(ddpSettings, rollout, problem, initializer);
+  ilqr.setReferenceManager(referenceManagerPtr);
+
+  // warm-up: the first MPC cycles fill both the nominal and the cached containers
+  ilqr.run(initTime, initState, finalTime);
+  ilqr.run(initTime, initState, finalTime);
+  ilqr.numMallocCallsPerIteration.clear();
+  ilqr.numNodesPerIteration.clear();
+
+  // steady state: only a per call constant is allocated, e.g. the task of the thread pool, but nothing per node
+  constexpr size_t maxNumMallocCallsPerCall = 10;
+  ilqr.run(initTime, initState, finalTime);
+  ASSERT_FALSE(ilqr.numMallocCallsPerIteration.empty());
+  for (size_t i = 0; i < ilqr.numMallocCallsPerIteration.size(); i++) {
+    EXPECT_GT(ilqr.numNodesPerIteration[i], 10 * maxNumMallocCallsPerCall);
+    EXPECT_LE(ilqr.numMallocCallsPerIteration[i], maxNumMallocCallsPerCall) << "iteration: " << i;
+  }
+#endif
+}
+
+INSTANTIATE_TEST_CASE_P(testIntermediateLQAllocationsCase, testIntermediateLQAllocations,
+                        testing::ValuesIn({IntegratorType::EULER, IntegratorType::RK4}),
+                        [](const testing::TestParamInfo<testIntermediateLQAllocations::ParamType>& info) {
+                          return integrator_type::toString(info.param);
+                        });
@@ -99,3 +99,56 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+TEST(correctIntermediateLQ, affineModel) {
+  constexpr size_t stateDim = 3;
+  constexpr size_t inputDim = 2;
+  const vector_t state0 = vector_t::Random(stateDim);
+  const vector_t input0 = vector_t::Random(inputDim);
+  const vector_t deltaState = vector_t::Random(stateDim);
+  const vector_t deltaInput = vector_t::Random(inputDim);
+
+  // quadratic cost, affine dynamics and constraints: the first-order correction is exact
+  ScalarFunctionQuadraticApproximation cost(stateDim, inputDim);
+  cost.f = 1.0;
+  cost.dfdx.setRandom();
+  cost.dfdu.setRandom();
+  cost.dfdxx.setRandom();
+  cost.dfdxx = (cost.dfdxx + cost.dfdxx.transpose()).eval();
+  cost.dfduu.setRandom();
+  cost.dfduu = (cost.dfduu + cost.dfduu.transpose()).eval();
+  cost.dfdux.setRandom();
+  VectorFunctionLinearApproximation dynamics(stateDim, stateDim, inputDim);
+  dynamics.f.setRandom();
+  dynamics.dfdx.setRandom();
+  dynamics.dfdu.setRandom();
+  VectorFunctionLinearApproximation constraint(1, stateDim, inputDim);
+  constraint.f.setRandom();
+  constraint.dfdx.setRandom();
+  constraint.dfdu.setRandom();
+  auto approximate = [&](const vector_t& x, const vector_t& u) {
+    ModelData modelData;
+    modelData.stateDim = stateDim;
+    modelData.inputDim = inputDim;
+    modelData.cost = cost;
+    modelData.cost.f += cost.dfdx.dot(x) + cost.dfdu.dot(u) + 0.5 * x.dot(cost.dfdxx * x) + 0.5 * u.dot(cost.dfduu * u) +
+                        u.dot(cost.dfdux * x);
+    modelData.cost.dfdx += cost.dfdxx * x + cost.dfdux.transpose() * u;
+    modelData.cost.dfdu += cost.dfduu * u + cost.dfdux * x;
+    modelData.dynamics = dynamics;
+    modelData.dynamics.f += dynamics.dfdx * x + dynamics.dfdu * u;
+    modelData.stateInputEqConstraint = constraint;
+    modelData.stateInputEqConstraint.f += constraint.dfdx * x + constraint.dfdu * u;
+    return modelData;
+  };
+
+  auto corrected = approximate(state0, input0);
+  correctIntermediateLQ(deltaState, deltaInput, corrected);
+  const auto expected = approximate(state0 + deltaState, input0 + deltaInput);
+
+  EXPECT_NEAR(corrected.cost.f, expected.cost.f, 1e-9);
+  EXPECT_TRUE(corrected.cost.dfdx.isApprox(expected.cost.dfdx));
+  EXPECT_TRUE(corrected.cost.dfdu.isApprox(expected.cost.dfdu));
+  EXPECT_TRUE(corrected.dynamics.f.isApprox(expected.dynamics.f));
+  EXPECT_TRUE(corrected.stateInputEqConstraint.f.isApprox(expected.stateInputEqConstraint.f));
+}
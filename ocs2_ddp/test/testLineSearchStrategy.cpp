@@ -0,0 +1,225 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include <ocs2_ddp/search_strategy/LineSearchStrategy.h>
+
+namespace {
+
+/**
+ * The integrator x' = u. The flow map is slow for the inputs in (0, slowInputBound), and the number of these evaluations is counted.
+ * For the inputs beyond slowInputBound, it waits until a slow evaluation has started such that the rollouts overlap.
+ */
+class IntegratorDynamics final : public ocs2::LinearSystemDynamics {
+ public:
+  IntegratorDynamics(ocs2::scalar_t slowInputBound, std::shared_ptr<std::atomic_size_t> numSlowEvaluationsPtr)
+      : LinearSystemDynamics(ocs2::matrix_t::Zero(1, 1), ocs2::matrix_t::Ones(1, 1)),
+        slowInputBound_(slowInputBound),
+        numSlowEvaluationsPtr_(std::move(numSlowEvaluationsPtr)) {}
+  ~IntegratorDynamics() override = default;
+  IntegratorDynamics* clone() const override { return new IntegratorDynamics(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                const ocs2::PreComputation& preComp) override {
+    if (0.0 < u(0) && u(0) < slowInputBound_) {
+      ++(*numSlowEvaluationsPtr_);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } else if (0.0 < slowInputBound_ && slowInputBound_ <= u(0)) {
+      for (int i = 0; i < 1000 && *numSlowEvaluationsPtr_ == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    return LinearSystemDynamics::computeFlowMap(t, x, u, preComp);
+  }
+
+ private:
+  IntegratorDynamics(const IntegratorDynamics& other) = default;
+
+  ocs2::scalar_t slowInputBound_;
+  std::shared_ptr<std::atomic_size_t> numSlowEvaluationsPtr_;
+};
+
+/** Steers the integrator from zero to one. The search direction of the controller is u = 1, which is accepted with the full step. */
+class LineSearchStrategyTest : public testing::Test {
+ protected:
+  static constexpr size_t numThreads = 3;
+  static constexpr ocs2::scalar_t initTime = 0.0;
+  static constexpr ocs2::scalar_t finalTime = 1.0;
+
+  LineSearchStrategyTest() : targetTrajectories({initTime}, {ocs2::vector_t::Ones(1)}, {ocs2::vector_t::Zero(1)}) {
+    problem.costPtr->add("cost", std::unique_ptr<ocs2::StateInputCost>(new ocs2::QuadraticStateInputCost(
+                                     ocs2::matrix_t::Ones(1, 1), 0.01 * ocs2::matrix_t::Ones(1, 1))));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+
+    // the controller has a feedback such that the defects between the segments of a rollout decay
+    for (int k = 0; k <= 10; k++) {
+      controller.timeStamp_.push_back(initTime + 0.1 * k * (finalTime - initTime));
+      controller.gainArray_.push_back(-ocs2::matrix_t::Ones(1, 1));
+      controller.biasArray_.push_back(ocs2::vector_t::Zero(1));
+      controller.deltaBiasArray_.push_back(ocs2::vector_t::Ones(1));
+    }
+
+    // without feedback the input is the step length, so that the whole rollout of a step length in (0, slowStepLength) is slow
+    openLoopController = controller;
+    for (auto& gain : openLoopController.gainArray_) {
+      gain.setZero();
+    }
+  }
+
+  /** A line search strategy together with the resources it refers to */
+  struct Strategy {
+    std::unique_ptr<ocs2::ThreadPool> threadPoolPtr;
+    std::vector<std::unique_ptr<ocs2::RolloutBase>> rolloutPtrs;
+    std::vector<ocs2::OptimalControlProblem> problems;
+    std::unique_ptr<ocs2::LineSearchStrategy> lineSearchPtr;
+  };
+
+  /** Creates a line search strategy whose rollouts are slow for the step lengths in (0, slowStepLength) */
+  Strategy createStrategy(size_t numRolloutSegments, size_t nThreads, ocs2::scalar_t slowStepLength = 0.0) const {
+    ocs2::rollout::Settings rolloutSettings;
+    rolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+    rolloutSettings.timeStep = 1e-2;
+    const IntegratorDynamics dynamics(slowStepLength, numSlowEvaluationsPtr);
+
+    Strategy strategy;
+    strategy.threadPoolPtr.reset(new ocs2::ThreadPool(nThreads - 1));
+    strategy.problems.reserve(nThreads);
+    std::vector<std::reference_wrapper<ocs2::RolloutBase>> rolloutRefs;
+    std::vector<std::reference_wrapper<ocs2::OptimalControlProblem>> problemRefs;
+    for (size_t i = 0; i < nThreads; i++) {
+      strategy.rolloutPtrs.emplace_back(new ocs2::TimeTriggeredRollout(dynamics, rolloutSettings));
+      strategy.problems.push_back(problem);
+      rolloutRefs.emplace_back(*strategy.rolloutPtrs.back());
+      problemRefs.emplace_back(strategy.problems.back());
+    }
+
+    ocs2::line_search::Settings settings;
+    settings.numRolloutSegments = numRolloutSegments;
+    settings.minStepLength = 1e-2;
+    auto merit = [](const ocs2::PerformanceIndex& p) { return p.cost; };
+    strategy.lineSearchPtr.reset(new ocs2::LineSearchStrategy(ocs2::search_strategy::Settings(), settings, *strategy.threadPoolPtr,
+                                                              std::move(rolloutRefs), std::move(problemRefs), merit));
+    return strategy;
+  }
+
+  ocs2::search_strategy::Solution search(Strategy& strategy) const { return search(strategy, controller); }
+
+  ocs2::search_strategy::Solution search(Strategy& strategy, const ocs2::LinearController& unoptimizedController) const {
+    ocs2::search_strategy::Solution solution;
+    solution.primalSolution.controllerPtr_.reset(new ocs2::LinearController);
+    strategy.lineSearchPtr->run({initTime, finalTime}, ocs2::vector_t::Zero(1), 0.0, unoptimizedController, ocs2::DualSolution(),
+                                ocs2::ModeSchedule(), solution);
+    return solution;
+  }
+
+  static void expectSameSolution(const ocs2::search_strategy::Solution& lhs, const ocs2::search_strategy::Solution& rhs,
+                                 ocs2::scalar_t tol) {
+    EXPECT_NEAR(lhs.performanceIndex.merit, rhs.performanceIndex.merit, tol);
+    ASSERT_EQ(lhs.primalSolution.timeTrajectory_.size(), rhs.primalSolution.timeTrajectory_.size());
+    for (size_t k = 0; k < lhs.primalSolution.timeTrajectory_.size(); k++) {
+      EXPECT_NEAR(lhs.primalSolution.timeTrajectory_[k], rhs.primalSolution.timeTrajectory_[k], 1e-12);
+      EXPECT_TRUE(lhs.primalSolution.stateTrajectory_[k].isApprox(rhs.primalSolution.stateTrajectory_[k], tol)) << "node " << k;
+      EXPECT_TRUE(lhs.primalSolution.inputTrajectory_[k].isApprox(rhs.primalSolution.inputTrajectory_[k], tol)) << "node " << k;
+    }
+  }
+
+  ocs2::TargetTrajectories targetTrajectories;
+  ocs2::OptimalControlProblem problem;
+  ocs2::LinearController controller;
+  ocs2::LinearController openLoopController;
+  std::shared_ptr<std::atomic_size_t> numSlowEvaluationsPtr = std::make_shared<std::atomic_size_t>(0);
+};
+
+constexpr size_t LineSearchStrategyTest::numThreads;
+constexpr ocs2::scalar_t LineSearchStrategyTest::initTime;
+constexpr ocs2::scalar_t LineSearchStrategyTest::finalTime;
+
+}  // unnamed namespace
+
+TEST_F(LineSearchStrategyTest, segmentedRollout) {
+  auto singleShooting = createStrategy(1, numThreads);
+  const auto singleShootingSolution = search(singleShooting);
+  EXPECT_EQ(singleShooting.lineSearchPtr->getNumSegmentedRollouts(), 0);
+
+  // the first search segments the rollouts of the step lengths other than zero, the second one segments all rollouts
+  auto segmented = createStrategy(numThreads, numThreads);
+  const auto firstSolution = search(segmented);
+  const auto numSegmentedRollouts = segmented.lineSearchPtr->getNumSegmentedRollouts();
+  EXPECT_GT(numSegmentedRollouts, 0);
+  expectSameSolution(firstSolution, singleShootingSolution, 1e-6);
+
+  const auto secondSolution = search(segmented);
+  EXPECT_GE(segmented.lineSearchPtr->getNumSegmentedRollouts(), numSegmentedRollouts + 2);
+  expectSameSolution(secondSolution, singleShootingSolution, 1e-6);
+}
+
+TEST_F(LineSearchStrategyTest, cancelSmallerStepLengths) {
+  auto serial = createStrategy(1, 1);
+  const auto serialSolution = search(serial, openLoopController);
+
+  // the full step is accepted while the slow rollouts of the smaller step lengths are still running
+  auto concurrent = createStrategy(1, numThreads, 0.75);
+  *numSlowEvaluationsPtr = 0;
+  const auto concurrentSolution = search(concurrent, openLoopController);
+  expectSameSolution(concurrentSolution, serialSolution, 1e-12);
+
+  // a complete rollout of a smaller step length evaluates the flow map 4 times per RK4 step
+  const size_t numEvaluationsPerRollout = 4 * 100;
+  EXPECT_GT(numSlowEvaluationsPtr->load(), 0);
+  EXPECT_LT(numSlowEvaluationsPtr->load(), numEvaluationsPerRollout);
+}
+
+TEST_F(LineSearchStrategyTest, concurrentSegmentedStepLengths) {
+  auto serial = createStrategy(1, 1);
+  const auto serialSolution = search(serial, openLoopController);
+
+  // two groups of two rollout instances: the full step is accepted while the segments of the smaller step lengths are still running
+  auto segmented = createStrategy(2, 4, 0.75);
+  *numSlowEvaluationsPtr = 0;
+  const auto segmentedSolution = search(segmented, openLoopController);
+  expectSameSolution(segmentedSolution, serialSolution, 1e-6);
+  EXPECT_GT(segmented.lineSearchPtr->getNumSegmentedRollouts(), 0);
+
+  const size_t numEvaluationsPerRollout = 4 * 100;
+  EXPECT_GT(numSlowEvaluationsPtr->load(), 0);
+  EXPECT_LT(numSlowEvaluationsPtr->load(), numEvaluationsPerRollout);
+}
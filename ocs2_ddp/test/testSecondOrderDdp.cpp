@@ -0,0 +1,174 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cmath>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include <ocs2_ddp/ILQR.h>
+
+namespace {
+
+/** The scalar system x' = -a * sin(x) + u whose flow map has the Hessian a * sin(x) with respect to the state. */
+class SineDynamics final : public ocs2::SystemDynamicsBase {
+ public:
+  explicit SineDynamics(ocs2::scalar_t a) : a_(a) {}
+  ~SineDynamics() override = default;
+  SineDynamics* clone() const override { return new SineDynamics(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    return -a_ * x.array().sin().matrix() + u;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx = (-a_ * x.array().cos()).matrix().asDiagonal();
+    approximation.dfdu = ocs2::matrix_t::Identity(1, 1);
+    return approximation;
+  }
+
+  ocs2::ScalarFunctionQuadraticApproximation flowMapWeightedHessian(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                                    const ocs2::vector_t& w, const ocs2::PreComputation&) override {
+    auto hessian = ocs2::ScalarFunctionQuadraticApproximation::Zero(1, 1);
+    hessian.f = -w.dot(a_ * x.array().sin().matrix());
+    hessian.dfdxx = (a_ * w.array() * x.array().sin()).matrix().asDiagonal();
+    return hessian;
+  }
+
+ private:
+  ocs2::scalar_t a_;
+};
+
+/**
+ * Steers the sine system to the origin with expensive inputs. Neither the costate nor the curvature of the flow map vanishes along the
+ * optimal trajectory, hence the second-order terms of the dynamics contribute considerably to the Hessian of the value function.
+ */
+class SecondOrderDdpTest : public testing::Test {
+ protected:
+  static constexpr ocs2::scalar_t initTime = 0.0;
+  static constexpr ocs2::scalar_t finalTime = 1.0;
+
+  SecondOrderDdpTest() : targetTrajectories({initTime}, {ocs2::vector_t::Zero(1)}, {ocs2::vector_t::Zero(1)}) {
+    problem.dynamicsPtr.reset(new SineDynamics(2.0));
+    problem.costPtr->add("cost", std::unique_ptr<ocs2::StateInputCost>(new ocs2::QuadraticStateInputCost(
+                                     0.1 * ocs2::matrix_t::Ones(1, 1), 10.0 * ocs2::matrix_t::Ones(1, 1))));
+    problem.finalCostPtr->add("finalCost",
+                              std::unique_ptr<ocs2::StateCost>(new ocs2::QuadraticStateCost(10.0 * ocs2::matrix_t::Ones(1, 1))));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+
+    ocs2::rollout::Settings rolloutSettings;
+    rolloutSettings.integratorType = ocs2::IntegratorType::RK4;
+    rolloutSettings.timeStep = 1e-3;
+    rolloutPtr.reset(new ocs2::TimeTriggeredRollout(*problem.dynamicsPtr, rolloutSettings));
+  }
+
+  ocs2::ddp::Settings getSettings(ocs2::ddp::Algorithm algorithm) const {
+    ocs2::ddp::Settings ddpSettings;
+    ddpSettings.algorithm_ = algorithm;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    ddpSettings.nThreads_ = 1;
+    ddpSettings.maxNumIterations_ = 100;
+    ddpSettings.minRelCost_ = 1e-12;
+    ddpSettings.timeStep_ = 1e-3;
+    ddpSettings.backwardPassIntegratorType_ = ocs2::IntegratorType::RK4;
+    ddpSettings.lineSearch_.minStepLength = 1e-4;
+    ddpSettings.lineSearch_.hessianCorrectionStrategy = ocs2::hessian_correction::Strategy::EIGENVALUE_MODIFICATION;
+    return ddpSettings;
+  }
+
+  struct Result {
+    ocs2::scalar_t cost;
+    ocs2::scalar_t valueFunctionHessian;
+    size_t numIterations;
+  };
+
+  /** Solves the problem from the given initial state */
+  Result solve(ocs2::ddp::Algorithm algorithm, ocs2::scalar_t initState) const {
+    const ocs2::DefaultInitializer initializer(1);
+    ocs2::ILQR ilqr(getSettings(algorithm), *rolloutPtr, problem, initializer);
+    ilqr.getReferenceManager().setTargetTrajectories(targetTrajectories);
+    const ocs2::vector_t x0 = initState * ocs2::vector_t::Ones(1);
+    ilqr.run(initTime, x0, finalTime);
+    return {ilqr.getPerformanceIndeces().cost, ilqr.getValueFunction(initTime, x0).dfdxx(0, 0), ilqr.getNumIterations()};
+  }
+
+  ocs2::TargetTrajectories targetTrajectories;
+  ocs2::OptimalControlProblem problem;
+  std::unique_ptr<ocs2::RolloutBase> rolloutPtr;
+};
+
+constexpr ocs2::scalar_t SecondOrderDdpTest::initTime;
+constexpr ocs2::scalar_t SecondOrderDdpTest::finalTime;
+
+}  // unnamed namespace
+
+TEST_F(SecondOrderDdpTest, valueFunctionHessian) {
+  const ocs2::scalar_t x0 = 1.5;
+  const auto ddp = solve(ocs2::ddp::Algorithm::DDP, x0);
+  const auto ilqr = solve(ocs2::ddp::Algorithm::ILQR, x0);
+  EXPECT_NEAR(ddp.cost, ilqr.cost, 1e-6);
+  EXPECT_LE(ddp.numIterations, ilqr.numIterations);
+
+  // the Hessian of the optimal cost with respect to the initial state by central finite differences
+  const ocs2::scalar_t h = 1e-2;
+  const auto costMinus = solve(ocs2::ddp::Algorithm::DDP, x0 - h).cost;
+  const auto costPlus = solve(ocs2::ddp::Algorithm::DDP, x0 + h).cost;
+  const auto finiteDifferenceHessian = (costPlus - 2.0 * ddp.cost + costMinus) / (h * h);
+
+  // DDP recovers the exact Hessian of the value function, while the Gauss-Newton Hessian of ILQR misses the curvature of the dynamics
+  EXPECT_NEAR(ddp.valueFunctionHessian, finiteDifferenceHessian, 1e-2 * finiteDifferenceHessian);
+  EXPECT_GT(std::abs(ilqr.valueFunctionHessian - finiteDifferenceHessian), 0.25 * finiteDifferenceHessian);
+}
+
+TEST_F(SecondOrderDdpTest, invalidSettings) {
+  const ocs2::DefaultInitializer initializer(1);
+
+  auto diagonalShift = getSettings(ocs2::ddp::Algorithm::DDP);
+  diagonalShift.lineSearch_.hessianCorrectionStrategy = ocs2::hessian_correction::Strategy::DIAGONAL_SHIFT;
+  EXPECT_THROW(ocs2::ILQR(diagonalShift, *rolloutPtr, problem, initializer), std::runtime_error);
+
+  auto incremental = getSettings(ocs2::ddp::Algorithm::DDP);
+  incremental.incrementalLqApproximation_ = true;
+  EXPECT_THROW(ocs2::ILQR(incremental, *rolloutPtr, problem, initializer), std::runtime_error);
+
+  // the first-order ILQR accepts both
+  diagonalShift.algorithm_ = ocs2::ddp::Algorithm::ILQR;
+  EXPECT_NO_THROW(ocs2::ILQR(diagonalShift, *rolloutPtr, problem, initializer));
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Keeps the most recent latency samples of the MPC and computes their statistics. The samples are stored in a preallocated ring
+ * buffer, hence adding a sample does not allocate memory. All methods are thread-safe.
+ */
+class LatencyStatistics {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] capacity: The number of the most recent samples which are kept.
+   */
+  explicit LatencyStatistics(size_t capacity = 1000);
+
+  /** Removes all the samples. */
+  void reset();
+
+  /** Adds a latency sample in seconds. */
+  void addSample(scalar_t latency);
+
+  /** The number of the kept samples. */
+  size_t getNumSamples() const;
+
+  /**
+   * Computes a percentile of the kept samples with linear interpolation between the closest ranks.
+   *
+   * @param [in] percentile: The percentile in the range [0, 1].
+   * @return The latency in seconds, or zero if there is no sample.
+   */
+  scalar_t getPercentile(scalar_t percentile) const;
+
+  /** The median latency in seconds. */
+  scalar_t getMedian() const { return getPercentile(0.5); }
+
+  /** The 99th percentile of the latency in seconds. */
+  scalar_t getP99() const { return getPercentile(0.99); }
+
+  /** The mean latency in seconds, or zero if there is no sample. */
+  scalar_t getMean() const;
+
+  /** The maximum latency in seconds, or zero if there is no sample. */
+  scalar_t getMax() const;
+
+ private:
+  mutable std::mutex mutex_;
+  scalar_array_t samples_;
+  size_t numSamples_ = 0;
+  size_t nextIndex_ = 0;
+  mutable scalar_array_t sortedSamples_;
+};
+
+}  // namespace ocs2
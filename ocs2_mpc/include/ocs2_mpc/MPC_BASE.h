@@ -67,6 +67,16 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Runs MPC for the given state and time while the solver is initialized by the given primal solution instead of its own last
+   * solution, e.g. the solution of another MPC instance.
+   *
+   * @param [in] currentTime: The given time.
+   * @param [in] currentState: The given state.
+   * @param [in] initialGuess: The primal solution which initializes the solver.
+   */
+  virtual bool run(scalar_t currentTime, const vector_t& currentState, const PrimalSolution& initialGuess);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -89,10 +99,26 @@ class MPC_BASE {
    */
   virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
+  /**
+   * Solves the optimal control problem for the given state and time period ([initTime,finalTime]) while the solver is initialized by
+   * the given primal solution.
+   *
+   * @param [out] initTime: Initial time. This value can be adjusted by the optimizer.
+   * @param [in] initState: Initial state.
+   * @param [in] finalTime: Final time. This value can be adjusted by the optimizer.
+   * @param [in] initialGuess: The primal solution which initializes the solver.
+   */
+  virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& initialGuess) {
+    getSolverPtr()->run(initTime, initState, finalTime, initialGuess);
+  }
+
   /** Whether this is the first iteration of MPC or not. */
   bool isFirstMpcRun() const { return initRun_; }
 
  private:
+  /** Runs MPC, initialized by the initial guess if it is not a null pointer. */
+  bool runImpl(scalar_t currentTime, const vector_t& currentState, const PrimalSolution* initialGuessPtr);
+
   bool initRun_ = true;
   const mpc::Settings mpcSettings_;
 
@@ -38,8 +38,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/dynamics/ControlledSystemBase.h>
+#include "ocs2_mpc/LatencyStatistics.h"
 #include "ocs2_mpc/MPC_BASE.h"
 #include "ocs2_mpc/MRT_BASE.h"
+#include "ocs2_mpc/ObservationSeqlock.h"
+#include "ocs2_mpc/RolloutSession.h"
 
 namespace ocs2 {
 
@@ -57,8 +61,16 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   ~MPC_MRT_Interface() override = default;
 
+  /**
+   * Resets the MPC and reserves the observation slot for the dimensions of the initial target trajectories. It should not be called
+   * concurrently with advanceMpc().
+   */
   void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
 
+  /**
+   * Sets the observation for the next call of advanceMpc(). It does not block advanceMpc() and it does not allocate memory if the
+   * observation fits the dimensions of the target trajectories given to resetMpcNode().
+   */
   void setCurrentObservation(const SystemObservation& currentObservation) override;
 
   /*
@@ -70,9 +82,25 @@ class MPC_MRT_Interface final : public MRT_BASE {
   /**
    * Advance the mpc module for one iteration. The evaluation methods can be called while this method is running. They will evaluate the
    * control law that was up-to-date at the last updatePolicy() call.
+   *
+   * If the delay compensation is enabled in the MPC settings, the MPC optimizes from the observation predicted at the time the new
+   * policy is expected to be applied, i.e. after the given percentile of the measured MPC latencies.
    */
   void advanceMpc();
 
+  /**
+   * Sets the system dynamics which predict the observation for the delay compensation. The prediction is a RolloutSession on the last
+   * policy of the MPC, hence it does not record the trajectories. It is independent of the rollout of the MRT as it is used in the
+   * thread of advanceMpc().
+   *
+   * @param [in] systemDynamics: The system dynamics.
+   * @param [in] maxTimeStep: The maximum integration step of the prediction.
+   */
+  void initDelayCompensation(const ControlledSystemBase& systemDynamics, scalar_t maxTimeStep);
+
+  /** The statistics of the latencies of advanceMpc(), from reading the observation until the policy is in the buffer. */
+  const LatencyStatistics& getLatencyStatistics() const { return latencyStatistics_; }
+
   /**
    * @brief Retrieves the gain matrix from solver capable of optimizing over LinearController type.
    *
@@ -123,12 +151,27 @@ class MPC_MRT_Interface final : public MRT_BASE {
    */
   void copyToBuffer(const SystemObservation& mpcInitObservation);
 
+  /**
+   * Predicts the observation after the delay by integrating the last policy of the MPC. The policy and the session are kept between
+   * the calls to reuse their memory.
+   *
+   * @param [in] delay: The delay in seconds.
+   * @param [in, out] observation: The current observation which is replaced by the predicted one.
+   */
+  void predictObservation(scalar_t delay, SystemObservation& observation);
+
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
+  LatencyStatistics latencyStatistics_;
+
+  // delay compensation
+  bool policyComputed_ = false;
+  std::unique_ptr<RolloutSession> delayCompensationSessionPtr_;
+  PrimalSolution delayCompensationPolicy_;
 
   // MPC inputs
-  SystemObservation currentObservation_;
-  std::mutex observationMutex_;
+  ObservationSeqlock observationSeqlock_;
+  SystemObservation mpcObservation_;  // the observation of the current advanceMpc() call
 };
 
 }  // namespace ocs2
@@ -56,6 +56,21 @@ struct Settings {
    * or the given operating trajectories (cold start). */
   bool coldStart_ = false;
 
+  /**
+   * The wall-clock time budget (in seconds) of an MPC run. If set to a positive number, the solver terminates at the first iteration or
+   * line-search boundary at which its next phase is not expected to finish within the budget. Any non-positive number disables it.
+   */
+  scalar_t solveTimeBudget_ = -1;
+
+  /**
+   * Whether to compensate the computation delay of the MPC. If set, the MPC optimizes from the state predicted at the time its policy
+   * is expected to be applied. The state is predicted by rolling out the last policy for the expected delay. Only used by
+   * MPC_MRT_Interface.
+   */
+  bool compensateDelay_ = false;
+  /** The percentile of the measured MPC latencies, in the range [0, 1], which is used as the expected delay. */
+  scalar_t delayPercentile_ = 0.5;
+
   /**
    * MPC loop frequency in Hz. This setting is only used in Dummy_Loop for testing. If set to a
    * positive number, THe MPC loop will be simulated to run by the given frequency (note that this
@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/SharedMemoryTransport.h"
+
+namespace ocs2 {
+
+/**
+ * The MPC side of the shared memory transport for the deployments where the MPC and the MRT run on the same machine. It creates the
+ * shared memory segment, runs the MPC on the observations of MRT_SharedMemory_Interface, and publishes the encoded policies into the
+ * preallocated policy slots. It does not depend on ROS.
+ */
+class MPC_SharedMemory_Interface {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] mpc: The underlying MPC class to be used.
+   * @param [in] settings: The shared memory transport settings.
+   */
+  MPC_SharedMemory_Interface(MPC_BASE& mpc, shared_memory::Settings settings);
+
+  ~MPC_SharedMemory_Interface() = default;
+
+  /**
+   * Resets the MPC node. The MRT triggers the same through a reset request.
+   *
+   * @param [in] initTargetTrajectories: The initial desired trajectories.
+   */
+  void resetMpcNode(TargetTrajectories&& initTargetTrajectories);
+
+  /**
+   * Handles a pending reset request and runs the MPC once if a new observation has arrived.
+   *
+   * @return Whether a new policy is published.
+   */
+  bool spinOnce();
+
+  /** Calls spinOnce() until shutdown() is called. */
+  void spin();
+
+  /** Stops spin(). It can be called from any thread. */
+  void shutdown() { terminate_ = true; }
+
+ private:
+  /**
+   * Publishes the MPC solution into the next policy slot. If the MRT has acknowledged the last published policy, the solution is compared
+   * directly with it and only the changed nodes are published as a delta. Otherwise, or if the delta is not considerably smaller, the
+   * solution is encoded in full.
+   *
+   * @param [in] mpcInitObservation: The observation used to run the MPC.
+   */
+  void publishPolicy(const SystemObservation& mpcInitObservation);
+
+  MPC_BASE& mpc_;
+  shared_memory::SharedMemorySegment segment_;
+  benchmark::RepeatedTimer mpcTimer_;
+
+  std::mutex resetMutex_;
+  bool resetRequestedEver_ = false;
+  std::atomic_bool terminate_{false};
+
+  // the numbers of the last read messages
+  uint64_t lastObservationNumber_ = 0;
+  uint64_t lastResetNumber_ = 0;
+
+  // buffers, their memory is reused between the iterations
+  std::vector<char> messageBuffer_;
+  std::vector<char> policyBuffer_;
+  std::vector<char> deltaBuffer_;
+
+  // the last published policy as decoded by the MRT, the base of the next policy delta
+  uint64_t basePolicyNumber_ = 0;
+  PrimalSolution basePrimalSolution_;
+  CommandData baseCommandData_;
+  PerformanceIndex basePerformanceIndex_;
+  SystemObservation currentObservation_;
+  PrimalSolution primalSolution_;
+  CommandData commandData_;
+};
+
+}  // namespace ocs2
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
 
@@ -47,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/CommandData.h"
 #include "ocs2_mpc/MrtObserver.h"
+#include "ocs2_mpc/RolloutSession.h"
 #include "ocs2_mpc/SystemObservation.h"
 
 namespace ocs2 {
@@ -114,6 +116,16 @@ class MRT_BASE {
    */
   void initRollout(const RolloutBase* rolloutPtr);
 
+  /**
+   * @brief Initializes a persistent rollout session to roll out the policy. If set, rolloutPolicy() continues the integration of the
+   * previous call when it starts from the state and time at which the previous call ended, instead of restarting a rollout. The session
+   * is restarted when a new policy is swapped in. It takes precedence over the rollout of initRollout().
+   *
+   * @param [in] systemDynamics: The system dynamics.
+   * @param [in] maxTimeStep: The maximum integration step of the session.
+   */
+  void initRolloutSession(const ControlledSystemBase& systemDynamics, scalar_t maxTimeStep);
+
   /**
    * @brief Evaluates the controller
    *
@@ -141,17 +153,18 @@ class MRT_BASE {
   /**
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
+   * Otherwise, it applies a deferred in-place update to the in-use policy, if any.
    * This method also calls the modifyActiveSolution() method.
    *
    * @return True if the policy is updated.
    */
-  bool updatePolicy();
+  virtual bool updatePolicy();
 
   /**
    * @brief rolloutSet: Whether or not the internal rollout object has been set
    * @return True if a rollout object is available.
    */
-  bool isRolloutSet() const { return rolloutPtr_ != nullptr; }
+  bool isRolloutSet() const { return rolloutPtr_ != nullptr || rolloutSessionPtr_ != nullptr; }
 
   /**
    * Adds an MRT observer to the policy update process
@@ -162,6 +175,34 @@ class MRT_BASE {
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
+  /**
+   * Swaps the given solution with the buffer. On return, the arguments hold the objects which were previously in the buffer
+   * (nullptr if the buffer was empty). These are either an unused policy or the policy replaced by the last updatePolicy() call,
+   * hence a derived class can recycle their memory to decode the next policy.
+   */
+  void swapWithBuffer(std::unique_ptr<CommandData>& commandDataPtr, std::unique_ptr<PrimalSolution>& primalSolutionPtr,
+                      std::unique_ptr<PerformanceIndex>& performanceIndicesPtr);
+
+  /** An in-place update of a policy, e.g., the application of a policy delta. */
+  using PolicyUpdate = std::function<void(CommandData&, PrimalSolution&, PerformanceIndex&)>;
+
+  /**
+   * Updates the latest received policy in place instead of moving a new policy to the buffer. If the buffered policy is not swapped in
+   * yet, it is updated right away. Otherwise, the latest policy is the active one and the update is deferred to the next updatePolicy()
+   * call. A deferred update is dropped if a new policy is moved to the buffer before. Since the MRT observers may modify the policies,
+   * the in-place updates are refused once an observer is added.
+   *
+   * @param [in] update: The update of the latest policy.
+   * @return False if the update is refused: no policy is received yet, an update is already deferred, or an observer is added.
+   */
+  bool updateLatestPolicy(PolicyUpdate update);
+
+  /** Whether an in-place update is deferred to the next updatePolicy() call. */
+  bool hasDeferredPolicyUpdate() const;
+
+  /** Whether an MRT observer is added. */
+  bool hasMrtObservers() const { return !observerPtrArray_.empty(); }
+
  private:
   /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
@@ -180,6 +221,7 @@ class MRT_BASE {
   std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
   std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
   std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
+  PolicyUpdate deferredPolicyUpdate_;  // an in-place update of the active policy, applied by the next updatePolicy()
 
   // thread safety
   mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
@@ -188,6 +230,8 @@ class MRT_BASE {
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  std::unique_ptr<RolloutSession> rolloutSessionPtr_;
+  bool rolloutSessionOutdated_ = true;  // whether the policy of the rollout session is not the active one
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ocs2_mpc/MRT_BASE.h"
+#include "ocs2_mpc/SharedMemoryTransport.h"
+
+namespace ocs2 {
+
+/**
+ * The MRT side of the shared memory transport. It replaces MRT_ROS_Interface when the MPC runs in another process on the same machine
+ * through MPC_SharedMemory_Interface. The observations are written into the shared memory segment and the policies are read from it
+ * without any serialization library or network stack.
+ */
+class MRT_SharedMemory_Interface final : public MRT_BASE {
+ public:
+  /**
+   * Constructor. The shared memory segment should have been created by MPC_SharedMemory_Interface.
+   *
+   * @param [in] settings: The shared memory transport settings.
+   */
+  explicit MRT_SharedMemory_Interface(shared_memory::Settings settings);
+
+  ~MRT_SharedMemory_Interface() override;
+
+  /** Requests the MPC to reset and blocks until the MPC acknowledges the request. */
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
+
+  void setCurrentObservation(const SystemObservation& currentObservation) override;
+
+  /**
+   * Reads the latest policy from the shared memory, if it is newer than the last received one. A full policy is decoded in place into
+   * the objects returned from the MRT_BASE buffer, so their memory is reused once the sizes settle. A policy delta only carries the
+   * changed nodes, which are applied in place to the latest policy: the buffered one, or the active one on the next updatePolicy() call.
+   * Each received policy is acknowledged to the MPC as the base of the next delta.
+   *
+   * @return Whether a new policy is received.
+   */
+  bool spinMRT();
+
+  /** Launches a thread which polls the shared memory for new policies. */
+  void launchSpinner();
+
+  /** Stops the thread launched by launchSpinner(). */
+  void shutdownSpinner();
+
+ private:
+  shared_memory::SharedMemorySegment segment_;
+
+  std::mutex policyMutex_;
+  uint64_t lastPolicyNumber_ = 0;
+  std::vector<char> messageBuffer_;
+
+  // the number of the latest received policy, the base of the next policy delta, and the delta which is applied to it
+  uint64_t latestPolicyNumber_ = 0;
+  std::vector<char> deltaBuffer_;
+
+  // the objects which the next policy is decoded into, recycled from the MRT_BASE buffer
+  std::unique_ptr<CommandData> decodedCommandPtr_;
+  std::unique_ptr<PrimalSolution> decodedPrimalSolutionPtr_;
+  std::unique_ptr<PerformanceIndex> decodedPerformanceIndexPtr_;
+
+  std::mutex observationMutex_;
+  std::vector<char> observationBuffer_;
+
+  std::atomic_bool terminateSpinner_{false};
+  std::thread spinnerWorker_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+namespace mpc_replay {
+
+/**
+ * One MPC cycle of a replay log. The target trajectories and the mode schedule are set, if available, before the observation is solved.
+ */
+struct Cycle {
+  SystemObservation observation;
+  bool hasTargetTrajectories = false;
+  TargetTrajectories targetTrajectories;
+  bool hasModeSchedule = false;
+  ModeSchedule modeSchedule;
+};
+
+/** The statistics of one replayed MPC cycle. */
+struct CycleStatistics {
+  /** The time of the observation. */
+  scalar_t time = 0.0;
+  /** The wall-clock duration of the MPC run in seconds. */
+  scalar_t latency = 0.0;
+  /** The number of the solver iterations. */
+  size_t numIterations = 0;
+  /** The cost of the solution. */
+  scalar_t cost = 0.0;
+  /** The merit of the solution. */
+  scalar_t merit = 0.0;
+  /** Whether the solver is terminated by the deadline of the time budget. */
+  bool terminatedByDeadline = false;
+};
+
+/**
+ * Writes a replay log. The log is a compact binary file of records, each one holding an observation, target trajectories or a mode
+ * schedule. Every observation record closes an MPC cycle, the preceding reference records are applied before its MPC run.
+ */
+class LogWriter {
+ public:
+  /**
+   * Constructor. It creates or truncates the log file.
+   *
+   * @param [in] fileName: The name of the log file.
+   */
+  explicit LogWriter(const std::string& fileName);
+
+  /** Writes an observation, which closes the current MPC cycle. */
+  void writeObservation(const SystemObservation& observation);
+
+  /** Writes target trajectories, which are set before the next observation is solved. */
+  void writeTargetTrajectories(const TargetTrajectories& targetTrajectories);
+
+  /** Writes a mode schedule, which is set before the next observation is solved. */
+  void writeModeSchedule(const ModeSchedule& modeSchedule);
+
+  /** Writes a whole MPC cycle. */
+  void writeCycle(const Cycle& cycle);
+
+  /** Flushes the written records to the file. */
+  void flush();
+
+ private:
+  void writeRecord(uint32_t type);
+
+  std::string fileName_;
+  std::ofstream file_;
+  std::vector<char> buffer_;
+};
+
+/**
+ * Loads the MPC cycles of a replay log. The reference records after the last observation are ignored.
+ *
+ * @param [in] fileName: The name of the log file.
+ * @return The MPC cycles.
+ */
+std::vector<Cycle> loadLog(const std::string& fileName);
+
+/**
+ * Replays the MPC cycles through an MPC_MRT_Interface as fast as possible. The MPC is reset by the target trajectories of the first
+ * cycle, which therefore should have them. The solver of the MPC is not otherwise modified, so that any solver can be replayed.
+ *
+ * @param [in] mpc: The MPC to be replayed.
+ * @param [in] cycles: The MPC cycles.
+ * @return The statistics of each MPC cycle.
+ */
+std::vector<CycleStatistics> replay(MPC_BASE& mpc, const std::vector<Cycle>& cycles);
+
+/** Writes the statistics of the MPC cycles in CSV format, with a header line. */
+void writeStatistics(const std::vector<CycleStatistics>& statistics, std::ostream& stream);
+
+/** Prints a summary of the latencies, the iterations and the costs of the MPC cycles. */
+void printSummary(const std::vector<CycleStatistics>& statistics, std::ostream& stream);
+
+}  // namespace mpc_replay
+}  // namespace ocs2
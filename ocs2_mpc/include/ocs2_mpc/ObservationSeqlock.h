@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+
+/**
+ * A slot for the latest SystemObservation which is protected by a sequence lock. The writers copy the observation into a preallocated
+ * slot and never allocate memory once the slot is reserved for the observation dimensions. The readers never block the writers: they
+ * copy the slot and retry if a write has happened in the meantime. Concurrent writers are serialized by a mutex which the readers do
+ * not take.
+ */
+class ObservationSeqlock {
+ public:
+  /** Constructor. The slot is empty and has no capacity. */
+  ObservationSeqlock();
+
+  /**
+   * Reserves the slot for observations with the given dimensions and empties it. It should not be called concurrently with read().
+   *
+   * @param [in] stateDim: The dimension of the state.
+   * @param [in] inputDim: The dimension of the input.
+   */
+  void reserve(size_t stateDim, size_t inputDim);
+
+  /**
+   * Writes an observation to the slot. It only allocates memory if the observation does not fit the reserved dimensions. In this case,
+   * the previous storage is kept alive until the next reserve() as it might be read concurrently.
+   *
+   * @param [in] observation: The observation.
+   */
+  void write(const SystemObservation& observation);
+
+  /**
+   * Reads a consistent snapshot of the latest observation. It only allocates memory if the dimensions of the given observation differ
+   * from the ones of the latest observation.
+   *
+   * @param [out] observation: The latest observation. It is left untouched if no observation has been written.
+   * @return The number of the written observations at the time of the snapshot, zero if no observation has been written.
+   */
+  uint64_t read(SystemObservation& observation) const;
+
+ private:
+  struct Slot {
+    explicit Slot(size_t capacity) : data(capacity) {}
+
+    size_t mode = 0;
+    scalar_t time = 0.0;
+    size_t stateDim = 0;
+    size_t inputDim = 0;
+    std::vector<scalar_t> data;  // state followed by input
+  };
+
+  std::mutex writeMutex_;
+  std::atomic<uint64_t> sequence_{0};  // odd while a write is in progress
+  std::atomic<uint64_t> numWrites_{0};
+  std::atomic<Slot*> slotPtr_{nullptr};
+  std::vector<std::unique_ptr<Slot>> slotStorage_;  // the current slot is the last one
+};
+
+}  // namespace ocs2
@@ -0,0 +1,154 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ocs2_mpc/LatencyStatistics.h"
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/MRT_BASE.h"
+
+namespace ocs2 {
+
+/**
+ * A ROS independent MPC-MRT interface which runs several MPC instances in a pipeline. Each instance solves in its own thread and the
+ * solves start staggered in time, so that a new solve starts before the previous one finishes. Every solve is initialized by the most
+ * recent finished solution and the policy of the most recent observation is published. On a multi-core machine, this raises the policy
+ * update rate when the solve time approaches the MPC period.
+ *
+ * The solve starts are spaced by the MPC period (mpcDesiredFrequency_ of the MPC settings) or, if it is not positive, by the median solve
+ * time divided by the number of the instances.
+ *
+ * If an MPC instance throws an exception, the pipeline stops and the exception is rethrown by the next setCurrentObservation() or
+ * updatePolicy() call. The pipeline can be started again by launch().
+ */
+class PipelinedMPC_MRT_Interface final : public MRT_BASE {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] mpcPtrs: The MPC instances, at least one. Each of them should have its own solver and reference manager as they run
+   *                      concurrently. The settings of the first instance determine the solution time window and the MPC period.
+   */
+  explicit PipelinedMPC_MRT_Interface(std::vector<std::unique_ptr<MPC_BASE>> mpcPtrs);
+
+  /** Destructor. Stops the pipeline. */
+  ~PipelinedMPC_MRT_Interface() override;
+
+  /** Resets all the MPC instances and sets their target trajectories. It blocks until the running solves are finished. */
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
+
+  /** Sets the observation for the next solve. It rethrows the exception of a stopped MPC instance, if any. */
+  void setCurrentObservation(const SystemObservation& currentObservation) override;
+
+  /** Updates the policy as MRT_BASE::updatePolicy(). It rethrows the exception of a stopped MPC instance, if any. */
+  bool updatePolicy() override;
+
+  /** Launches the threads of the MPC instances. The pipeline solves every new observation at the earliest free start time. */
+  void launch();
+
+  /** Stops the threads of the MPC instances after their running solves are finished. */
+  void shutdown();
+
+  /** The number of the MPC instances. */
+  size_t getNumInstances() const { return instances_.size(); }
+
+  /** Gets the MPC instance with the given index. It should not be accessed while the pipeline is running. */
+  MPC_BASE& getMpc(size_t index) { return *instances_[index]->mpcPtr; }
+
+  /** The statistics of the latencies from setting an observation until its policy is in the buffer. */
+  const LatencyStatistics& getLatencyStatistics() const { return latencyStatistics_; }
+
+  /** The statistics of the solve times of the MPC instances. */
+  const LatencyStatistics& getSolveTimeStatistics() const { return solveTimeStatistics_; }
+
+  /** The number of the solutions which are discarded since a solve of a more recent observation finished earlier. */
+  size_t getNumDiscardedSolutions() const { return numDiscardedSolutions_; }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  struct Instance {
+    std::unique_ptr<MPC_BASE> mpcPtr;
+    std::mutex mutex;              // held during a solve
+    uint64_t lastSolvedNumber = 0;  // the observation number of the last solve
+  };
+
+  /** The loop of the thread of an MPC instance. */
+  void runInstance(Instance& instance);
+
+  /** Rethrows the exception of a stopped MPC instance once, if any. */
+  void rethrowWorkerException();
+
+  /** The time between two solve starts. */
+  clock::duration getStartSpacing() const;
+
+  /**
+   * Copies the solution of an MPC instance to the buffer if its observation is more recent than the one of the published policy.
+   *
+   * @param [in] mpc: The MPC instance.
+   * @param [in] observation: The observation used to run the MPC.
+   * @param [in] observationNumber: The number of the observation.
+   * @param [in] observationTime: The time point at which the observation is set.
+   */
+  void publishSolution(MPC_BASE& mpc, const SystemObservation& observation, uint64_t observationNumber, clock::time_point observationTime);
+
+  std::vector<std::unique_ptr<Instance>> instances_;
+  std::vector<std::thread> workers_;
+  std::atomic_bool terminate_{false};
+  std::exception_ptr workerException_;  // the first exception of the MPC instances, guarded by observationMutex_
+
+  // the most recent observation and the scheduling of the solves
+  std::mutex observationMutex_;
+  std::condition_variable observationUpdated_;
+  SystemObservation currentObservation_;
+  uint64_t observationNumber_ = 0;
+  uint64_t lastStartedObservationNumber_ = 0;
+  clock::time_point observationTime_;
+  clock::time_point nextStartTime_;
+
+  // the most recent published solution, it initializes the next solves
+  std::mutex solutionMutex_;
+  std::shared_ptr<const PrimalSolution> latestSolutionPtr_;
+  uint64_t latestSolutionNumber_ = 0;
+  std::atomic<size_t> numDiscardedSolutions_{0};
+
+  LatencyStatistics latencyStatistics_;
+  LatencyStatistics solveTimeStatistics_;
+};
+
+}  // namespace ocs2
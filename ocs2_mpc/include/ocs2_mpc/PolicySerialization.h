@@ -0,0 +1,264 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/ControllerType.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+namespace policy_serialization {
+
+/** The magic number at the start of an encoded policy. It also detects a mismatch in the byte order. */
+constexpr uint32_t magicNumber = 0x4f435350;  // "OCSP"
+
+/** The version of the binary layout. It is increased with every change of the layout. */
+constexpr uint16_t formatVersion = 2;
+
+/** Header flag: the feedback gains are stored in single precision. */
+constexpr uint16_t quantizedGainsFlag = 0x0001;
+
+/**
+ * The fixed size header of an encoded policy. The sections follow the header in the order below, each of them starts at an 8 byte
+ * aligned offset and the matrices are stored column-wise:
+ *   time trajectory (N), post-event indices, event times, mode sequence, state trajectory (nx x N), input trajectory (nu x N),
+ *   feedforward or bias of the controller (nu x N), feedback gains (nu x nx per node, only for a linear controller),
+ *   observation state, observation input, target time trajectory, target state trajectory, target input trajectory.
+ */
+struct Header {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;
+  uint32_t controllerType;
+  uint32_t numNodes;
+  uint32_t stateDim;
+  uint32_t inputDim;
+  uint32_t numPostEventIndices;
+  uint32_t numModes;
+  uint32_t observationStateDim;
+  uint32_t observationInputDim;
+  uint32_t numTargetNodes;
+  uint32_t targetStateDim;
+  uint32_t targetInputDim;
+  uint32_t reserved;
+  uint64_t size;
+  uint64_t observationMode;
+  double observationTime;
+  double performanceIndex[6];  // merit, cost, dynamicsViolationSSE, equalityConstraintsSSE, equalityLagrangian, inequalityLagrangian
+};
+
+/** The byte offsets of the sections of an encoded policy and its total size. */
+struct Layout {
+  size_t time;
+  size_t postEventIndices;
+  size_t eventTimes;
+  size_t modeSequence;
+  size_t state;
+  size_t input;
+  size_t bias;
+  size_t gain;
+  size_t observationState;
+  size_t observationInput;
+  size_t targetTime;
+  size_t targetState;
+  size_t targetInput;
+  size_t size;
+};
+
+/** Computes the layout of an encoded policy from its header. */
+Layout computeLayout(const Header& header);
+
+/**
+ * Encodes the policy into a contiguous buffer. The buffer is resized to the encoded size, its memory is reused if its capacity suffices.
+ * The state, input, and controller dimensions should be the same for all the nodes. The controller is sampled on the time trajectory.
+ *
+ * @param [in] primalSolution: The primal solution with a feedforward or a linear controller.
+ * @param [in] commandData: The command data of the policy.
+ * @param [in] performanceIndex: The performance index of the policy.
+ * @param [out] buffer: The encoded policy.
+ * @param [in] quantizeGains: Whether to store the feedback gains in single precision.
+ */
+void encodePolicy(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndex,
+                  std::vector<char>& buffer, bool quantizeGains = false);
+
+/**
+ * A zero-copy view of an encoded policy. The trajectories are mapped as matrices with one column per node. The view does not own the
+ * memory, hence the buffer should outlive it.
+ */
+class PolicyView {
+ public:
+  using const_matrix_map_t = Eigen::Map<const matrix_t>;
+  using const_vector_map_t = Eigen::Map<const vector_t>;
+
+  /**
+   * Constructor. It validates the header against the buffer.
+   *
+   * @param [in] data: The 8 byte aligned start of the encoded policy.
+   * @param [in] size: The number of the available bytes.
+   */
+  PolicyView(const char* data, size_t size);
+
+  /** Constructor. */
+  explicit PolicyView(const std::vector<char>& buffer) : PolicyView(buffer.data(), buffer.size()) {}
+
+  const Header& header() const { return *reinterpret_cast<const Header*>(data_); }
+  ControllerType controllerType() const { return static_cast<ControllerType>(header().controllerType); }
+  bool hasQuantizedGains() const { return (header().flags & quantizedGainsFlag) != 0; }
+  size_t numNodes() const { return header().numNodes; }
+  size_t stateDim() const { return header().stateDim; }
+  size_t inputDim() const { return header().inputDim; }
+
+  const_vector_map_t timeTrajectory() const { return {doubles(layout_.time), header().numNodes}; }
+  const uint64_t* postEventIndices() const { return reinterpret_cast<const uint64_t*>(data_ + layout_.postEventIndices); }
+  const_vector_map_t eventTimes() const { return {doubles(layout_.eventTimes), header().numModes - 1}; }
+  const uint64_t* modeSequence() const { return reinterpret_cast<const uint64_t*>(data_ + layout_.modeSequence); }
+  const_matrix_map_t stateTrajectory() const { return {doubles(layout_.state), header().stateDim, header().numNodes}; }
+  const_matrix_map_t inputTrajectory() const { return {doubles(layout_.input), header().inputDim, header().numNodes}; }
+  /** The feedforward input of a feedforward controller or the bias of a linear controller. */
+  const_matrix_map_t controllerBias() const { return {doubles(layout_.bias), header().inputDim, header().numNodes}; }
+  /** The double precision feedback gain of node k. Only valid for a linear controller without quantized gains. */
+  const_matrix_map_t gain(size_t k) const { return {doubles(layout_.gain) + k * gainSize(), header().inputDim, header().stateDim}; }
+  /** The single precision feedback gain of node k. Only valid for a linear controller with quantized gains. */
+  Eigen::Map<const Eigen::MatrixXf> quantizedGain(size_t k) const {
+    return {reinterpret_cast<const float*>(data_ + layout_.gain) + k * gainSize(), header().inputDim, header().stateDim};
+  }
+  /** Copies the feedback gain of node k, independent of its precision. */
+  void getGain(size_t k, matrix_t& feedbackGain) const;
+
+  const_vector_map_t observationState() const { return {doubles(layout_.observationState), header().observationStateDim}; }
+  const_vector_map_t observationInput() const { return {doubles(layout_.observationInput), header().observationInputDim}; }
+  const_vector_map_t targetTimeTrajectory() const { return {doubles(layout_.targetTime), header().numTargetNodes}; }
+  const_matrix_map_t targetStateTrajectory() const {
+    return {doubles(layout_.targetState), header().targetStateDim, header().numTargetNodes};
+  }
+  const_matrix_map_t targetInputTrajectory() const {
+    return {doubles(layout_.targetInput), header().targetInputDim, header().numTargetNodes};
+  }
+
+  PerformanceIndex performanceIndex() const;
+
+  /** The start of the encoded policy and the offsets of its sections. */
+  const char* data() const { return data_; }
+  const Layout& layout() const { return layout_; }
+
+ private:
+  const double* doubles(size_t offset) const { return reinterpret_cast<const double*>(data_ + offset); }
+  size_t gainSize() const { return static_cast<size_t>(header().inputDim) * header().stateDim; }
+
+  const char* data_;
+  Layout layout_;
+};
+
+/**
+ * Decodes an encoded policy. The memory of the output arguments, including the controller if it has the encoded type, is reused.
+ *
+ * @param [in] policyView: The view of the encoded policy.
+ * @param [out] primalSolution: The primal solution with the decoded controller.
+ * @param [out] commandData: The command data of the policy.
+ * @param [out] performanceIndex: The performance index of the policy.
+ */
+void decodePolicy(const PolicyView& policyView, PrimalSolution& primalSolution, CommandData& commandData,
+                  PerformanceIndex& performanceIndex);
+
+/** The magic number at the start of an encoded policy delta. */
+constexpr uint32_t deltaMagicNumber = 0x4f435344;  // "OCSD"
+
+/**
+ * The fixed size header of a policy delta. A delta encodes a policy against the base policy, the previous policy which the receiver holds:
+ * node k of the policy corresponds to node k + timeShift of the base policy. Only the nodes in the changed ranges are stored, the others
+ * are kept by the receiver. The feedback gains have their own changed ranges as they often change less than the trajectories.
+ *
+ * The header is followed by the header of the policy, the sections which are not per node (events, modes, command data) in the layout of
+ * the policy, the node and the gain ranges as [begin, end) pairs of uint32_t, the changed nodes of the time, state, input, and bias
+ * sections, and the changed gains.
+ */
+struct DeltaHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t numNodeRanges;
+  uint32_t numGainRanges;
+  uint64_t baseNumber;
+  uint64_t baseNumNodes;
+  int64_t timeShift;
+  uint64_t policySize;  // the size of the full encoding of the policy
+  uint64_t size;
+};
+
+/** Whether the buffer starts with a policy delta rather than a policy. */
+bool isPolicyDelta(const char* data, size_t size);
+
+/** Reads and validates the header of a policy delta. */
+DeltaHeader readDeltaHeader(const char* data, size_t size);
+
+/**
+ * Encodes a policy as a delta against a base policy. The policy is compared directly with the base policy, without encoding it in full.
+ * The node of the base policy which has the time of the first node of the policy determines the time shift. A node, or its feedback gain,
+ * is unchanged if its base node has the same time and its values differ by at most the tolerance.
+ *
+ * The base policy should be in the form of a decoded policy, i.e., its controller is sampled on its time trajectory, as the receiver
+ * holds it. After applying the delta to the base policy with applyPolicyDelta(), the sender holds the same policy as the receiver.
+ * Hence, the error of a positive tolerance does not accumulate over the deltas.
+ *
+ * @param [in] basePrimalSolution: The base policy.
+ * @param [in] baseNumber: The number which identifies the base policy at the receiver.
+ * @param [in] primalSolution: The primal solution of the policy with a feedforward or a linear controller.
+ * @param [in] commandData: The command data of the policy.
+ * @param [in] performanceIndex: The performance index of the policy.
+ * @param [out] delta: The encoded delta. Its memory is reused.
+ * @param [in] tolerance: The maximum absolute difference of the values of an unchanged node.
+ * @param [in] quantizeGains: Whether to store the changed feedback gains in single precision.
+ * @return False if the policies have different dimensions or controller types. The delta is not encoded then.
+ */
+bool encodePolicyDelta(const PrimalSolution& basePrimalSolution, uint64_t baseNumber, const PrimalSolution& primalSolution,
+                       const CommandData& commandData, const PerformanceIndex& performanceIndex, std::vector<char>& delta,
+                       scalar_t tolerance = 0.0, bool quantizeGains = false);
+
+/**
+ * Applies a policy delta in place to its base policy. The base nodes are shifted by the time shift of the delta and only the changed
+ * nodes are written, the memory of the others is reused.
+ *
+ * @param [in] delta: The start of the encoded delta.
+ * @param [in] deltaSize: The number of the available bytes of the delta.
+ * @param [in, out] primalSolution: The base policy, which is updated to the policy of the delta.
+ * @param [out] commandData: The command data of the policy.
+ * @param [out] performanceIndex: The performance index of the policy.
+ */
+void applyPolicyDelta(const char* delta, size_t deltaSize, PrimalSolution& primalSolution, CommandData& commandData,
+                      PerformanceIndex& performanceIndex);
+
+}  // namespace policy_serialization
+}  // namespace ocs2
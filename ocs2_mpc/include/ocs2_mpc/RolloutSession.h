@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/dynamics/ControlledSystemBase.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+
+namespace ocs2 {
+
+/**
+ * A persistent forward simulation of a policy for the MRT loop. Unlike a rollout, it does not record the trajectories and it keeps its
+ * time and state between the calls, so that each tick continues the integration from where the previous one ended. It integrates with
+ * the explicit fourth order Runge-Kutta method on a fixed maximum step, hence the cost of a tick of a constant duration is constant. The
+ * intermediate states and the state update are evaluated in place. The flow map and the controller return their values by value, so
+ * each stage still allocates these; the stages take over the returned vectors.
+ */
+class RolloutSession {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] systemDynamics: The system dynamics.
+   * @param [in] maxTimeStep: The maximum integration step.
+   */
+  RolloutSession(const ControlledSystemBase& systemDynamics, scalar_t maxTimeStep);
+
+  /**
+   * Restarts the session from the given time and state with a policy. It should be called whenever a new policy is swapped in.
+   *
+   * @param [in] time: The initial time.
+   * @param [in] state: The initial state.
+   * @param [in] controllerPtr: The controller of the policy. It should stay valid until the next reset.
+   */
+  void reset(scalar_t time, const vector_t& state, ControllerBase* controllerPtr);
+
+  /** Whether the session is started and its current time and state are the given ones, i.e., a tick would continue the session. */
+  bool isAt(scalar_t time, const vector_t& state) const;
+
+  /**
+   * Integrates the session until the final time. The jump map is applied at the event times of the mode schedule.
+   *
+   * @param [in] finalTime: The final time.
+   * @param [in] modeSchedule: The mode schedule of the policy.
+   */
+  void advance(scalar_t finalTime, const ModeSchedule& modeSchedule);
+
+  /** The current time of the session. */
+  scalar_t getTime() const { return time_; }
+
+  /** The current state of the session. */
+  const vector_t& getState() const { return state_; }
+
+  /** The input of the policy at the current time and state. */
+  const vector_t& getInput() const { return input_; }
+
+ private:
+  /** Integrates a single Runge-Kutta step on the current state. */
+  void step(scalar_t dt);
+
+  std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
+  const scalar_t maxTimeStep_;
+  bool isStarted_ = false;
+
+  scalar_t time_ = 0.0;
+  vector_t state_;
+  vector_t input_;
+
+  // Runge-Kutta stages and the intermediate state
+  vector_t k1_, k2_, k3_, k4_;
+  vector_t tempState_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <iostream>
+
+#include <ocs2_oc/oc_solver/ScenarioSolver.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+
+/**
+ * A scenario MPC, which is robust against model errors. In each MPC run, it solves several perturbed copies of the optimal control
+ * problem concurrently and brings their first inputs to a consensus. The published policy is the solution of the first scenario with the
+ * consensus input as its first input. The runs in which the consensus is not reached are counted and, with debugPrint_, reported.
+ */
+class ScenarioMpc final : public MPC_BASE {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] mpcSettings: Structure containing the settings for the MPC algorithm.
+   * @param [in] scenarioSettings: Structure containing the settings for the scenario solver.
+   * @param [in] optimalControlProblem: The nominal optimal control problem, which is copied for each scenario.
+   * @param [in] perturbation: Perturbs the copy of the optimal control problem of each scenario.
+   * @param [in] solverFactory: Creates the solver of each scenario with its share of the thread budget. A solver which needs a rollout
+   *                            should create it from the perturbed dynamics of the given problem.
+   */
+  ScenarioMpc(mpc::Settings mpcSettings, scenario::Settings scenarioSettings, const OptimalControlProblem& optimalControlProblem,
+              const ScenarioSolver::perturbation_t& perturbation, const ScenarioSolver::solver_factory_t& solverFactory)
+      : MPC_BASE(std::move(mpcSettings)) {
+    solverPtr_.reset(new ScenarioSolver(std::move(scenarioSettings), optimalControlProblem, perturbation, solverFactory));
+  }
+
+  ~ScenarioMpc() override = default;
+
+  void reset() override {
+    MPC_BASE::reset();
+    numUnconvergedRuns_ = 0;
+  }
+
+  ScenarioSolver* getSolverPtr() override { return solverPtr_.get(); }
+  const ScenarioSolver* getSolverPtr() const override { return solverPtr_.get(); }
+
+  /** Whether the first inputs of the scenarios reached the consensus tolerance in the last run. */
+  bool isConsensusConverged() const { return solverPtr_->isConsensusConverged(); }
+
+  /** The number of the runs since the last reset in which the consensus is not reached. */
+  size_t getNumUnconvergedRuns() const { return numUnconvergedRuns_; }
+
+ protected:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    if (settings().coldStart_) {
+      solverPtr_->reset();
+    }
+    solverPtr_->run(initTime, initState, finalTime);
+    checkConsensus(initTime);
+  }
+
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& initialGuess) override {
+    solverPtr_->run(initTime, initState, finalTime, initialGuess);
+    checkConsensus(initTime);
+  }
+
+ private:
+  /** Counts and reports the run if the consensus is not reached. */
+  void checkConsensus(scalar_t initTime) {
+    if (!solverPtr_->isConsensusConverged()) {
+      numUnconvergedRuns_++;
+      if (settings().debugPrint_) {
+        std::cerr << "[ScenarioMpc::calculateController] WARNING: The consensus is not reached at time " << initTime
+                  << ", residual: " << solverPtr_->getConsensusResidual() << '\n';
+      }
+    }
+  }
+
+  std::unique_ptr<ScenarioSolver> solverPtr_;
+  size_t numUnconvergedRuns_ = 0;
+};
+
+}  // namespace ocs2
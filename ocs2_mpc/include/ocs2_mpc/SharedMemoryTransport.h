@@ -0,0 +1,173 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+namespace shared_memory {
+
+/**
+ * This structure holds the settings of the shared memory transport between the MPC and the MRT processes. Both sides should use the
+ * same settings.
+ */
+struct Settings {
+  /** The name of the POSIX shared memory object. It should start with a slash. */
+  std::string name_ = "/ocs2_mpc";
+  /** The number of the preallocated policy slots. A reader retries only if the MPC overtakes it by this many policies. */
+  size_t numPolicySlots_ = 3;
+  /** The capacity of each policy slot in bytes. It should fit the largest encoded policy. */
+  size_t policySlotCapacity_ = 4 * 1024 * 1024;
+  /** The capacity of the observation and the reset request slots in bytes. */
+  size_t messageSlotCapacity_ = 256 * 1024;
+  /** The polling period of the spinning loops in seconds. A non-positive value yields the thread between the polls. */
+  scalar_t pollingPeriod_ = 50e-6;
+  /**
+   * Whether the MPC publishes the policies as deltas against the last published policy, if the MRT has acknowledged it. A full policy is
+   * published otherwise or if a delta would not be considerably smaller. The deltas are disabled when MRT observers are added.
+   */
+  bool deltaPolicyUpdates_ = true;
+  /** The maximum absolute difference of a policy node which is considered unchanged by a delta. Zero makes the deltas lossless. */
+  scalar_t deltaPolicyTolerance_ = 0.0;
+};
+
+/**
+ * Loads the shared memory transport settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The shared memory transport settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "shared_memory", bool verbose = true);
+
+/** Sleeps for the polling period, or yields the thread if the period is non-positive. */
+void waitForPollingPeriod(const Settings& settings);
+
+/** The channels of the shared memory segment. */
+enum class Channel { POLICY, OBSERVATION, RESET };
+
+/**
+ * A POSIX shared memory segment with three channels: the policies from the MPC to the MRT, and the observations and the reset
+ * requests from the MRT to the MPC. Each channel is a ring of preallocated slots with one writer. Every slot is protected by a
+ * sequence lock: the writer makes the sequence odd while it writes and the readers copy the slot and retry if the sequence has
+ * changed in the meantime. Hence, neither side ever blocks the other one and no memory is allocated once the buffers are warm.
+ */
+class SharedMemorySegment {
+ public:
+  /**
+   * Constructor. The MPC side creates the segment and removes it on destruction, the MRT side opens the existing one.
+   *
+   * @param [in] settings: The shared memory transport settings.
+   * @param [in] create: Whether to create the segment. An existing segment with the same name is replaced.
+   */
+  SharedMemorySegment(Settings settings, bool create);
+
+  ~SharedMemorySegment();
+  SharedMemorySegment(const SharedMemorySegment&) = delete;
+  SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+  const Settings& settings() const { return settings_; }
+
+  /**
+   * Writes a message into the next slot of the channel. Each channel should have a single writer.
+   *
+   * @param [in] channel: The channel.
+   * @param [in] data: The start of the message.
+   * @param [in] size: The size of the message in bytes.
+   * @return The number of the message, starting from one.
+   */
+  uint64_t write(Channel channel, const char* data, size_t size);
+
+  /**
+   * Copies the latest message of the channel if it is newer than the last read one. The memory of the buffer is reused.
+   *
+   * @param [in] channel: The channel.
+   * @param [in, out] lastNumber: The number of the last read message. It is updated to the number of the read message.
+   * @param [out] buffer: The message.
+   * @return Whether a new message is read.
+   */
+  bool read(Channel channel, uint64_t& lastNumber, std::vector<char>& buffer) const;
+
+  /** The number of the latest message written to the channel. Zero if there is none. */
+  uint64_t latestNumber(Channel channel) const;
+
+  /** Acknowledges that the reset request with the given number is handled. The policies published so far become outdated. */
+  void acknowledgeReset(uint64_t resetNumber);
+
+  /** The number of the last handled reset request. */
+  uint64_t acknowledgedReset() const;
+
+  /** The number of the latest policy which was published before the last handled reset request. */
+  uint64_t policyNumberAtReset() const;
+
+  /** Called by the MRT to acknowledge that it holds the policy with the given number as the base of the next policy delta. */
+  void acknowledgePolicy(uint64_t policyNumber);
+
+  /** The number of the last policy acknowledged by the MRT. */
+  uint64_t acknowledgedPolicy() const;
+
+ private:
+  struct SegmentHeader;
+  struct ChannelHeader;
+  struct SlotHeader;
+
+  ChannelHeader& channelHeader(Channel channel) const;
+  SlotHeader& slotHeader(const ChannelHeader& channelHeader, uint64_t number) const;
+
+  Settings settings_;
+  bool owner_;
+  int fileDescriptor_ = -1;
+  size_t size_ = 0;
+  char* data_ = nullptr;
+};
+
+/** Encodes the observation into the buffer. The memory of the buffer is reused. */
+void encodeObservation(const SystemObservation& observation, std::vector<char>& buffer);
+
+/** Decodes the observation from the buffer. The memory of the observation is reused. */
+void decodeObservation(const std::vector<char>& buffer, SystemObservation& observation);
+
+/** Encodes the target trajectories into the buffer. The memory of the buffer is reused. */
+void encodeTargetTrajectories(const TargetTrajectories& targetTrajectories, std::vector<char>& buffer);
+
+/** Decodes the target trajectories from the buffer. */
+void decodeTargetTrajectories(const std::vector<char>& buffer, TargetTrajectories& targetTrajectories);
+
+}  // namespace shared_memory
+}  // namespace ocs2
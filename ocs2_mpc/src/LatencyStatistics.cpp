@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/LatencyStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LatencyStatistics::LatencyStatistics(size_t capacity) : samples_(capacity) {
+  if (capacity == 0) {
+    throw std::runtime_error("[LatencyStatistics] The capacity should be positive.");
+  }
+  sortedSamples_.reserve(capacity);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LatencyStatistics::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  numSamples_ = 0;
+  nextIndex_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LatencyStatistics::addSample(scalar_t latency) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  samples_[nextIndex_] = latency;
+  nextIndex_ = (nextIndex_ + 1) % samples_.size();
+  numSamples_ = std::min(numSamples_ + 1, samples_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t LatencyStatistics::getNumSamples() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numSamples_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LatencyStatistics::getPercentile(scalar_t percentile) const {
+  if (percentile < 0.0 || percentile > 1.0) {
+    throw std::runtime_error("[LatencyStatistics::getPercentile] The percentile should be in the range [0, 1].");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (numSamples_ == 0) {
+    return 0.0;
+  }
+
+  // the samples are not sorted in place to keep their order in the ring buffer
+  sortedSamples_.assign(samples_.begin(), samples_.begin() + numSamples_);
+  const scalar_t rank = percentile * (numSamples_ - 1);
+  const auto lowerIndex = static_cast<size_t>(std::floor(rank));
+  const auto upperIndex = std::min(lowerIndex + 1, numSamples_ - 1);
+  std::nth_element(sortedSamples_.begin(), sortedSamples_.begin() + lowerIndex, sortedSamples_.end());
+  const scalar_t lower = sortedSamples_[lowerIndex];
+  const scalar_t upper =
+      (upperIndex == lowerIndex) ? lower : *std::min_element(sortedSamples_.begin() + upperIndex, sortedSamples_.end());
+  return lower + (rank - lowerIndex) * (upper - lower);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LatencyStatistics::getMean() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (numSamples_ == 0) {
+    return 0.0;
+  }
+  return std::accumulate(samples_.begin(), samples_.begin() + numSamples_, 0.0) / numSamples_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LatencyStatistics::getMax() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (numSamples_ == 0) {
+    return 0.0;
+  }
+  return *std::max_element(samples_.begin(), samples_.begin() + numSamples_);
+}
+
+}  // namespace ocs2
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 
 #include <ocs2_mpc/MPC_BASE.h>
 
@@ -51,6 +52,23 @@ void MPC_BASE::reset() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
+  return runImpl(currentTime, currentState, nullptr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState, const PrimalSolution& initialGuess) {
+  return runImpl(currentTime, currentState, &initialGuess);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::runImpl(scalar_t currentTime, const vector_t& currentState, const PrimalSolution* initialGuessPtr) {
+  // the time budget includes the preparation of the solver
+  const auto startTime = std::chrono::steady_clock::now();
+
   // check if the current time exceeds the solver final limit
   if (!initRun_ && currentTime >= getSolverPtr()->getFinalTime()) {
     std::cerr << "WARNING: The MPC time-horizon is smaller than the MPC starting time.\n";
@@ -72,7 +90,15 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   }
 
   // calculate the MPC policy
-  calculateController(currentTime, currentState, finalTime);
+  if (mpcSettings_.solveTimeBudget_ > 0.0) {
+    const auto timeBudget = std::chrono::duration<scalar_t>(mpcSettings_.solveTimeBudget_);
+    getSolverPtr()->setDeadline(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeBudget));
+  }
+  if (initialGuessPtr != nullptr) {
+    calculateController(currentTime, currentState, finalTime, *initialGuessPtr);
+  } else {
+    calculateController(currentTime, currentState, finalTime);
+  }
 
   // set initRun flag to false
   initRun_ = false;
@@ -83,7 +109,11 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     std::cerr << "\n### MPC Benchmarking";
     std::cerr << "\n###   Maximum : " << mpcTimer_.getMaxIntervalInMilliseconds() << "[ms].";
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
-    std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
+    std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms].";
+    if (getSolverPtr()->isTerminatedByDeadline()) {
+      std::cerr << "\n###   The solver has been terminated by the time budget.";
+    }
+    std::cerr << std::endl;
   }
 
   return true;
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MPC_MRT_Interface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
@@ -48,14 +50,19 @@ void MPC_MRT_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
   mpc_.reset();
   mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(initTargetTrajectories);
   mpcTimer_.reset();
+  latencyStatistics_.reset();
+  policyComputed_ = false;
+
+  const size_t stateDim = initTargetTrajectories.stateTrajectory.empty() ? 0 : initTargetTrajectories.stateTrajectory.front().size();
+  const size_t inputDim = initTargetTrajectories.inputTrajectory.empty() ? 0 : initTargetTrajectories.inputTrajectory.front().size();
+  observationSeqlock_.reserve(stateDim, inputDim);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_MRT_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
-  std::lock_guard<std::mutex> lock(observationMutex_);
-  currentObservation_ = currentObservation;
+  observationSeqlock_.write(currentObservation);
 }
 
 /******************************************************************************************************/
@@ -79,10 +86,12 @@ void MPC_MRT_Interface::advanceMpc() {
   // measure the delay in running MPC
   mpcTimer_.startTimer();
 
-  SystemObservation currentObservation;
-  {
-    std::lock_guard<std::mutex> lock(observationMutex_);
-    currentObservation = currentObservation_;
+  auto& currentObservation = mpcObservation_;
+  observationSeqlock_.read(currentObservation);
+
+  // optimize from the observation at the time the policy is expected to be applied
+  if (mpc_.settings().compensateDelay_) {
+    predictObservation(latencyStatistics_.getPercentile(mpc_.settings().delayPercentile_), currentObservation);
   }
 
   bool controllerIsUpdated = mpc_.run(currentObservation.time, currentObservation.state);
@@ -93,6 +102,7 @@ void MPC_MRT_Interface::advanceMpc() {
 
   // measure the delay for sending ROS messages
   mpcTimer_.endTimer();
+  latencyStatistics_.addSample(mpcTimer_.getLastIntervalInMilliseconds() * 1e-3);
 
   // check MPC delay and solution window compatibility
   scalar_t timeWindow = mpc_.settings().solutionTimeWindow_;
@@ -108,10 +118,47 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n### MPC_MRT Benchmarking";
     std::cerr << "\n###   Maximum : " << mpcTimer_.getMaxIntervalInMilliseconds() << "[ms].";
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
-    std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
+    std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms].";
+    std::cerr << "\n###   p50     : " << latencyStatistics_.getMedian() * 1e3 << "[ms].";
+    std::cerr << "\n###   p99     : " << latencyStatistics_.getP99() * 1e3 << "[ms]." << std::endl;
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::initDelayCompensation(const ControlledSystemBase& systemDynamics, scalar_t maxTimeStep) {
+  delayCompensationSessionPtr_.reset(new RolloutSession(systemDynamics, maxTimeStep));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MRT_Interface::predictObservation(scalar_t delay, SystemObservation& observation) {
+  // no prediction before the first policy
+  if (!policyComputed_ || delay <= 0.0) {
+    return;
+  }
+  if (delayCompensationSessionPtr_ == nullptr) {
+    throw std::runtime_error("[MPC_MRT_Interface::advanceMpc] The delay compensation is not initialized. Use initDelayCompensation()!");
+  }
+
+  const scalar_t finalTime = std::min(observation.time + delay, mpc_.getSolverPtr()->getFinalTime());
+  if (finalTime <= observation.time) {
+    return;
+  }
+
+  // only the final state and input are needed, hence the policy is integrated without recording the trajectories
+  mpc_.getSolverPtr()->getPrimalSolution(finalTime, &delayCompensationPolicy_);
+  delayCompensationSessionPtr_->reset(observation.time, observation.state, delayCompensationPolicy_.controllerPtr_.get());
+  delayCompensationSessionPtr_->advance(finalTime, delayCompensationPolicy_.modeSchedule_);
+
+  observation.time = finalTime;
+  observation.state = delayCompensationSessionPtr_->getState();
+  observation.input = delayCompensationSessionPtr_->getInput();
+  observation.mode = delayCompensationPolicy_.modeSchedule_.modeAtTime(finalTime);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -133,6 +180,7 @@ void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
   *performanceIndicesPtr = mpc_.getSolverPtr()->getPerformanceIndeces();
 
   this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  policyComputed_ = true;
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,169 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_SharedMemory_Interface.h"
+
+#include <iostream>
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_SharedMemory_Interface::MPC_SharedMemory_Interface(MPC_BASE& mpc, shared_memory::Settings settings)
+    : mpc_(mpc), segment_(std::move(settings), true) {
+  mpcTimer_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_SharedMemory_Interface::resetMpcNode(TargetTrajectories&& initTargetTrajectories) {
+  std::lock_guard<std::mutex> resetLock(resetMutex_);
+  mpc_.reset();
+  mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(std::move(initTargetTrajectories));
+  mpcTimer_.reset();
+  resetRequestedEver_ = true;
+  basePolicyNumber_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_SharedMemory_Interface::spinOnce() {
+  // reset request of the MRT
+  if (segment_.read(shared_memory::Channel::RESET, lastResetNumber_, messageBuffer_)) {
+    TargetTrajectories targetTrajectories;
+    shared_memory::decodeTargetTrajectories(messageBuffer_, targetTrajectories);
+    resetMpcNode(std::move(targetTrajectories));
+    segment_.acknowledgeReset(lastResetNumber_);
+    std::cerr << "[MPC_SharedMemory_Interface] MPC is reset.\n";
+  }
+
+  std::lock_guard<std::mutex> resetLock(resetMutex_);
+
+  if (!segment_.read(shared_memory::Channel::OBSERVATION, lastObservationNumber_, messageBuffer_)) {
+    return false;
+  }
+  if (!resetRequestedEver_) {
+    std::cerr << "[MPC_SharedMemory_Interface] MPC should be reset first. Either call resetMpcNode() or reset it from the MRT.\n";
+    return false;
+  }
+  shared_memory::decodeObservation(messageBuffer_, currentObservation_);
+
+  // measure the delay in running MPC
+  mpcTimer_.startTimer();
+
+  // run MPC
+  bool controllerIsUpdated = mpc_.run(currentObservation_.time, currentObservation_.state);
+  if (!controllerIsUpdated) {
+    return false;
+  }
+  publishPolicy(currentObservation_);
+
+  // measure the delay for publishing the policy
+  mpcTimer_.endTimer();
+
+  // check MPC delay and solution window compatibility
+  scalar_t timeWindow = mpc_.settings().solutionTimeWindow_;
+  if (mpc_.settings().solutionTimeWindow_ < 0) {
+    timeWindow = mpc_.getSolverPtr()->getFinalTime() - currentObservation_.time;
+  }
+  if (timeWindow < 2.0 * mpcTimer_.getAverageInMilliseconds() * 1e-3) {
+    std::cerr << "[MPC_SharedMemory_Interface::spinOnce] WARNING: The solution time window might be shorter than the MPC delay!\n";
+  }
+
+  // display
+  if (mpc_.settings().debugPrint_) {
+    std::cerr << "\n### MPC_SharedMemory Benchmarking";
+    std::cerr << "\n###   Maximum : " << mpcTimer_.getMaxIntervalInMilliseconds() << "[ms].";
+    std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
+    std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_SharedMemory_Interface::spin() {
+  terminate_ = false;
+  while (!terminate_) {
+    if (!spinOnce()) {
+      shared_memory::waitForPollingPeriod(segment_.settings());
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_SharedMemory_Interface::publishPolicy(const SystemObservation& mpcInitObservation) {
+  // policy
+  const scalar_t startTime = mpcInitObservation.time;
+  const scalar_t finalTime =
+      (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
+  mpc_.getSolverPtr()->getPrimalSolution(finalTime, &primalSolution_);
+
+  // command
+  commandData_.mpcInitObservation_ = mpcInitObservation;
+  commandData_.mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
+
+  const auto& performanceIndex = mpc_.getSolverPtr()->getPerformanceIndeces();
+
+  // a delta against the base policy if the MRT holds it and the delta pays off
+  const auto& settings = segment_.settings();
+  if (settings.deltaPolicyUpdates_ && basePolicyNumber_ > 0 && segment_.acknowledgedPolicy() == basePolicyNumber_) {
+    const bool isEncoded =
+        policy_serialization::encodePolicyDelta(basePrimalSolution_, basePolicyNumber_, primalSolution_, commandData_, performanceIndex,
+                                                deltaBuffer_, settings.deltaPolicyTolerance_);
+    if (isEncoded) {
+      const auto deltaHeader = policy_serialization::readDeltaHeader(deltaBuffer_.data(), deltaBuffer_.size());
+      if (2 * deltaHeader.size < deltaHeader.policySize) {
+        basePolicyNumber_ = segment_.write(shared_memory::Channel::POLICY, deltaBuffer_.data(), deltaBuffer_.size());
+        // the base policy follows the one reconstructed by the MRT, so that the changes below the tolerance do not accumulate
+        policy_serialization::applyPolicyDelta(deltaBuffer_.data(), deltaBuffer_.size(), basePrimalSolution_, baseCommandData_,
+                                               basePerformanceIndex_);
+        return;
+      }
+    }
+  }
+
+  policy_serialization::encodePolicy(primalSolution_, commandData_, performanceIndex, policyBuffer_);
+  basePolicyNumber_ = segment_.write(shared_memory::Channel::POLICY, policyBuffer_.data(), policyBuffer_.size());
+  if (settings.deltaPolicyUpdates_) {
+    policy_serialization::decodePolicy(policy_serialization::PolicyView(policyBuffer_), basePrimalSolution_, baseCommandData_,
+                                       basePerformanceIndex_);
+  }
+}
+
+}  // namespace ocs2
@@ -56,6 +56,8 @@ void MRT_BASE::reset() {
   bufferPrimalSolutionPtr_.reset();
   activePerformanceIndicesPtr_.reset();
   bufferPerformanceIndicesPtr_.reset();
+  deferredPolicyUpdate_ = nullptr;
+  rolloutSessionOutdated_ = true;
 }
 
 /******************************************************************************************************/
@@ -98,6 +100,14 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
   rolloutPtr_.reset(rolloutPtr->clone());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::initRolloutSession(const ControlledSystemBase& systemDynamics, scalar_t maxTimeStep) {
+  rolloutSessionPtr_.reset(new RolloutSession(systemDynamics, maxTimeStep));
+  rolloutSessionOutdated_ = true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -123,7 +133,7 @@ void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState
 /******************************************************************************************************/
 void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState, const scalar_t& timeStep, vector_t& mpcState,
                              vector_t& mpcInput, size_t& mode) {
-  if (rolloutPtr_ == nullptr) {
+  if (rolloutPtr_ == nullptr && rolloutSessionPtr_ == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
@@ -136,6 +146,19 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
               << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
   }
 
+  // continue the rollout session if the caller continues from its end
+  if (rolloutSessionPtr_ != nullptr) {
+    if (rolloutSessionOutdated_ || !rolloutSessionPtr_->isAt(currentTime, currentState)) {
+      rolloutSessionPtr_->reset(currentTime, currentState, activePrimalSolutionPtr_->controllerPtr_.get());
+      rolloutSessionOutdated_ = false;
+    }
+    rolloutSessionPtr_->advance(currentTime + timeStep, activePrimalSolutionPtr_->modeSchedule_);
+    mpcState = rolloutSessionPtr_->getState();
+    mpcInput = rolloutSessionPtr_->getInput();
+    mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(rolloutSessionPtr_->getTime());
+    return;
+  }
+
   // perform a rollout
   scalar_array_t timeTrajectory;
   size_array_t postEventIndicesStock;
@@ -163,6 +186,16 @@ bool MRT_BASE::updatePolicy() {
       activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
       activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
       newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
+      rolloutSessionOutdated_ = true;
+
+      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
+      return true;
+    } else if (deferredPolicyUpdate_) {
+      // update the active solution in place
+      const auto update = std::move(deferredPolicyUpdate_);
+      deferredPolicyUpdate_ = nullptr;
+      update(*activeCommandPtr_, *activePrimalSolutionPtr_, *activePerformanceIndicesPtr_);
+      rolloutSessionOutdated_ = true;
 
       modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
       return true;
@@ -184,20 +217,28 @@ bool MRT_BASE::updatePolicy() {
 /******************************************************************************************************/
 void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                             std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
+  // the old objects are destroyed at the end of this scope, i.e., after releasing the lock.
+  swapWithBuffer(commandDataPtr, primalSolutionPtr, performanceIndicesPtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::swapWithBuffer(std::unique_ptr<CommandData>& commandDataPtr, std::unique_ptr<PrimalSolution>& primalSolutionPtr,
+                              std::unique_ptr<PerformanceIndex>& performanceIndicesPtr) {
   if (commandDataPtr == nullptr) {
-    throw std::runtime_error("[MRT_BASE::moveToBuffer] commandDataPtr cannot be a null pointer!");
+    throw std::runtime_error("[MRT_BASE::swapWithBuffer] commandDataPtr cannot be a null pointer!");
   }
 
   if (primalSolutionPtr == nullptr) {
-    throw std::runtime_error("[MRT_BASE::moveToBuffer] primalSolutionPtr cannot be a null pointer!");
+    throw std::runtime_error("[MRT_BASE::swapWithBuffer] primalSolutionPtr cannot be a null pointer!");
   }
 
   if (performanceIndicesPtr == nullptr) {
-    throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
+    throw std::runtime_error("[MRT_BASE::swapWithBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
   std::lock_guard<std::mutex> lk(bufferMutex_);
-  // use swap such that the old objects are destroyed after releasing the lock.
   bufferCommandPtr_.swap(commandDataPtr);
   bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
   bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
@@ -207,6 +248,32 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
 
   newPolicyInBuffer_ = true;
   policyReceivedEver_ = true;
+  deferredPolicyUpdate_ = nullptr;  // the update of an older policy
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MRT_BASE::updateLatestPolicy(PolicyUpdate update) {
+  std::lock_guard<std::mutex> lk(bufferMutex_);
+  if (!policyReceivedEver_ || deferredPolicyUpdate_ || !observerPtrArray_.empty()) {
+    return false;
+  }
+
+  if (newPolicyInBuffer_) {
+    update(*bufferCommandPtr_, *bufferPrimalSolutionPtr_, *bufferPerformanceIndicesPtr_);
+  } else {
+    deferredPolicyUpdate_ = std::move(update);
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MRT_BASE::hasDeferredPolicyUpdate() const {
+  std::lock_guard<std::mutex> lk(bufferMutex_);
+  return static_cast<bool>(deferredPolicyUpdate_);
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MRT_SharedMemory_Interface.h"
+
+#include <algorithm>
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MRT_SharedMemory_Interface::MRT_SharedMemory_Interface(shared_memory::Settings settings) : segment_(std::move(settings), false) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MRT_SharedMemory_Interface::~MRT_SharedMemory_Interface() {
+  shutdownSpinner();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_SharedMemory_Interface::resetMpcNode(const TargetTrajectories& initTargetTrajectories) {
+  this->reset();
+
+  std::vector<char> buffer;
+  shared_memory::encodeTargetTrajectories(initTargetTrajectories, buffer);
+  const auto resetNumber = segment_.write(shared_memory::Channel::RESET, buffer.data(), buffer.size());
+
+  while (segment_.acknowledgedReset() < resetNumber) {
+    shared_memory::waitForPollingPeriod(segment_.settings());
+  }
+
+  // the policies published before the reset are outdated
+  std::lock_guard<std::mutex> lock(policyMutex_);
+  lastPolicyNumber_ = std::max(lastPolicyNumber_, segment_.policyNumberAtReset());
+  latestPolicyNumber_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_SharedMemory_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
+  std::lock_guard<std::mutex> lock(observationMutex_);
+  shared_memory::encodeObservation(currentObservation, observationBuffer_);
+  segment_.write(shared_memory::Channel::OBSERVATION, observationBuffer_.data(), observationBuffer_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MRT_SharedMemory_Interface::spinMRT() {
+  std::lock_guard<std::mutex> lock(policyMutex_);
+  if (!segment_.read(shared_memory::Channel::POLICY, lastPolicyNumber_, messageBuffer_)) {
+    return false;
+  }
+
+  if (policy_serialization::isPolicyDelta(messageBuffer_.data(), messageBuffer_.size())) {
+    // if the base policy is missed or the delta buffer is still used by a deferred update, the MPC publishes a full policy next
+    const auto deltaHeader = policy_serialization::readDeltaHeader(messageBuffer_.data(), messageBuffer_.size());
+    if (latestPolicyNumber_ == 0 || deltaHeader.baseNumber != latestPolicyNumber_ || this->hasDeferredPolicyUpdate()) {
+      return false;
+    }
+
+    // the changed nodes are applied in place to the latest policy
+    deltaBuffer_.swap(messageBuffer_);
+    const bool isUpdated = this->updateLatestPolicy([this](CommandData& commandData, PrimalSolution& primalSolution,
+                                                           PerformanceIndex& performanceIndex) {
+      policy_serialization::applyPolicyDelta(deltaBuffer_.data(), deltaBuffer_.size(), primalSolution, commandData, performanceIndex);
+    });
+    if (!isUpdated) {
+      return false;
+    }
+
+  } else {
+    if (decodedCommandPtr_ == nullptr) {
+      decodedCommandPtr_.reset(new CommandData);
+    }
+    if (decodedPrimalSolutionPtr_ == nullptr) {
+      decodedPrimalSolutionPtr_.reset(new PrimalSolution);
+    }
+    if (decodedPerformanceIndexPtr_ == nullptr) {
+      decodedPerformanceIndexPtr_.reset(new PerformanceIndex);
+    }
+    policy_serialization::decodePolicy(policy_serialization::PolicyView(messageBuffer_), *decodedPrimalSolutionPtr_, *decodedCommandPtr_,
+                                       *decodedPerformanceIndexPtr_);
+
+    // the objects previously in the buffer are decoded into on the next message
+    this->swapWithBuffer(decodedCommandPtr_, decodedPrimalSolutionPtr_, decodedPerformanceIndexPtr_);
+  }
+
+  // the MRT observers may modify the policies, hence the deltas are only requested without them
+  latestPolicyNumber_ = lastPolicyNumber_;
+  if (!this->hasMrtObservers()) {
+    segment_.acknowledgePolicy(latestPolicyNumber_);
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_SharedMemory_Interface::launchSpinner() {
+  shutdownSpinner();
+  terminateSpinner_ = false;
+  spinnerWorker_ = std::thread([this]() {
+    while (!terminateSpinner_) {
+      if (!spinMRT()) {
+        shared_memory::waitForPollingPeriod(segment_.settings());
+      }
+    }
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_SharedMemory_Interface::shutdownSpinner() {
+  terminateSpinner_ = true;
+  if (spinnerWorker_.joinable()) {
+    spinnerWorker_.join();
+  }
+}
+
+}  // namespace ocs2
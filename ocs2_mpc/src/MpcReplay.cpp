@@ -0,0 +1,312 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MpcReplay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+#include "ocs2_mpc/LatencyStatistics.h"
+#include "ocs2_mpc/MPC_MRT_Interface.h"
+#include "ocs2_mpc/SharedMemoryTransport.h"
+
+namespace ocs2 {
+namespace mpc_replay {
+
+namespace {
+
+constexpr uint32_t logMagicNumber = 0x4f43524c;  // "OCRL"
+constexpr uint32_t logVersion = 1;
+
+enum RecordType : uint32_t { OBSERVATION = 0, TARGET_TRAJECTORIES = 1, MODE_SCHEDULE = 2 };
+
+template <typename T>
+void appendValue(const T& value, std::vector<char>& buffer) {
+  const size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T readValue(const std::vector<char>& buffer, size_t& offset) {
+  if (offset + sizeof(T) > buffer.size()) {
+    throw std::runtime_error("[mpc_replay::loadLog] The mode schedule record is truncated!");
+  }
+  T value;
+  std::memcpy(&value, buffer.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+
+void encodeModeSchedule(const ModeSchedule& modeSchedule, std::vector<char>& buffer) {
+  buffer.clear();
+  appendValue(static_cast<uint64_t>(modeSchedule.eventTimes.size()), buffer);
+  for (const auto& eventTime : modeSchedule.eventTimes) {
+    appendValue(eventTime, buffer);
+  }
+  appendValue(static_cast<uint64_t>(modeSchedule.modeSequence.size()), buffer);
+  for (const auto& mode : modeSchedule.modeSequence) {
+    appendValue(static_cast<uint64_t>(mode), buffer);
+  }
+}
+
+ModeSchedule decodeModeSchedule(const std::vector<char>& buffer) {
+  size_t offset = 0;
+  std::vector<scalar_t> eventTimes(readValue<uint64_t>(buffer, offset));
+  for (auto& eventTime : eventTimes) {
+    eventTime = readValue<scalar_t>(buffer, offset);
+  }
+  std::vector<size_t> modeSequence(readValue<uint64_t>(buffer, offset));
+  for (auto& mode : modeSequence) {
+    mode = readValue<uint64_t>(buffer, offset);
+  }
+  return {std::move(eventTimes), std::move(modeSequence)};
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LogWriter::LogWriter(const std::string& fileName) : fileName_(fileName), file_(fileName, std::ios::binary | std::ios::trunc) {
+  if (!file_) {
+    throw std::runtime_error("[LogWriter::LogWriter] Could not open " + fileName_ + "!");
+  }
+  file_.write(reinterpret_cast<const char*>(&logMagicNumber), sizeof(logMagicNumber));
+  file_.write(reinterpret_cast<const char*>(&logVersion), sizeof(logVersion));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LogWriter::writeObservation(const SystemObservation& observation) {
+  shared_memory::encodeObservation(observation, buffer_);
+  writeRecord(OBSERVATION);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LogWriter::writeTargetTrajectories(const TargetTrajectories& targetTrajectories) {
+  shared_memory::encodeTargetTrajectories(targetTrajectories, buffer_);
+  writeRecord(TARGET_TRAJECTORIES);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LogWriter::writeModeSchedule(const ModeSchedule& modeSchedule) {
+  encodeModeSchedule(modeSchedule, buffer_);
+  writeRecord(MODE_SCHEDULE);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LogWriter::writeCycle(const Cycle& cycle) {
+  if (cycle.hasTargetTrajectories) {
+    writeTargetTrajectories(cycle.targetTrajectories);
+  }
+  if (cycle.hasModeSchedule) {
+    writeModeSchedule(cycle.modeSchedule);
+  }
+  writeObservation(cycle.observation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LogWriter::flush() {
+  file_.flush();
+  if (!file_) {
+    throw std::runtime_error("[LogWriter::flush] Could not write to " + fileName_ + "!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LogWriter::writeRecord(uint32_t type) {
+  const auto size = static_cast<uint64_t>(buffer_.size());
+  file_.write(reinterpret_cast<const char*>(&type), sizeof(type));
+  file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  file_.write(buffer_.data(), buffer_.size());
+  if (!file_) {
+    throw std::runtime_error("[LogWriter::writeRecord] Could not write to " + fileName_ + "!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<Cycle> loadLog(const std::string& fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("[mpc_replay::loadLog] Could not open " + fileName + "!");
+  }
+
+  uint32_t magicNumber = 0;
+  uint32_t version = 0;
+  file.read(reinterpret_cast<char*>(&magicNumber), sizeof(magicNumber));
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  if (!file || magicNumber != logMagicNumber) {
+    throw std::runtime_error("[mpc_replay::loadLog] " + fileName + " is not a replay log!");
+  }
+  if (version != logVersion) {
+    throw std::runtime_error("[mpc_replay::loadLog] " + fileName + " has the unsupported version " + std::to_string(version) + "!");
+  }
+
+  std::vector<Cycle> cycles;
+  Cycle cycle;
+  std::vector<char> buffer;
+  uint32_t type = 0;
+  while (file.read(reinterpret_cast<char*>(&type), sizeof(type))) {
+    uint64_t size = 0;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    buffer.resize(size);
+    file.read(buffer.data(), size);
+    if (!file) {
+      throw std::runtime_error("[mpc_replay::loadLog] " + fileName + " ends with a truncated record!");
+    }
+
+    switch (type) {
+      case OBSERVATION:
+        shared_memory::decodeObservation(buffer, cycle.observation);
+        cycles.push_back(std::move(cycle));
+        cycle = Cycle();
+        break;
+      case TARGET_TRAJECTORIES:
+        shared_memory::decodeTargetTrajectories(buffer, cycle.targetTrajectories);
+        cycle.hasTargetTrajectories = true;
+        break;
+      case MODE_SCHEDULE:
+        cycle.modeSchedule = decodeModeSchedule(buffer);
+        cycle.hasModeSchedule = true;
+        break;
+      default:
+        throw std::runtime_error("[mpc_replay::loadLog] " + fileName + " has a record of the unknown type " + std::to_string(type) + "!");
+    }
+  }
+
+  return cycles;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<CycleStatistics> replay(MPC_BASE& mpc, const std::vector<Cycle>& cycles) {
+  if (cycles.empty()) {
+    return {};
+  }
+  if (!cycles.front().hasTargetTrajectories) {
+    throw std::runtime_error("[mpc_replay::replay] The first MPC cycle should have target trajectories to reset the MPC!");
+  }
+
+  MPC_MRT_Interface mpcMrtInterface(mpc);
+  mpcMrtInterface.resetMpcNode(cycles.front().targetTrajectories);
+  auto& referenceManager = mpcMrtInterface.getReferenceManager();
+  const auto& solver = *mpc.getSolverPtr();
+
+  std::vector<CycleStatistics> statistics;
+  statistics.reserve(cycles.size());
+  for (size_t i = 0; i < cycles.size(); i++) {
+    const auto& cycle = cycles[i];
+    if (cycle.hasModeSchedule) {
+      referenceManager.setModeSchedule(cycle.modeSchedule);
+    }
+    if (cycle.hasTargetTrajectories && i > 0) {
+      referenceManager.setTargetTrajectories(cycle.targetTrajectories);
+    }
+    mpcMrtInterface.setCurrentObservation(cycle.observation);
+
+    const size_t numIterationsBefore = solver.getNumIterations();
+    const auto startTime = std::chrono::steady_clock::now();
+    mpcMrtInterface.advanceMpc();
+    const auto finishTime = std::chrono::steady_clock::now();
+
+    CycleStatistics cycleStatistics;
+    cycleStatistics.time = cycle.observation.time;
+    cycleStatistics.latency = std::chrono::duration<scalar_t>(finishTime - startTime).count();
+    cycleStatistics.numIterations = solver.getNumIterations() - numIterationsBefore;
+    cycleStatistics.cost = solver.getPerformanceIndeces().cost;
+    cycleStatistics.merit = solver.getPerformanceIndeces().merit;
+    cycleStatistics.terminatedByDeadline = solver.isTerminatedByDeadline();
+    statistics.push_back(cycleStatistics);
+  }
+
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeStatistics(const std::vector<CycleStatistics>& statistics, std::ostream& stream) {
+  stream << "time,latency,numIterations,cost,merit,terminatedByDeadline\n";
+  stream << std::setprecision(std::numeric_limits<scalar_t>::max_digits10);
+  for (const auto& s : statistics) {
+    stream << s.time << ',' << s.latency << ',' << s.numIterations << ',' << s.cost << ',' << s.merit << ',' << s.terminatedByDeadline
+           << '\n';
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void printSummary(const std::vector<CycleStatistics>& statistics, std::ostream& stream) {
+  LatencyStatistics latencyStatistics(std::max<size_t>(statistics.size(), 1));
+  size_t totalNumIterations = 0;
+  size_t numTerminatedByDeadline = 0;
+  scalar_t totalCost = 0.0;
+  for (const auto& s : statistics) {
+    latencyStatistics.addSample(s.latency);
+    totalNumIterations += s.numIterations;
+    numTerminatedByDeadline += s.terminatedByDeadline ? 1 : 0;
+    totalCost += s.cost;
+  }
+  const auto numCycles = std::max<size_t>(statistics.size(), 1);
+
+  stream << "\n###################";
+  stream << "\n### MPC Replay ####";
+  stream << "\n###################\n";
+  stream << "Number of MPC cycles:        " << statistics.size() << '\n';
+  stream << "Latency mean [ms]:           " << 1e3 * latencyStatistics.getMean() << '\n';
+  stream << "Latency p50 [ms]:            " << 1e3 * latencyStatistics.getMedian() << '\n';
+  stream << "Latency p99 [ms]:            " << 1e3 * latencyStatistics.getP99() << '\n';
+  stream << "Latency max [ms]:            " << 1e3 * latencyStatistics.getMax() << '\n';
+  stream << "Iterations per cycle:        " << static_cast<scalar_t>(totalNumIterations) / numCycles << '\n';
+  stream << "Cost per cycle:              " << totalCost / numCycles << '\n';
+  stream << "Terminated by the deadline:  " << numTerminatedByDeadline << '\n';
+}
+
+}  // namespace mpc_replay
+}  // namespace ocs2
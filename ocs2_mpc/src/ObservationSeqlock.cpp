@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/ObservationSeqlock.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ObservationSeqlock::ObservationSeqlock() {
+  reserve(0, 0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ObservationSeqlock::reserve(size_t stateDim, size_t inputDim) {
+  std::lock_guard<std::mutex> lock(writeMutex_);
+  slotStorage_.clear();
+  slotStorage_.emplace_back(new Slot(stateDim + inputDim));
+  slotPtr_.store(slotStorage_.back().get(), std::memory_order_release);
+  numWrites_.store(0, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ObservationSeqlock::write(const SystemObservation& observation) {
+  const size_t stateDim = observation.state.size();
+  const size_t inputDim = observation.input.size();
+
+  std::lock_guard<std::mutex> lock(writeMutex_);
+
+  // a larger slot replaces the current one, which is kept alive for the concurrent readers
+  Slot* slotPtr = slotPtr_.load(std::memory_order_relaxed);
+  if (slotPtr->data.size() < stateDim + inputDim) {
+    slotStorage_.emplace_back(new Slot(stateDim + inputDim));
+    slotPtr = slotStorage_.back().get();
+  }
+
+  // an odd sequence marks the slot as being written
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slotPtr->mode = observation.mode;
+  slotPtr->time = observation.time;
+  slotPtr->stateDim = stateDim;
+  slotPtr->inputDim = inputDim;
+  std::memcpy(slotPtr->data.data(), observation.state.data(), stateDim * sizeof(scalar_t));
+  std::memcpy(slotPtr->data.data() + stateDim, observation.input.data(), inputDim * sizeof(scalar_t));
+  // the release publishes a newly allocated slot to the readers which acquire the pointer
+  slotPtr_.store(slotPtr, std::memory_order_release);
+  numWrites_.fetch_add(1, std::memory_order_relaxed);
+
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t ObservationSeqlock::read(SystemObservation& observation) const {
+  while (true) {
+    const uint64_t sequenceBefore = sequence_.load(std::memory_order_acquire);
+    if (sequenceBefore % 2 != 0) {
+      continue;  // a write is in progress
+    }
+
+    const uint64_t numWrites = numWrites_.load(std::memory_order_relaxed);
+    if (numWrites == 0) {
+      return 0;
+    }
+
+    // the dimensions might be torn by a concurrent write, they are bounded by the capacity to keep the copy in the slot
+    const Slot* slotPtr = slotPtr_.load(std::memory_order_acquire);
+    const size_t capacity = slotPtr->data.size();
+    const size_t stateDim = std::min(slotPtr->stateDim, capacity);
+    const size_t inputDim = std::min(slotPtr->inputDim, capacity - stateDim);
+    observation.mode = slotPtr->mode;
+    observation.time = slotPtr->time;
+    observation.state.resize(stateDim);
+    observation.input.resize(inputDim);
+    std::memcpy(observation.state.data(), slotPtr->data.data(), stateDim * sizeof(scalar_t));
+    std::memcpy(observation.input.data(), slotPtr->data.data() + stateDim, inputDim * sizeof(scalar_t));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) == sequenceBefore) {
+      return numWrites;
+    }
+  }
+}
+
+}  // namespace ocs2
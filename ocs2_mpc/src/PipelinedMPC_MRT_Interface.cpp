@@ -0,0 +1,278 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PipelinedMPC_MRT_Interface.h"
+
+#include <utility>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PipelinedMPC_MRT_Interface::PipelinedMPC_MRT_Interface(std::vector<std::unique_ptr<MPC_BASE>> mpcPtrs) {
+  if (mpcPtrs.empty()) {
+    throw std::runtime_error("[PipelinedMPC_MRT_Interface] At least one MPC instance is required.");
+  }
+  for (auto& mpcPtr : mpcPtrs) {
+    if (mpcPtr == nullptr) {
+      throw std::runtime_error("[PipelinedMPC_MRT_Interface] The MPC instances cannot be null pointers.");
+    }
+    instances_.emplace_back(new Instance);
+    instances_.back()->mpcPtr = std::move(mpcPtr);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PipelinedMPC_MRT_Interface::~PipelinedMPC_MRT_Interface() {
+  shutdown();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::resetMpcNode(const TargetTrajectories& initTargetTrajectories) {
+  // wait for the running solves
+  std::vector<std::unique_lock<std::mutex>> instanceLocks;
+  for (auto& instance : instances_) {
+    instanceLocks.emplace_back(instance->mutex);
+  }
+
+  for (auto& instance : instances_) {
+    instance->mpcPtr->reset();
+    instance->mpcPtr->getSolverPtr()->getReferenceManager().setTargetTrajectories(initTargetTrajectories);
+    instance->lastSolvedNumber = 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(solutionMutex_);
+    latestSolutionPtr_.reset();
+    latestSolutionNumber_ = 0;
+  }
+
+  latencyStatistics_.reset();
+  solveTimeStatistics_.reset();
+  numDiscardedSolutions_ = 0;
+
+  // the current observation is solved again
+  {
+    std::lock_guard<std::mutex> lock(observationMutex_);
+    lastStartedObservationNumber_ = (observationNumber_ > 0) ? observationNumber_ - 1 : 0;
+    nextStartTime_ = clock::now();
+  }
+  observationUpdated_.notify_all();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
+  rethrowWorkerException();
+  {
+    std::lock_guard<std::mutex> lock(observationMutex_);
+    currentObservation_ = currentObservation;
+    observationNumber_++;
+    observationTime_ = clock::now();
+  }
+  observationUpdated_.notify_one();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PipelinedMPC_MRT_Interface::updatePolicy() {
+  rethrowWorkerException();
+  return MRT_BASE::updatePolicy();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::rethrowWorkerException() {
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(observationMutex_);
+    std::swap(exception, workerException_);
+  }
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::launch() {
+  shutdown();
+  terminate_ = false;
+  for (auto& instance : instances_) {
+    workers_.emplace_back([this, &instance]() { runInstance(*instance); });
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(observationMutex_);
+    terminate_ = true;
+  }
+  observationUpdated_.notify_all();
+
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PipelinedMPC_MRT_Interface::clock::duration PipelinedMPC_MRT_Interface::getStartSpacing() const {
+  const auto& settings = instances_.front()->mpcPtr->settings();
+  const scalar_t spacing = (settings.mpcDesiredFrequency_ > 0.0) ? 1.0 / settings.mpcDesiredFrequency_
+                                                                 : solveTimeStatistics_.getMedian() / instances_.size();
+  return std::chrono::duration_cast<clock::duration>(std::chrono::duration<scalar_t>(spacing));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::runInstance(Instance& instance) {
+  auto& mpc = *instance.mpcPtr;
+
+  while (true) {
+    // wait for a new observation and the next start time
+    SystemObservation observation;
+    uint64_t observationNumber;
+    clock::time_point observationTime;
+    {
+      std::unique_lock<std::mutex> lock(observationMutex_);
+      while (!terminate_) {
+        if (observationNumber_ <= lastStartedObservationNumber_) {
+          observationUpdated_.wait(lock);
+        } else if (clock::now() < nextStartTime_) {
+          observationUpdated_.wait_until(lock, nextStartTime_);
+        } else {
+          break;
+        }
+      }
+      if (terminate_) {
+        return;
+      }
+      observation = currentObservation_;
+      observationNumber = observationNumber_;
+      observationTime = observationTime_;
+      lastStartedObservationNumber_ = observationNumber_;
+      nextStartTime_ = clock::now() + getStartSpacing();
+    }
+
+    std::lock_guard<std::mutex> instanceLock(instance.mutex);
+
+    // initialize by the most recent solution if it is not the one of this instance
+    std::shared_ptr<const PrimalSolution> initialGuessPtr;
+    {
+      std::lock_guard<std::mutex> lock(solutionMutex_);
+      if (latestSolutionNumber_ > instance.lastSolvedNumber) {
+        initialGuessPtr = latestSolutionPtr_;
+      }
+    }
+
+    try {
+      const auto solveStartTime = clock::now();
+      const bool controllerIsUpdated = (initialGuessPtr != nullptr) ? mpc.run(observation.time, observation.state, *initialGuessPtr)
+                                                                    : mpc.run(observation.time, observation.state);
+      solveTimeStatistics_.addSample(std::chrono::duration<scalar_t>(clock::now() - solveStartTime).count());
+      instance.lastSolvedNumber = observationNumber;
+
+      if (controllerIsUpdated) {
+        publishSolution(mpc, observation, observationNumber, observationTime);
+      }
+
+    } catch (...) {
+      // the pipeline stops and the exception is rethrown in the thread of the user
+      {
+        std::lock_guard<std::mutex> lock(observationMutex_);
+        if (workerException_ == nullptr) {
+          workerException_ = std::current_exception();
+        }
+        terminate_ = true;
+      }
+      observationUpdated_.notify_all();
+      return;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipelinedMPC_MRT_Interface::publishSolution(MPC_BASE& mpc, const SystemObservation& observation, uint64_t observationNumber,
+                                                 clock::time_point observationTime) {
+  std::lock_guard<std::mutex> lock(solutionMutex_);
+
+  // a solve of a more recent observation has already finished
+  if (observationNumber <= latestSolutionNumber_) {
+    numDiscardedSolutions_++;
+    return;
+  }
+
+  const auto* solverPtr = mpc.getSolverPtr();
+
+  // policy
+  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+  const scalar_t finalTime =
+      (mpc.settings().solutionTimeWindow_ < 0) ? solverPtr->getFinalTime() : observation.time + mpc.settings().solutionTimeWindow_;
+  solverPtr->getPrimalSolution(finalTime, primalSolutionPtr.get());
+
+  // command
+  std::unique_ptr<CommandData> commandPtr(new CommandData);
+  commandPtr->mpcInitObservation_ = observation;
+  commandPtr->mpcTargetTrajectories_ = solverPtr->getReferenceManager().getTargetTrajectories();
+
+  // performance indices
+  std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
+  *performanceIndicesPtr = solverPtr->getPerformanceIndeces();
+
+  // the solution over the whole horizon initializes the next solves of the other instances
+  std::shared_ptr<PrimalSolution> latestSolutionPtr(new PrimalSolution);
+  solverPtr->getPrimalSolution(solverPtr->getFinalTime(), latestSolutionPtr.get());
+  latestSolutionPtr_ = std::move(latestSolutionPtr);
+  latestSolutionNumber_ = observationNumber;
+
+  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  latencyStatistics_.addSample(std::chrono::duration<scalar_t>(clock::now() - observationTime).count());
+}
+
+}  // namespace ocs2
@@ -0,0 +1,837 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+namespace policy_serialization {
+
+namespace {
+
+constexpr size_t alignment = 8;
+static_assert(sizeof(Header) % alignment == 0, "The sections following the header should be aligned.");
+static_assert(sizeof(DeltaHeader) % alignment == 0, "The sections following the delta header should be aligned.");
+
+/** The maximum time difference of a node and its base node in a policy delta. */
+constexpr scalar_t deltaTimeTolerance = 1e-9;
+
+size_t alignOffset(size_t offset) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+T* sectionPtr(char* data, size_t offset) {
+  return reinterpret_cast<T*>(data + offset);
+}
+
+template <typename T>
+const T* sectionPtr(const char* data, size_t offset) {
+  return reinterpret_cast<const T*>(data + offset);
+}
+
+/** Returns the common size of the vectors of the array and throws if the sizes differ. */
+size_t commonSize(const vector_array_t& array, const std::string& name) {
+  const size_t size = array.empty() ? 0 : array.front().size();
+  for (const auto& v : array) {
+    if (static_cast<size_t>(v.size()) != size) {
+      throw std::runtime_error("[policy_serialization::encodePolicy] The vectors of " + name + " should have the same size.");
+    }
+  }
+  return size;
+}
+
+/** Writes the vectors of the array column-wise into the section at dst. */
+void writeVectorArray(const vector_array_t& array, size_t size, scalar_t* dst) {
+  for (const auto& v : array) {
+    std::copy(v.data(), v.data() + size, dst);
+    dst += size;
+  }
+}
+
+/** Reads the columns of the matrix into the array while reusing the memory of its vectors. */
+void readVectorArray(const PolicyView::const_matrix_map_t& matrix, vector_array_t& array) {
+  array.resize(matrix.cols());
+  for (size_t k = 0; k < array.size(); k++) {
+    array[k] = matrix.col(k);
+  }
+}
+
+/** Validates the policy and creates its header, including the size of its encoding. */
+Header createHeader(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndex,
+                    bool quantizeGains) {
+  if (primalSolution.controllerPtr_ == nullptr) {
+    throw std::runtime_error("[policy_serialization::encodePolicy] The primal solution has no controller.");
+  }
+  const auto controllerType = primalSolution.controllerPtr_->getType();
+  if (controllerType != ControllerType::FEEDFORWARD && controllerType != ControllerType::LINEAR) {
+    throw std::runtime_error("[policy_serialization::encodePolicy] Only feedforward and linear controllers are supported.");
+  }
+
+  const size_t N = primalSolution.timeTrajectory_.size();
+  if (primalSolution.stateTrajectory_.size() != N || primalSolution.inputTrajectory_.size() != N) {
+    throw std::runtime_error(
+        "[policy_serialization::encodePolicy] The state and input trajectories should have the size of the time trajectory.");
+  }
+  const auto& observation = commandData.mpcInitObservation_;
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  const size_t numTargetNodes = targetTrajectories.timeTrajectory.size();
+  if (targetTrajectories.stateTrajectory.size() != numTargetNodes ||
+      (!targetTrajectories.inputTrajectory.empty() && targetTrajectories.inputTrajectory.size() != numTargetNodes)) {
+    throw std::runtime_error(
+        "[policy_serialization::encodePolicy] The target trajectories should have the size of their time trajectory.");
+  }
+
+  Header header{};
+  header.magic = magicNumber;
+  header.version = formatVersion;
+  header.flags = (quantizeGains && controllerType == ControllerType::LINEAR) ? quantizedGainsFlag : 0;
+  header.controllerType = static_cast<uint32_t>(controllerType);
+  header.numNodes = N;
+  header.stateDim = commonSize(primalSolution.stateTrajectory_, "state trajectory");
+  header.inputDim = commonSize(primalSolution.inputTrajectory_, "input trajectory");
+  header.numPostEventIndices = primalSolution.postEventIndices_.size();
+  header.numModes = primalSolution.modeSchedule_.modeSequence.size();
+  header.observationStateDim = observation.state.size();
+  header.observationInputDim = observation.input.size();
+  header.numTargetNodes = numTargetNodes;
+  header.targetStateDim = commonSize(targetTrajectories.stateTrajectory, "target state trajectory");
+  header.targetInputDim = commonSize(targetTrajectories.inputTrajectory, "target input trajectory");
+  header.observationMode = observation.mode;
+  header.observationTime = observation.time;
+  header.performanceIndex[0] = performanceIndex.merit;
+  header.performanceIndex[1] = performanceIndex.cost;
+  header.performanceIndex[2] = performanceIndex.dynamicsViolationSSE;
+  header.performanceIndex[3] = performanceIndex.equalityConstraintsSSE;
+  header.performanceIndex[4] = performanceIndex.equalityLagrangian;
+  header.performanceIndex[5] = performanceIndex.inequalityLagrangian;
+  header.size = computeLayout(header).size;
+  return header;
+}
+
+PerformanceIndex readPerformanceIndex(const Header& header) {
+  const auto& values = header.performanceIndex;
+  PerformanceIndex performanceIndex;
+  performanceIndex.merit = values[0];
+  performanceIndex.cost = values[1];
+  performanceIndex.dynamicsViolationSSE = values[2];
+  performanceIndex.equalityConstraintsSSE = values[3];
+  performanceIndex.equalityLagrangian = values[4];
+  performanceIndex.inequalityLagrangian = values[5];
+  return performanceIndex;
+}
+
+/** Samples the controller of a primal solution at the nodes of its time trajectory. */
+class ControllerSampler {
+ public:
+  ControllerSampler(const PrimalSolution& primalSolution, const Header& header)
+      : timeTrajectory_(primalSolution.timeTrajectory_), stateDim_(header.stateDim), inputDim_(header.inputDim) {
+    if (header.controllerType == static_cast<uint32_t>(ControllerType::FEEDFORWARD)) {
+      feedforwardControllerPtr_ = &static_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+      sameTimes_ = feedforwardControllerPtr_->timeStamp_ == timeTrajectory_;
+    } else {
+      linearControllerPtr_ = &static_cast<const LinearController&>(*primalSolution.controllerPtr_);
+      sameTimes_ = linearControllerPtr_->timeStamp_ == timeTrajectory_;
+    }
+  }
+
+  /** The feedforward input of a feedforward controller or the bias of a linear controller at node k. */
+  const vector_t& bias(size_t k) {
+    const vector_t* biasPtr = &biasSample_;
+    if (feedforwardControllerPtr_ != nullptr) {
+      if (sameTimes_) {
+        biasPtr = &feedforwardControllerPtr_->uffArray_[k];
+      } else {
+        biasSample_ = LinearInterpolation::interpolate(timeTrajectory_[k], feedforwardControllerPtr_->timeStamp_,
+                                                       feedforwardControllerPtr_->uffArray_);
+      }
+    } else {
+      if (sameTimes_) {
+        biasPtr = &linearControllerPtr_->biasArray_[k];
+      } else {
+        linearControllerPtr_->getBias(timeTrajectory_[k], biasSample_);
+      }
+    }
+    checkSize(static_cast<size_t>(biasPtr->size()) == inputDim_);
+    return *biasPtr;
+  }
+
+  /** The feedback gain of a linear controller at node k. */
+  const matrix_t& gain(size_t k) {
+    const matrix_t* gainPtr = &gainSample_;
+    if (sameTimes_) {
+      gainPtr = &linearControllerPtr_->gainArray_[k];
+    } else {
+      linearControllerPtr_->getFeedbackGain(timeTrajectory_[k], gainSample_);
+    }
+    checkSize(static_cast<size_t>(gainPtr->rows()) == inputDim_ && static_cast<size_t>(gainPtr->cols()) == stateDim_);
+    return *gainPtr;
+  }
+
+ private:
+  static void checkSize(bool valid) {
+    if (!valid) {
+      throw std::runtime_error("[policy_serialization::encodePolicy] The controller dimensions do not match the input and state ones.");
+    }
+  }
+
+  const scalar_array_t& timeTrajectory_;
+  const size_t stateDim_;
+  const size_t inputDim_;
+  const FeedforwardController* feedforwardControllerPtr_ = nullptr;
+  const LinearController* linearControllerPtr_ = nullptr;
+  bool sameTimes_;
+  vector_t biasSample_;
+  matrix_t gainSample_;
+};
+
+/** Writes the feedback gain in double or single precision. */
+void writeGain(const matrix_t& gain, bool quantizeGains, char* dst) {
+  if (quantizeGains) {
+    Eigen::Map<Eigen::MatrixXf>(reinterpret_cast<float*>(dst), gain.rows(), gain.cols()) = gain.cast<float>();
+  } else {
+    Eigen::Map<matrix_t>(reinterpret_cast<scalar_t*>(dst), gain.rows(), gain.cols()) = gain;
+  }
+}
+
+/** Reads a feedback gain in double or single precision while reusing the memory of the gain. */
+void readGain(const char* src, size_t rows, size_t cols, bool quantizedGains, matrix_t& gain) {
+  if (quantizedGains) {
+    gain = Eigen::Map<const Eigen::MatrixXf>(reinterpret_cast<const float*>(src), rows, cols).cast<scalar_t>();
+  } else {
+    gain = Eigen::Map<const matrix_t>(reinterpret_cast<const scalar_t*>(src), rows, cols);
+  }
+}
+
+/** Writes the controller bias and gains sampled at the time trajectory. */
+void writeController(const PrimalSolution& primalSolution, const Header& header, const Layout& layout, char* data) {
+  const size_t nx = header.stateDim;
+  const size_t nu = header.inputDim;
+  const bool isLinear = header.controllerType == static_cast<uint32_t>(ControllerType::LINEAR);
+  const bool quantizeGains = (header.flags & quantizedGainsFlag) != 0;
+  const size_t gainStride = nu * nx * (quantizeGains ? sizeof(float) : sizeof(scalar_t));
+  auto* biasPtr = sectionPtr<scalar_t>(data, layout.bias);
+
+  ControllerSampler sampler(primalSolution, header);
+  for (size_t k = 0; k < header.numNodes; k++) {
+    Eigen::Map<vector_t>(biasPtr + k * nu, nu) = sampler.bias(k);
+    if (isLinear) {
+      writeGain(sampler.gain(k), quantizeGains, data + layout.gain + k * gainStride);
+    }
+  }
+}
+
+/** Writes the post-event indices, the event times, and the mode sequence. The destination is the start of the post-event indices. */
+void writeEventSections(const PrimalSolution& primalSolution, const Layout& layout, char* dst) {
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+  std::copy(primalSolution.postEventIndices_.begin(), primalSolution.postEventIndices_.end(), sectionPtr<uint64_t>(dst, 0));
+  std::copy(modeSchedule.eventTimes.begin(), modeSchedule.eventTimes.end(),
+            sectionPtr<scalar_t>(dst, layout.eventTimes - layout.postEventIndices));
+  std::copy(modeSchedule.modeSequence.begin(), modeSchedule.modeSequence.end(),
+            sectionPtr<uint64_t>(dst, layout.modeSequence - layout.postEventIndices));
+}
+
+/** Reads the sections written by writeEventSections() while reusing the memory of the primal solution. */
+void readEventSections(const char* src, const Header& header, const Layout& layout, PrimalSolution& primalSolution) {
+  const auto* postEventIndices = sectionPtr<uint64_t>(src, 0);
+  primalSolution.postEventIndices_.assign(postEventIndices, postEventIndices + header.numPostEventIndices);
+  const auto* eventTimes = sectionPtr<scalar_t>(src, layout.eventTimes - layout.postEventIndices);
+  primalSolution.modeSchedule_.eventTimes.assign(eventTimes, eventTimes + header.numModes - 1);
+  const auto* modeSequence = sectionPtr<uint64_t>(src, layout.modeSequence - layout.postEventIndices);
+  primalSolution.modeSchedule_.modeSequence.assign(modeSequence, modeSequence + header.numModes);
+}
+
+/** Writes the observation and the target trajectories of the command data. The destination is the start of the observation state. */
+void writeCommandSections(const CommandData& commandData, const Header& header, const Layout& layout, char* dst) {
+  const auto at = [&](size_t offset) { return sectionPtr<scalar_t>(dst, offset - layout.observationState); };
+  const auto& observation = commandData.mpcInitObservation_;
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  std::copy(observation.state.data(), observation.state.data() + observation.state.size(), at(layout.observationState));
+  std::copy(observation.input.data(), observation.input.data() + observation.input.size(), at(layout.observationInput));
+  std::copy(targetTrajectories.timeTrajectory.begin(), targetTrajectories.timeTrajectory.end(), at(layout.targetTime));
+  writeVectorArray(targetTrajectories.stateTrajectory, header.targetStateDim, at(layout.targetState));
+  writeVectorArray(targetTrajectories.inputTrajectory, header.targetInputDim, at(layout.targetInput));
+}
+
+/** Reads the sections written by writeCommandSections() while reusing the memory of the command data. */
+void readCommandSections(const char* src, const Header& header, const Layout& layout, CommandData& commandData) {
+  const auto at = [&](size_t offset) { return sectionPtr<scalar_t>(src, offset - layout.observationState); };
+  auto& observation = commandData.mpcInitObservation_;
+  observation.mode = header.observationMode;
+  observation.time = header.observationTime;
+  observation.state = PolicyView::const_vector_map_t(at(layout.observationState), header.observationStateDim);
+  observation.input = PolicyView::const_vector_map_t(at(layout.observationInput), header.observationInputDim);
+
+  auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  targetTrajectories.timeTrajectory.assign(at(layout.targetTime), at(layout.targetTime) + header.numTargetNodes);
+  readVectorArray({at(layout.targetState), header.targetStateDim, header.numTargetNodes}, targetTrajectories.stateTrajectory);
+  if (header.targetInputDim > 0) {
+    readVectorArray({at(layout.targetInput), header.targetInputDim, header.numTargetNodes}, targetTrajectories.inputTrajectory);
+  } else {
+    targetTrajectories.inputTrajectory.clear();
+  }
+}
+
+/** A range [begin, end) of the nodes of a policy delta. */
+struct NodeRange {
+  uint32_t begin;
+  uint32_t end;
+};
+
+/** Collects the ranges of the consecutive nodes for which isChanged is true. */
+template <typename Predicate>
+std::vector<NodeRange> collectChangedRanges(size_t numNodes, Predicate isChanged) {
+  std::vector<NodeRange> ranges;
+  for (size_t k = 0; k < numNodes; k++) {
+    if (isChanged(k)) {
+      if (ranges.empty() || ranges.back().end != k) {
+        ranges.push_back({static_cast<uint32_t>(k), static_cast<uint32_t>(k)});
+      }
+      ranges.back().end = k + 1;
+    }
+  }
+  return ranges;
+}
+
+/** The number of the nodes in the ranges. */
+size_t numNodesIn(const std::vector<NodeRange>& ranges) {
+  size_t numNodes = 0;
+  for (const auto& range : ranges) {
+    numNodes += range.end - range.begin;
+  }
+  return numNodes;
+}
+
+/** Calls func with the index of each node in the ranges. */
+template <typename Function>
+void forEachChangedNode(const std::vector<NodeRange>& ranges, Function func) {
+  for (const auto& range : ranges) {
+    for (size_t k = range.begin; k < range.end; k++) {
+      func(k);
+    }
+  }
+}
+
+/**
+ * Whether the values differ by at most the tolerance. A NaN or a different size is always a difference. If quantize is set, the values
+ * are rounded to single precision before the comparison.
+ */
+template <typename Derived>
+bool isWithinTolerance(const Eigen::PlainObjectBase<Derived>& value, const Eigen::PlainObjectBase<Derived>& baseValue, scalar_t tolerance,
+                       bool quantize = false) {
+  if (value.rows() != baseValue.rows() || value.cols() != baseValue.cols()) {
+    return false;
+  }
+  const scalar_t* valuePtr = value.data();
+  const scalar_t* baseValuePtr = baseValue.data();
+  for (Eigen::Index i = 0; i < value.size(); i++) {
+    const scalar_t v = quantize ? static_cast<scalar_t>(static_cast<float>(valuePtr[i])) : valuePtr[i];
+    if (!(std::abs(v - baseValuePtr[i]) <= tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Shifts the elements of the array to the front by the time shift and resizes it to the number of nodes while reusing their memory. */
+template <typename Array>
+void shiftNodes(Array& array, size_t timeShift, size_t numNodes) {
+  std::rotate(array.begin(), array.begin() + std::min(timeShift, array.size()), array.end());
+  array.resize(numNodes);
+}
+
+/** Reads the sections of a policy delta sequentially. */
+class DeltaReader {
+ public:
+  DeltaReader(const char* data, size_t size, size_t offset) : data_(data), size_(size), offset_(offset) {}
+
+  const char* take(size_t numBytes) {
+    if (numBytes > size_ - offset_) {
+      throw std::runtime_error("[policy_serialization::applyPolicyDelta] The delta is truncated.");
+    }
+    const char* ptr = data_ + offset_;
+    offset_ += numBytes;
+    return ptr;
+  }
+
+  std::vector<NodeRange> takeRanges(size_t numRanges, size_t numNodes) {
+    if (numRanges > (size_ - offset_) / sizeof(NodeRange)) {
+      throw std::runtime_error("[policy_serialization::applyPolicyDelta] The delta is truncated.");
+    }
+    std::vector<NodeRange> ranges(numRanges);
+    std::memcpy(ranges.data(), take(numRanges * sizeof(NodeRange)), numRanges * sizeof(NodeRange));
+    uint32_t previousEnd = 0;
+    for (const auto& range : ranges) {
+      if (range.begin < previousEnd || range.begin >= range.end || range.end > numNodes) {
+        throw std::runtime_error("[policy_serialization::applyPolicyDelta] The node ranges of the delta are corrupted.");
+      }
+      previousEnd = range.end;
+    }
+    return ranges;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_;
+};
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Layout computeLayout(const Header& header) {
+  size_t offset = sizeof(Header);
+  const auto section = [&offset](size_t numBytes) {
+    const size_t start = offset;
+    offset = alignOffset(offset + numBytes);
+    return start;
+  };
+
+  const size_t N = header.numNodes;
+  const size_t nx = header.stateDim;
+  const size_t nu = header.inputDim;
+  const size_t numEventTimes = header.numModes > 0 ? header.numModes - 1 : 0;
+  const bool isLinear = header.controllerType == static_cast<uint32_t>(ControllerType::LINEAR);
+  const size_t gainScalarSize = (header.flags & quantizedGainsFlag) != 0 ? sizeof(float) : sizeof(scalar_t);
+
+  Layout layout;
+  layout.time = section(N * sizeof(scalar_t));
+  layout.postEventIndices = section(header.numPostEventIndices * sizeof(uint64_t));
+  layout.eventTimes = section(numEventTimes * sizeof(scalar_t));
+  layout.modeSequence = section(header.numModes * sizeof(uint64_t));
+  layout.state = section(N * nx * sizeof(scalar_t));
+  layout.input = section(N * nu * sizeof(scalar_t));
+  layout.bias = section(N * nu * sizeof(scalar_t));
+  layout.gain = section(isLinear ? N * nu * nx * gainScalarSize : 0);
+  layout.observationState = section(header.observationStateDim * sizeof(scalar_t));
+  layout.observationInput = section(header.observationInputDim * sizeof(scalar_t));
+  layout.targetTime = section(header.numTargetNodes * sizeof(scalar_t));
+  layout.targetState = section(header.numTargetNodes * header.targetStateDim * sizeof(scalar_t));
+  layout.targetInput = section(header.numTargetNodes * header.targetInputDim * sizeof(scalar_t));
+  layout.size = offset;
+  return layout;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void encodePolicy(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndex,
+                  std::vector<char>& buffer, bool quantizeGains) {
+  const auto header = createHeader(primalSolution, commandData, performanceIndex, quantizeGains);
+  const auto layout = computeLayout(header);
+  buffer.resize(layout.size);
+  char* data = buffer.data();
+  std::memcpy(data, &header, sizeof(Header));
+
+  // primal solution
+  std::copy(primalSolution.timeTrajectory_.begin(), primalSolution.timeTrajectory_.end(), sectionPtr<scalar_t>(data, layout.time));
+  writeEventSections(primalSolution, layout, data + layout.postEventIndices);
+  writeVectorArray(primalSolution.stateTrajectory_, header.stateDim, sectionPtr<scalar_t>(data, layout.state));
+  writeVectorArray(primalSolution.inputTrajectory_, header.inputDim, sectionPtr<scalar_t>(data, layout.input));
+  writeController(primalSolution, header, layout, data);
+
+  // command data
+  writeCommandSections(commandData, header, layout, data + layout.observationState);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyView::PolicyView(const char* data, size_t size) : data_(data) {
+  if (data_ == nullptr || size < sizeof(Header)) {
+    throw std::runtime_error("[PolicyView::PolicyView] The buffer is smaller than the policy header.");
+  }
+  if (reinterpret_cast<uintptr_t>(data_) % alignment != 0) {
+    throw std::runtime_error("[PolicyView::PolicyView] The buffer should be " + std::to_string(alignment) + " byte aligned.");
+  }
+  if (header().magic != magicNumber) {
+    throw std::runtime_error("[PolicyView::PolicyView] The buffer is not an encoded policy or it has a different byte order.");
+  }
+  if (header().version != formatVersion) {
+    throw std::runtime_error("[PolicyView::PolicyView] The policy format version " + std::to_string(header().version) +
+                             " is not supported (expected " + std::to_string(formatVersion) + ").");
+  }
+  if (controllerType() != ControllerType::FEEDFORWARD && controllerType() != ControllerType::LINEAR) {
+    throw std::runtime_error("[PolicyView::PolicyView] Unknown controller type.");
+  }
+  if (header().numModes == 0) {
+    throw std::runtime_error("[PolicyView::PolicyView] The mode sequence of the policy is empty.");
+  }
+
+  layout_ = computeLayout(header());
+  if (layout_.size != header().size || layout_.size > size) {
+    throw std::runtime_error("[PolicyView::PolicyView] The buffer is truncated or its header is corrupted.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyView::getGain(size_t k, matrix_t& feedbackGain) const {
+  if (hasQuantizedGains()) {
+    feedbackGain = quantizedGain(k).cast<scalar_t>();
+  } else {
+    feedbackGain = gain(k);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex PolicyView::performanceIndex() const {
+  return readPerformanceIndex(header());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decodePolicy(const PolicyView& policyView, PrimalSolution& primalSolution, CommandData& commandData,
+                  PerformanceIndex& performanceIndex) {
+  const auto& header = policyView.header();
+  const auto& layout = policyView.layout();
+  const size_t N = header.numNodes;
+
+  // primal solution
+  const auto timeTrajectory = policyView.timeTrajectory();
+  primalSolution.timeTrajectory_.assign(timeTrajectory.data(), timeTrajectory.data() + N);
+  readEventSections(policyView.data() + layout.postEventIndices, header, layout, primalSolution);
+  readVectorArray(policyView.stateTrajectory(), primalSolution.stateTrajectory_);
+  readVectorArray(policyView.inputTrajectory(), primalSolution.inputTrajectory_);
+
+  // controller, reused if it has the same type
+  const bool reuseController =
+      primalSolution.controllerPtr_ != nullptr && primalSolution.controllerPtr_->getType() == policyView.controllerType();
+  if (policyView.controllerType() == ControllerType::FEEDFORWARD) {
+    if (!reuseController) {
+      primalSolution.controllerPtr_.reset(new FeedforwardController);
+    }
+    auto& controller = static_cast<FeedforwardController&>(*primalSolution.controllerPtr_);
+    controller.timeStamp_ = primalSolution.timeTrajectory_;
+    readVectorArray(policyView.controllerBias(), controller.uffArray_);
+
+  } else {
+    if (!reuseController) {
+      primalSolution.controllerPtr_.reset(new LinearController);
+    }
+    auto& controller = static_cast<LinearController&>(*primalSolution.controllerPtr_);
+    controller.timeStamp_ = primalSolution.timeTrajectory_;
+    readVectorArray(policyView.controllerBias(), controller.biasArray_);
+    controller.deltaBiasArray_.clear();
+    controller.gainArray_.resize(N);
+    for (size_t k = 0; k < N; k++) {
+      policyView.getGain(k, controller.gainArray_[k]);
+    }
+  }
+
+  // command data
+  readCommandSections(policyView.data() + layout.observationState, header, layout, commandData);
+  performanceIndex = policyView.performanceIndex();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isPolicyDelta(const char* data, size_t size) {
+  uint32_t magic = 0;
+  if (data == nullptr || size < sizeof(magic)) {
+    return false;
+  }
+  std::memcpy(&magic, data, sizeof(magic));
+  return magic == deltaMagicNumber;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DeltaHeader readDeltaHeader(const char* data, size_t size) {
+  if (data == nullptr || size < sizeof(DeltaHeader)) {
+    throw std::runtime_error("[policy_serialization::readDeltaHeader] The buffer is smaller than the delta header.");
+  }
+  DeltaHeader deltaHeader;
+  std::memcpy(&deltaHeader, data, sizeof(DeltaHeader));
+  if (deltaHeader.magic != deltaMagicNumber) {
+    throw std::runtime_error("[policy_serialization::readDeltaHeader] The buffer is not a policy delta or it has a different byte order.");
+  }
+  if (deltaHeader.version != formatVersion) {
+    throw std::runtime_error("[policy_serialization::readDeltaHeader] The policy format version " + std::to_string(deltaHeader.version) +
+                             " is not supported (expected " + std::to_string(formatVersion) + ").");
+  }
+  if (deltaHeader.size > size || deltaHeader.size < sizeof(DeltaHeader) + sizeof(Header) || deltaHeader.timeShift < 0) {
+    throw std::runtime_error("[policy_serialization::readDeltaHeader] The buffer is truncated or its header is corrupted.");
+  }
+  return deltaHeader;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool encodePolicyDelta(const PrimalSolution& basePrimalSolution, uint64_t baseNumber, const PrimalSolution& primalSolution,
+                       const CommandData& commandData, const PerformanceIndex& performanceIndex, std::vector<char>& delta,
+                       scalar_t tolerance, bool quantizeGains) {
+  const auto header = createHeader(primalSolution, commandData, performanceIndex, quantizeGains);
+  const auto layout = computeLayout(header);
+  const size_t N = header.numNodes;
+  const size_t nx = header.stateDim;
+  const size_t nu = header.inputDim;
+  const bool isLinear = header.controllerType == static_cast<uint32_t>(ControllerType::LINEAR);
+  const bool quantizedGains = (header.flags & quantizedGainsFlag) != 0;
+
+  // the base policy should have the same controller type and dimensions
+  const size_t baseN = basePrimalSolution.timeTrajectory_.size();
+  const auto* baseControllerPtr = basePrimalSolution.controllerPtr_.get();
+  if (baseControllerPtr == nullptr || baseControllerPtr->getType() != primalSolution.controllerPtr_->getType()) {
+    return false;
+  }
+  if (baseN > 0 && (static_cast<size_t>(basePrimalSolution.stateTrajectory_.front().size()) != nx ||
+                    static_cast<size_t>(basePrimalSolution.inputTrajectory_.front().size()) != nu)) {
+    return false;
+  }
+  const auto& baseBiasArray = isLinear ? static_cast<const LinearController*>(baseControllerPtr)->biasArray_
+                                       : static_cast<const FeedforwardController*>(baseControllerPtr)->uffArray_;
+  const matrix_array_t* baseGainArrayPtr = isLinear ? &static_cast<const LinearController*>(baseControllerPtr)->gainArray_ : nullptr;
+  if (basePrimalSolution.stateTrajectory_.size() != baseN || basePrimalSolution.inputTrajectory_.size() != baseN ||
+      baseBiasArray.size() != baseN || (isLinear && baseGainArrayPtr->size() != baseN)) {
+    throw std::runtime_error("[policy_serialization::encodePolicyDelta] The base policy should be in the form of a decoded policy.");
+  }
+
+  // the time shift is given by the base node of the first node
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& baseTimeTrajectory = basePrimalSolution.timeTrajectory_;
+  size_t timeShift = 0;
+  if (N > 0) {
+    timeShift = baseN;
+    for (size_t j = 0; j < baseN; j++) {
+      if (std::abs(baseTimeTrajectory[j] - timeTrajectory[0]) <= deltaTimeTolerance) {
+        timeShift = j;
+        break;
+      }
+    }
+  }
+  const auto hasBaseNode = [&](size_t k) {
+    return k + timeShift < baseN && std::abs(baseTimeTrajectory[k + timeShift] - timeTrajectory[k]) <= deltaTimeTolerance;
+  };
+
+  // compare the primal solution directly with the base policy
+  ControllerSampler sampler(primalSolution, header);
+  const auto nodeRanges = collectChangedRanges(N, [&](size_t k) {
+    if (!hasBaseNode(k)) {
+      return true;
+    }
+    const size_t j = k + timeShift;
+    return !isWithinTolerance(primalSolution.stateTrajectory_[k], basePrimalSolution.stateTrajectory_[j], tolerance) ||
+           !isWithinTolerance(primalSolution.inputTrajectory_[k], basePrimalSolution.inputTrajectory_[j], tolerance) ||
+           !isWithinTolerance(sampler.bias(k), baseBiasArray[j], tolerance);
+  });
+
+  const auto gainRanges = collectChangedRanges(isLinear ? N : 0, [&](size_t k) {
+    if (!hasBaseNode(k)) {
+      return true;
+    }
+    const auto& gain = sampler.gain(k);
+    const auto& baseGain = (*baseGainArrayPtr)[k + timeShift];
+    return !isWithinTolerance(gain, baseGain, tolerance, quantizedGains);
+  });
+
+  // the size of the delta
+  const size_t eventSectionsSize = layout.state - layout.postEventIndices;
+  const size_t commandSectionsSize = layout.size - layout.observationState;
+  const size_t gainSize = nu * nx * (quantizedGains ? sizeof(float) : sizeof(scalar_t));
+  const size_t rangesSize = (nodeRanges.size() + gainRanges.size()) * sizeof(NodeRange);
+  const size_t nodesSize = numNodesIn(nodeRanges) * (1 + nx + 2 * nu) * sizeof(scalar_t) + numNodesIn(gainRanges) * gainSize;
+  const size_t deltaSize =
+      alignOffset(sizeof(DeltaHeader) + sizeof(Header) + eventSectionsSize + commandSectionsSize + rangesSize + nodesSize);
+
+  DeltaHeader deltaHeader{};
+  deltaHeader.magic = deltaMagicNumber;
+  deltaHeader.version = formatVersion;
+  deltaHeader.numNodeRanges = nodeRanges.size();
+  deltaHeader.numGainRanges = gainRanges.size();
+  deltaHeader.baseNumber = baseNumber;
+  deltaHeader.baseNumNodes = baseN;
+  deltaHeader.timeShift = timeShift;
+  deltaHeader.policySize = header.size;
+  deltaHeader.size = deltaSize;
+
+  delta.resize(deltaSize);
+  std::fill(delta.begin(), delta.end(), 0);
+  char* dst = delta.data();
+  const auto write = [&dst](const void* data, size_t numBytes) {
+    std::memcpy(dst, data, numBytes);
+    dst += numBytes;
+  };
+  write(&deltaHeader, sizeof(DeltaHeader));
+  write(&header, sizeof(Header));
+  writeEventSections(primalSolution, layout, dst);
+  dst += eventSectionsSize;
+  writeCommandSections(commandData, header, layout, dst);
+  dst += commandSectionsSize;
+  write(nodeRanges.data(), nodeRanges.size() * sizeof(NodeRange));
+  write(gainRanges.data(), gainRanges.size() * sizeof(NodeRange));
+
+  // the changed nodes section by section
+  forEachChangedNode(nodeRanges, [&](size_t k) { write(&timeTrajectory[k], sizeof(scalar_t)); });
+  forEachChangedNode(nodeRanges, [&](size_t k) { write(primalSolution.stateTrajectory_[k].data(), nx * sizeof(scalar_t)); });
+  forEachChangedNode(nodeRanges, [&](size_t k) { write(primalSolution.inputTrajectory_[k].data(), nu * sizeof(scalar_t)); });
+  forEachChangedNode(nodeRanges, [&](size_t k) { write(sampler.bias(k).data(), nu * sizeof(scalar_t)); });
+  forEachChangedNode(gainRanges, [&](size_t k) {
+    writeGain(sampler.gain(k), quantizedGains, dst);
+    dst += gainSize;
+  });
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void applyPolicyDelta(const char* delta, size_t deltaSize, PrimalSolution& primalSolution, CommandData& commandData,
+                      PerformanceIndex& performanceIndex) {
+  const auto deltaHeader = readDeltaHeader(delta, deltaSize);
+  DeltaReader reader(delta, deltaHeader.size, sizeof(DeltaHeader));
+
+  Header header;
+  std::memcpy(&header, reader.take(sizeof(Header)), sizeof(Header));
+  const auto controllerType = static_cast<ControllerType>(header.controllerType);
+  if (header.magic != magicNumber || header.version != formatVersion || header.numModes == 0 ||
+      (controllerType != ControllerType::FEEDFORWARD && controllerType != ControllerType::LINEAR)) {
+    throw std::runtime_error("[policy_serialization::applyPolicyDelta] The policy header of the delta is corrupted.");
+  }
+  const auto layout = computeLayout(header);
+  if (layout.size != header.size || header.size != deltaHeader.policySize) {
+    throw std::runtime_error("[policy_serialization::applyPolicyDelta] The policy header of the delta is corrupted.");
+  }
+
+  // the base policy should be the decoded policy of the delta
+  const size_t N = header.numNodes;
+  const size_t nx = header.stateDim;
+  const size_t nu = header.inputDim;
+  const size_t baseN = primalSolution.timeTrajectory_.size();
+  const bool isLinear = controllerType == ControllerType::LINEAR;
+  auto* linearControllerPtr = dynamic_cast<LinearController*>(primalSolution.controllerPtr_.get());
+  auto* feedforwardControllerPtr = dynamic_cast<FeedforwardController*>(primalSolution.controllerPtr_.get());
+  const bool isBase = baseN == deltaHeader.baseNumNodes && primalSolution.stateTrajectory_.size() == baseN &&
+                      primalSolution.inputTrajectory_.size() == baseN &&
+                      (baseN == 0 || (static_cast<size_t>(primalSolution.stateTrajectory_.front().size()) == nx &&
+                                      static_cast<size_t>(primalSolution.inputTrajectory_.front().size()) == nu)) &&
+                      (isLinear ? linearControllerPtr != nullptr && linearControllerPtr->biasArray_.size() == baseN &&
+                                      linearControllerPtr->gainArray_.size() == baseN
+                                : feedforwardControllerPtr != nullptr && feedforwardControllerPtr->uffArray_.size() == baseN);
+  if (!isBase) {
+    throw std::runtime_error("[policy_serialization::applyPolicyDelta] The base policy does not match the one of the delta.");
+  }
+
+  const char* eventSections = reader.take(layout.state - layout.postEventIndices);
+  const char* commandSections = reader.take(layout.size - layout.observationState);
+  const auto nodeRanges = reader.takeRanges(deltaHeader.numNodeRanges, N);
+  const auto gainRanges = reader.takeRanges(deltaHeader.numGainRanges, isLinear ? N : 0);
+
+  // the unchanged nodes are kept, hence they should have a base node
+  const size_t timeShift = deltaHeader.timeShift;
+  const auto checkBaseNodes = [&](const std::vector<NodeRange>& ranges) {
+    size_t k = 0;
+    const auto checkUnchanged = [&](size_t end) {
+      if (k < end && end + timeShift > baseN) {
+        throw std::runtime_error("[policy_serialization::applyPolicyDelta] The delta refers to a node beyond the base policy.");
+      }
+    };
+    for (const auto& range : ranges) {
+      checkUnchanged(range.begin);
+      k = range.end;
+    }
+    checkUnchanged(N);
+  };
+  checkBaseNodes(nodeRanges);
+  if (isLinear) {
+    checkBaseNodes(gainRanges);
+  }
+
+  const bool quantizedGains = (header.flags & quantizedGainsFlag) != 0;
+  const size_t gainSize = nu * nx * (quantizedGains ? sizeof(float) : sizeof(scalar_t));
+  const char* timeSection = reader.take(numNodesIn(nodeRanges) * sizeof(scalar_t));
+  const char* stateSection = reader.take(numNodesIn(nodeRanges) * nx * sizeof(scalar_t));
+  const char* inputSection = reader.take(numNodesIn(nodeRanges) * nu * sizeof(scalar_t));
+  const char* biasSection = reader.take(numNodesIn(nodeRanges) * nu * sizeof(scalar_t));
+  const char* gainSection = reader.take(numNodesIn(gainRanges) * gainSize);
+
+  // the sections which are not per node
+  readEventSections(eventSections, header, layout, primalSolution);
+  readCommandSections(commandSections, header, layout, commandData);
+  performanceIndex = readPerformanceIndex(header);
+
+  // shift the base nodes and overwrite the changed ones
+  const auto patchNodes = [&timeShift, &N](const std::vector<NodeRange>& ranges, const char* src, size_t size, vector_array_t& array) {
+    shiftNodes(array, timeShift, N);
+    for (const auto& range : ranges) {
+      for (size_t k = range.begin; k < range.end; k++) {
+        array[k] = PolicyView::const_vector_map_t(sectionPtr<scalar_t>(src, 0), size);
+        src += size * sizeof(scalar_t);
+      }
+    }
+  };
+
+  auto& timeTrajectory = primalSolution.timeTrajectory_;
+  shiftNodes(timeTrajectory, timeShift, N);
+  for (const auto& range : nodeRanges) {
+    std::memcpy(timeTrajectory.data() + range.begin, timeSection, (range.end - range.begin) * sizeof(scalar_t));
+    timeSection += (range.end - range.begin) * sizeof(scalar_t);
+  }
+  patchNodes(nodeRanges, stateSection, nx, primalSolution.stateTrajectory_);
+  patchNodes(nodeRanges, inputSection, nu, primalSolution.inputTrajectory_);
+
+  if (isLinear) {
+    auto& controller = *linearControllerPtr;
+    controller.timeStamp_ = timeTrajectory;
+    patchNodes(nodeRanges, biasSection, nu, controller.biasArray_);
+    controller.deltaBiasArray_.clear();
+    shiftNodes(controller.gainArray_, timeShift, N);
+    for (const auto& range : gainRanges) {
+      for (size_t k = range.begin; k < range.end; k++) {
+        readGain(gainSection, nu, nx, quantizedGains, controller.gainArray_[k]);
+        gainSection += gainSize;
+      }
+    }
+  } else {
+    auto& controller = *feedforwardControllerPtr;
+    controller.timeStamp_ = timeTrajectory;
+    patchNodes(nodeRanges, biasSection, nu, controller.uffArray_);
+  }
+}
+
+}  // namespace policy_serialization
+}  // namespace ocs2
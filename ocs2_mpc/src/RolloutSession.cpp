@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/RolloutSession.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/Numerics.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RolloutSession::RolloutSession(const ControlledSystemBase& systemDynamics, scalar_t maxTimeStep)
+    : systemDynamicsPtr_(systemDynamics.clone()), maxTimeStep_(maxTimeStep) {
+  if (maxTimeStep_ <= 0.0) {
+    throw std::runtime_error("[RolloutSession::RolloutSession] The maximum time step should be positive!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RolloutSession::reset(scalar_t time, const vector_t& state, ControllerBase* controllerPtr) {
+  if (controllerPtr == nullptr) {
+    throw std::runtime_error("[RolloutSession::reset] Controller is not set!");
+  }
+  systemDynamicsPtr_->setController(controllerPtr);
+  time_ = time;
+  state_ = state;
+  input_ = controllerPtr->computeInput(time_, state_);
+
+  // the intermediate state keeps its size as long as the state dimension does not change
+  tempState_.resize(state_.size());
+  isStarted_ = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool RolloutSession::isAt(scalar_t time, const vector_t& state) const {
+  return isStarted_ && numerics::almost_eq(time, time_) && state.size() == state_.size() && state == state_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RolloutSession::advance(scalar_t finalTime, const ModeSchedule& modeSchedule) {
+  if (!isStarted_) {
+    throw std::runtime_error("[RolloutSession::advance] The session is not started! Use reset() first.");
+  }
+  if (finalTime < time_) {
+    throw std::runtime_error("[RolloutSession::advance] The final time should be greater-equal to the current time!");
+  }
+
+  const auto& eventTimes = modeSchedule.eventTimes;
+  auto eventItr = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), time_);
+  while (time_ < finalTime) {
+    // integrate until the next event or the final time
+    const scalar_t intervalFinalTime = (eventItr != eventTimes.cend() && *eventItr <= finalTime) ? *eventItr : finalTime;
+    const scalar_t interval = intervalFinalTime - time_;
+    const auto numSteps = static_cast<size_t>(std::ceil(interval / maxTimeStep_ - numeric_traits::weakEpsilon<scalar_t>()));
+    const scalar_t dt = interval / static_cast<scalar_t>(std::max(numSteps, size_t(1)));
+    for (size_t i = 0; i < numSteps; i++) {
+      step(dt);
+    }
+    time_ = intervalFinalTime;
+
+    // a jump takes place at the event
+    if (eventItr != eventTimes.cend() && *eventItr == intervalFinalTime) {
+      state_ = systemDynamicsPtr_->computeJumpMap(time_, state_);
+      ++eventItr;
+    }
+  }
+
+  if (!state_.allFinite()) {
+    throw std::runtime_error("[RolloutSession::advance] System became unstable during the rollout!");
+  }
+  input_ = systemDynamicsPtr_->controllerPtr()->computeInput(time_, state_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RolloutSession::step(scalar_t dt) {
+  // the stages are moved from the values returned by the flow map, the other expressions are evaluated in place
+  k1_ = systemDynamicsPtr_->computeFlowMap(time_, state_);
+  tempState_.noalias() = state_ + (0.5 * dt) * k1_;
+  k2_ = systemDynamicsPtr_->computeFlowMap(time_ + 0.5 * dt, tempState_);
+  tempState_.noalias() = state_ + (0.5 * dt) * k2_;
+  k3_ = systemDynamicsPtr_->computeFlowMap(time_ + 0.5 * dt, tempState_);
+  tempState_.noalias() = state_ + dt * k3_;
+  k4_ = systemDynamicsPtr_->computeFlowMap(time_ + dt, tempState_);
+  state_.noalias() += (dt / 6.0) * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+  time_ += dt;
+}
+
+}  // namespace ocs2
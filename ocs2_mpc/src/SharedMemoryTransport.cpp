@@ -0,0 +1,493 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/SharedMemoryTransport.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/misc/LoadData.h>
+
+namespace ocs2 {
+namespace shared_memory {
+
+namespace {
+
+constexpr uint32_t segmentMagicNumber = 0x4f43534d;  // "OCSM"
+constexpr uint32_t segmentVersion = 1;
+constexpr size_t cacheLineSize = 64;
+constexpr size_t numMessageSlots = 2;
+constexpr size_t maxNumReadAttempts = 100;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The atomics in the shared memory should be lock-free.");
+
+size_t alignToCacheLine(size_t size) {
+  return (size + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+}
+
+size_t channelIndex(Channel channel) {
+  return static_cast<size_t>(channel);
+}
+
+/** Appends count elements to the end of the buffer. */
+template <typename T>
+void append(const T* data, size_t count, std::vector<char>& buffer) {
+  const size_t offset = buffer.size();
+  buffer.resize(offset + count * sizeof(T));
+  if (count > 0) {
+    std::memcpy(buffer.data() + offset, data, count * sizeof(T));
+  }
+}
+
+template <typename T>
+void append(T value, std::vector<char>& buffer) {
+  append(&value, 1, buffer);
+}
+
+/** Reads the elements of a message sequentially. */
+class MessageReader {
+ public:
+  explicit MessageReader(const std::vector<char>& buffer) : buffer_(buffer) {}
+
+  template <typename T>
+  void read(T* data, size_t count) {
+    checkRemaining(count, sizeof(T));
+    if (count > 0) {
+      std::memcpy(data, buffer_.data() + offset_, count * sizeof(T));
+      offset_ += count * sizeof(T);
+    }
+  }
+
+  template <typename T>
+  T read() {
+    T value;
+    read(&value, 1);
+    return value;
+  }
+
+  void read(vector_t& v) {
+    const auto size = read<uint64_t>();
+    checkRemaining(size, sizeof(scalar_t));
+    v.resize(size);
+    read(v.data(), size);
+  }
+
+  /** Reads the size of an array whose elements have at least the given size. */
+  size_t readArraySize(size_t minElementSize) {
+    const auto size = read<uint64_t>();
+    checkRemaining(size, minElementSize);
+    return size;
+  }
+
+ private:
+  void checkRemaining(size_t count, size_t elementSize) const {
+    if (count > (buffer_.size() - offset_) / elementSize) {
+      throw std::runtime_error("[shared_memory::MessageReader] The message is truncated.");
+    }
+  }
+
+  const std::vector<char>& buffer_;
+  size_t offset_ = 0;
+};
+
+void append(const vector_t& v, std::vector<char>& buffer) {
+  append(static_cast<uint64_t>(v.size()), buffer);
+  append(v.data(), v.size(), buffer);
+}
+
+}  // unnamed namespace
+
+struct alignas(cacheLineSize) SharedMemorySegment::SegmentHeader {
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint64_t size;
+  uint64_t numPolicySlots;
+  uint64_t policySlotCapacity;
+  uint64_t messageSlotCapacity;
+  std::atomic<uint64_t> acknowledgedReset;
+  std::atomic<uint64_t> policyNumberAtReset;
+  std::atomic<uint64_t> acknowledgedPolicy;
+};
+
+struct alignas(cacheLineSize) SharedMemorySegment::ChannelHeader {
+  std::atomic<uint64_t> latestNumber;
+  uint64_t numSlots;
+  uint64_t slotCapacity;
+  uint64_t slotsOffset;
+};
+
+struct alignas(cacheLineSize) SharedMemorySegment::SlotHeader {
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint64_t> number;
+  std::atomic<uint64_t> size;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+
+  Settings settings;
+
+  if (verbose) {
+    std::cerr << "\n #### Shared Memory Transport Settings:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  loadData::loadPtreeValue(pt, settings.name_, fieldName + ".name", verbose);
+  loadData::loadPtreeValue(pt, settings.numPolicySlots_, fieldName + ".numPolicySlots", verbose);
+  loadData::loadPtreeValue(pt, settings.policySlotCapacity_, fieldName + ".policySlotCapacity", verbose);
+  loadData::loadPtreeValue(pt, settings.messageSlotCapacity_, fieldName + ".messageSlotCapacity", verbose);
+  loadData::loadPtreeValue(pt, settings.pollingPeriod_, fieldName + ".pollingPeriod", verbose);
+  loadData::loadPtreeValue(pt, settings.deltaPolicyUpdates_, fieldName + ".deltaPolicyUpdates", verbose);
+  loadData::loadPtreeValue(pt, settings.deltaPolicyTolerance_, fieldName + ".deltaPolicyTolerance", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return settings;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void waitForPollingPeriod(const Settings& settings) {
+  if (settings.pollingPeriod_ > 0.0) {
+    std::this_thread::sleep_for(std::chrono::duration<scalar_t>(settings.pollingPeriod_));
+  } else {
+    std::this_thread::yield();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemorySegment::SharedMemorySegment(Settings settings, bool create) : settings_(std::move(settings)), owner_(create) {
+  if (settings_.numPolicySlots_ < 2) {
+    throw std::runtime_error("[SharedMemorySegment] At least two policy slots are required.");
+  }
+
+  // layout: segment header, channel headers, and the slots of the channels
+  const size_t numSlots[] = {settings_.numPolicySlots_, numMessageSlots, numMessageSlots};
+  const size_t slotCapacity[] = {settings_.policySlotCapacity_, settings_.messageSlotCapacity_, settings_.messageSlotCapacity_};
+  size_t slotsOffset[3];
+  size_ = sizeof(SegmentHeader) + 3 * sizeof(ChannelHeader);
+  for (size_t i = 0; i < 3; i++) {
+    slotsOffset[i] = size_;
+    size_ += numSlots[i] * (sizeof(SlotHeader) + alignToCacheLine(slotCapacity[i]));
+  }
+
+  if (owner_) {
+    ::shm_unlink(settings_.name_.c_str());  // remove a stale segment
+    fileDescriptor_ = ::shm_open(settings_.name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  } else {
+    fileDescriptor_ = ::shm_open(settings_.name_.c_str(), O_RDWR, 0);
+  }
+  if (fileDescriptor_ < 0) {
+    throw std::runtime_error("[SharedMemorySegment] Could not open the shared memory object " + settings_.name_ + ": " +
+                             std::strerror(errno) + (owner_ ? "" : ". Is the MPC running?"));
+  }
+
+  if (owner_) {
+    if (::ftruncate(fileDescriptor_, size_) != 0) {
+      ::close(fileDescriptor_);
+      ::shm_unlink(settings_.name_.c_str());
+      throw std::runtime_error("[SharedMemorySegment] Could not resize the shared memory object: " + std::string(std::strerror(errno)));
+    }
+  } else {
+    struct stat fileStatus;
+    if (::fstat(fileDescriptor_, &fileStatus) != 0 || static_cast<size_t>(fileStatus.st_size) != size_) {
+      ::close(fileDescriptor_);
+      throw std::runtime_error("[SharedMemorySegment] The shared memory object " + settings_.name_ +
+                               " does not match the settings of the transport.");
+    }
+  }
+
+  void* address = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor_, 0);
+  if (address == MAP_FAILED) {
+    ::close(fileDescriptor_);
+    if (owner_) {
+      ::shm_unlink(settings_.name_.c_str());
+    }
+    throw std::runtime_error("[SharedMemorySegment] Could not map the shared memory object: " + std::string(std::strerror(errno)));
+  }
+  data_ = static_cast<char*>(address);
+
+  auto* segmentHeader = reinterpret_cast<SegmentHeader*>(data_);
+  if (owner_) {
+    segmentHeader = new (data_) SegmentHeader;
+    segmentHeader->version = segmentVersion;
+    segmentHeader->size = size_;
+    segmentHeader->numPolicySlots = settings_.numPolicySlots_;
+    segmentHeader->policySlotCapacity = settings_.policySlotCapacity_;
+    segmentHeader->messageSlotCapacity = settings_.messageSlotCapacity_;
+    segmentHeader->acknowledgedReset.store(0, std::memory_order_relaxed);
+    segmentHeader->policyNumberAtReset.store(0, std::memory_order_relaxed);
+    segmentHeader->acknowledgedPolicy.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < 3; i++) {
+      auto* header = new (data_ + sizeof(SegmentHeader) + i * sizeof(ChannelHeader)) ChannelHeader;
+      header->latestNumber.store(0, std::memory_order_relaxed);
+      header->numSlots = numSlots[i];
+      header->slotCapacity = slotCapacity[i];
+      header->slotsOffset = slotsOffset[i];
+      for (size_t j = 0; j < numSlots[i]; j++) {
+        auto* slot = new (data_ + slotsOffset[i] + j * (sizeof(SlotHeader) + alignToCacheLine(slotCapacity[i]))) SlotHeader;
+        slot->sequence.store(0, std::memory_order_relaxed);
+        slot->number.store(0, std::memory_order_relaxed);
+        slot->size.store(0, std::memory_order_relaxed);
+      }
+    }
+    // the segment is ready once the magic number is visible
+    segmentHeader->magic.store(segmentMagicNumber, std::memory_order_release);
+
+  } else {
+    const bool isValid = segmentHeader->magic.load(std::memory_order_acquire) == segmentMagicNumber &&
+                         segmentHeader->version == segmentVersion && segmentHeader->size == size_ &&
+                         segmentHeader->numPolicySlots == settings_.numPolicySlots_ &&
+                         segmentHeader->policySlotCapacity == settings_.policySlotCapacity_ &&
+                         segmentHeader->messageSlotCapacity == settings_.messageSlotCapacity_;
+    if (!isValid) {
+      ::munmap(data_, size_);
+      ::close(fileDescriptor_);
+      throw std::runtime_error("[SharedMemorySegment] The shared memory object " + settings_.name_ +
+                               " is not initialized or does not match the settings of the transport.");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemorySegment::~SharedMemorySegment() {
+  ::munmap(data_, size_);
+  ::close(fileDescriptor_);
+  if (owner_) {
+    ::shm_unlink(settings_.name_.c_str());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemorySegment::ChannelHeader& SharedMemorySegment::channelHeader(Channel channel) const {
+  return *reinterpret_cast<ChannelHeader*>(data_ + sizeof(SegmentHeader) + channelIndex(channel) * sizeof(ChannelHeader));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemorySegment::SlotHeader& SharedMemorySegment::slotHeader(const ChannelHeader& channelHeader, uint64_t number) const {
+  const size_t slotIndex = number % channelHeader.numSlots;
+  const size_t slotSize = sizeof(SlotHeader) + alignToCacheLine(channelHeader.slotCapacity);
+  return *reinterpret_cast<SlotHeader*>(data_ + channelHeader.slotsOffset + slotIndex * slotSize);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t SharedMemorySegment::write(Channel channel, const char* data, size_t size) {
+  auto& header = channelHeader(channel);
+  if (size > header.slotCapacity) {
+    throw std::runtime_error("[SharedMemorySegment::write] The message of " + std::to_string(size) +
+                             " bytes exceeds the slot capacity of " + std::to_string(header.slotCapacity) + " bytes.");
+  }
+
+  const uint64_t number = header.latestNumber.load(std::memory_order_relaxed) + 1;
+  auto& slot = slotHeader(header, number);
+  char* payload = reinterpret_cast<char*>(&slot) + sizeof(SlotHeader);
+
+  // an odd sequence marks the slot as being written
+  const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.number.store(number, std::memory_order_relaxed);
+  slot.size.store(size, std::memory_order_relaxed);
+  std::memcpy(payload, data, size);
+
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+  header.latestNumber.store(number, std::memory_order_release);
+
+  return number;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemorySegment::read(Channel channel, uint64_t& lastNumber, std::vector<char>& buffer) const {
+  const auto& header = channelHeader(channel);
+
+  for (size_t attempt = 0; attempt < maxNumReadAttempts; attempt++) {
+    const uint64_t number = header.latestNumber.load(std::memory_order_acquire);
+    if (number <= lastNumber) {
+      return false;
+    }
+
+    const auto& slot = slotHeader(header, number);
+    const char* payload = reinterpret_cast<const char*>(&slot) + sizeof(SlotHeader);
+    const uint64_t sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+    if (sequenceBefore % 2 != 0) {
+      continue;  // being written
+    }
+    const uint64_t size = slot.size.load(std::memory_order_relaxed);
+    if (slot.number.load(std::memory_order_relaxed) != number || size > header.slotCapacity) {
+      continue;  // the writer has overtaken the reader
+    }
+
+    buffer.resize(size);
+    std::memcpy(buffer.data(), payload, size);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+      lastNumber = number;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t SharedMemorySegment::latestNumber(Channel channel) const {
+  return channelHeader(channel).latestNumber.load(std::memory_order_acquire);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemorySegment::acknowledgeReset(uint64_t resetNumber) {
+  auto* segmentHeader = reinterpret_cast<SegmentHeader*>(data_);
+  segmentHeader->policyNumberAtReset.store(latestNumber(Channel::POLICY), std::memory_order_relaxed);
+  segmentHeader->acknowledgedReset.store(resetNumber, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t SharedMemorySegment::acknowledgedReset() const {
+  return reinterpret_cast<const SegmentHeader*>(data_)->acknowledgedReset.load(std::memory_order_acquire);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t SharedMemorySegment::policyNumberAtReset() const {
+  return reinterpret_cast<const SegmentHeader*>(data_)->policyNumberAtReset.load(std::memory_order_acquire);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemorySegment::acknowledgePolicy(uint64_t policyNumber) {
+  reinterpret_cast<SegmentHeader*>(data_)->acknowledgedPolicy.store(policyNumber, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint64_t SharedMemorySegment::acknowledgedPolicy() const {
+  return reinterpret_cast<const SegmentHeader*>(data_)->acknowledgedPolicy.load(std::memory_order_acquire);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void encodeObservation(const SystemObservation& observation, std::vector<char>& buffer) {
+  buffer.clear();
+  append(static_cast<uint64_t>(observation.mode), buffer);
+  append(observation.time, buffer);
+  append(observation.state, buffer);
+  append(observation.input, buffer);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decodeObservation(const std::vector<char>& buffer, SystemObservation& observation) {
+  MessageReader reader(buffer);
+  observation.mode = reader.read<uint64_t>();
+  observation.time = reader.read<scalar_t>();
+  reader.read(observation.state);
+  reader.read(observation.input);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void encodeTargetTrajectories(const TargetTrajectories& targetTrajectories, std::vector<char>& buffer) {
+  buffer.clear();
+  append(static_cast<uint64_t>(targetTrajectories.timeTrajectory.size()), buffer);
+  append(targetTrajectories.timeTrajectory.data(), targetTrajectories.timeTrajectory.size(), buffer);
+  append(static_cast<uint64_t>(targetTrajectories.stateTrajectory.size()), buffer);
+  for (const auto& state : targetTrajectories.stateTrajectory) {
+    append(state, buffer);
+  }
+  append(static_cast<uint64_t>(targetTrajectories.inputTrajectory.size()), buffer);
+  for (const auto& input : targetTrajectories.inputTrajectory) {
+    append(input, buffer);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void decodeTargetTrajectories(const std::vector<char>& buffer, TargetTrajectories& targetTrajectories) {
+  MessageReader reader(buffer);
+  targetTrajectories.timeTrajectory.resize(reader.readArraySize(sizeof(scalar_t)));
+  reader.read(targetTrajectories.timeTrajectory.data(), targetTrajectories.timeTrajectory.size());
+  targetTrajectories.stateTrajectory.resize(reader.readArraySize(sizeof(uint64_t)));
+  for (auto& state : targetTrajectories.stateTrajectory) {
+    reader.read(state);
+  }
+  targetTrajectories.inputTrajectory.resize(reader.readArraySize(sizeof(uint64_t)));
+  for (auto& input : targetTrajectories.inputTrajectory) {
+    reader.read(input);
+  }
+}
+
+}  // namespace shared_memory
+}  // namespace ocs2
@@ -0,0 +1,70 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_mpc/LatencyStatistics.h"
+
+using namespace ocs2;
+
+TEST(testLatencyStatistics, percentiles) {
+  LatencyStatistics latencyStatistics(200);
+  EXPECT_EQ(latencyStatistics.getNumSamples(), 0);
+  EXPECT_DOUBLE_EQ(latencyStatistics.getMedian(), 0.0);
+
+  // 1, 2, ..., 101 milliseconds in a shuffled order
+  for (size_t i = 0; i < 101; i++) {
+    latencyStatistics.addSample(1e-3 * (1 + (i * 37) % 101));
+  }
+  EXPECT_EQ(latencyStatistics.getNumSamples(), 101);
+  EXPECT_NEAR(latencyStatistics.getPercentile(0.0), 1e-3, 1e-12);
+  EXPECT_NEAR(latencyStatistics.getMedian(), 51e-3, 1e-12);
+  EXPECT_NEAR(latencyStatistics.getP99(), 100e-3, 1e-12);
+  EXPECT_NEAR(latencyStatistics.getPercentile(0.995), 100.5e-3, 1e-12);
+  EXPECT_NEAR(latencyStatistics.getPercentile(1.0), 101e-3, 1e-12);
+  EXPECT_NEAR(latencyStatistics.getMean(), 51e-3, 1e-12);
+  EXPECT_NEAR(latencyStatistics.getMax(), 101e-3, 1e-12);
+
+  EXPECT_THROW(latencyStatistics.getPercentile(1.5), std::runtime_error);
+
+  latencyStatistics.reset();
+  EXPECT_EQ(latencyStatistics.getNumSamples(), 0);
+}
+
+TEST(testLatencyStatistics, recentSamples) {
+  LatencyStatistics latencyStatistics(10);
+
+  // only the 10 most recent samples are kept
+  for (size_t i = 0; i < 100; i++) {
+    latencyStatistics.addSample(i < 90 ? 1.0 : 0.1);
+  }
+  EXPECT_EQ(latencyStatistics.getNumSamples(), 10);
+  EXPECT_DOUBLE_EQ(latencyStatistics.getMax(), 0.1);
+  EXPECT_DOUBLE_EQ(latencyStatistics.getMedian(), 0.1);
+}
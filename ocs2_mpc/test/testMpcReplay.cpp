@@ -0,0 +1,140 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "ocs2_mpc/MpcReplay.h"
+
+using namespace ocs2;
+
+namespace {
+std::vector<mpc_replay::Cycle> getCycles() {
+  std::vector<mpc_replay::Cycle> cycles(3);
+  for (size_t i = 0; i < cycles.size(); i++) {
+    const scalar_t time = 0.1 * i;
+    cycles[i].observation.mode = i;
+    cycles[i].observation.time = time;
+    cycles[i].observation.state = vector_t::Constant(4, time);
+    cycles[i].observation.input = vector_t::Constant(2, -time);
+  }
+  cycles[0].hasTargetTrajectories = true;
+  cycles[0].targetTrajectories = TargetTrajectories({0.0, 1.0}, {vector_t::Ones(4), vector_t::Zero(4)}, {vector_t::Zero(2)});
+  cycles[2].hasModeSchedule = true;
+  cycles[2].modeSchedule = ModeSchedule({0.5, 1.5}, {1, 3, 2});
+  cycles[2].hasTargetTrajectories = true;
+  cycles[2].targetTrajectories = TargetTrajectories({0.2}, {vector_t::Ones(4)}, {vector_t::Ones(2)});
+  return cycles;
+}
+
+const std::string logFileName = "/tmp/ocs2_testMpcReplay.log";
+}  // unnamed namespace
+
+TEST(testMpcReplay, logRoundTrip) {
+  const auto cycles = getCycles();
+  {
+    mpc_replay::LogWriter logWriter(logFileName);
+    for (const auto& cycle : cycles) {
+      logWriter.writeCycle(cycle);
+    }
+    // a trailing reference record without an observation is ignored
+    logWriter.writeModeSchedule(ModeSchedule());
+    logWriter.flush();
+  }
+
+  auto loadedCycles = mpc_replay::loadLog(logFileName);
+  std::remove(logFileName.c_str());
+
+  ASSERT_EQ(loadedCycles.size(), cycles.size());
+  for (size_t i = 0; i < cycles.size(); i++) {
+    const auto& expected = cycles[i];
+    auto& loaded = loadedCycles[i];
+    EXPECT_EQ(loaded.observation.mode, expected.observation.mode);
+    EXPECT_EQ(loaded.observation.time, expected.observation.time);
+    EXPECT_TRUE(loaded.observation.state == expected.observation.state);
+    EXPECT_TRUE(loaded.observation.input == expected.observation.input);
+    ASSERT_EQ(loaded.hasTargetTrajectories, expected.hasTargetTrajectories);
+    if (expected.hasTargetTrajectories) {
+      EXPECT_TRUE(loaded.targetTrajectories == expected.targetTrajectories);
+    }
+    ASSERT_EQ(loaded.hasModeSchedule, expected.hasModeSchedule);
+    if (expected.hasModeSchedule) {
+      EXPECT_EQ(loaded.modeSchedule.eventTimes, expected.modeSchedule.eventTimes);
+      EXPECT_EQ(loaded.modeSchedule.modeSequence, expected.modeSchedule.modeSequence);
+    }
+  }
+}
+
+TEST(testMpcReplay, invalidLog) {
+  EXPECT_THROW(mpc_replay::loadLog("/tmp/ocs2_testMpcReplay_missing.log"), std::runtime_error);
+
+  {
+    std::ofstream file(logFileName, std::ios::binary);
+    file << "not a replay log";
+  }
+  EXPECT_THROW(mpc_replay::loadLog(logFileName), std::runtime_error);
+
+  {
+    mpc_replay::LogWriter logWriter(logFileName);
+    logWriter.writeCycle(getCycles().front());
+  }
+  {
+    // drop the last bytes of the observation record
+    std::ifstream file(logFileName, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::ofstream truncatedFile(logFileName, std::ios::binary | std::ios::trunc);
+    truncatedFile.write(content.data(), content.size() - 4);
+  }
+  EXPECT_THROW(mpc_replay::loadLog(logFileName), std::runtime_error);
+  std::remove(logFileName.c_str());
+}
+
+TEST(testMpcReplay, writeStatistics) {
+  std::vector<mpc_replay::CycleStatistics> statistics(2);
+  statistics[1].time = 0.5;
+  statistics[1].numIterations = 3;
+  statistics[1].terminatedByDeadline = true;
+
+  std::stringstream stream;
+  mpc_replay::writeStatistics(statistics, stream);
+
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(stream, line)) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), statistics.size() + 1);
+  EXPECT_EQ(lines.front(), "time,latency,numIterations,cost,merit,terminatedByDeadline");
+  EXPECT_EQ(lines.back(), "0.5,0,3,0,0,1");
+}
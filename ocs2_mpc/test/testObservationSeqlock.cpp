@@ -0,0 +1,167 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "ocs2_mpc/ObservationSeqlock.h"
+
+using namespace ocs2;
+
+namespace {
+SystemObservation getObservation(scalar_t time, size_t stateDim, size_t inputDim) {
+  SystemObservation observation;
+  observation.mode = static_cast<size_t>(time);
+  observation.time = time;
+  observation.state = vector_t::Constant(stateDim, time);
+  observation.input = vector_t::Constant(inputDim, -time);
+  return observation;
+}
+}  // unnamed namespace
+
+TEST(testObservationSeqlock, writeRead) {
+  ObservationSeqlock observationSeqlock;
+  observationSeqlock.reserve(4, 2);
+
+  SystemObservation observation;
+  EXPECT_EQ(observationSeqlock.read(observation), 0);
+  EXPECT_EQ(observation.state.size(), 0);
+
+  observationSeqlock.write(getObservation(1.0, 4, 2));
+  observationSeqlock.write(getObservation(2.0, 4, 2));
+  EXPECT_EQ(observationSeqlock.read(observation), 2);
+  EXPECT_EQ(observation.mode, 2);
+  EXPECT_DOUBLE_EQ(observation.time, 2.0);
+  EXPECT_TRUE(observation.state.isApprox(vector_t::Constant(4, 2.0)));
+  EXPECT_TRUE(observation.input.isApprox(vector_t::Constant(2, -2.0)));
+
+  // an observation larger than the reserved dimensions
+  observationSeqlock.write(getObservation(3.0, 6, 3));
+  EXPECT_EQ(observationSeqlock.read(observation), 3);
+  EXPECT_EQ(observation.state.size(), 6);
+  EXPECT_EQ(observation.input.size(), 3);
+  EXPECT_DOUBLE_EQ(observation.state(5), 3.0);
+
+  // a smaller one
+  observationSeqlock.write(getObservation(4.0, 2, 0));
+  EXPECT_EQ(observationSeqlock.read(observation), 4);
+  EXPECT_EQ(observation.state.size(), 2);
+  EXPECT_EQ(observation.input.size(), 0);
+
+  // reserving empties the slot
+  observationSeqlock.reserve(4, 2);
+  EXPECT_EQ(observationSeqlock.read(observation), 0);
+}
+
+TEST(testObservationSeqlock, concurrentReadWrite) {
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 6;
+  constexpr size_t numWrites = 20000;
+
+  ObservationSeqlock observationSeqlock;
+  observationSeqlock.reserve(stateDim, inputDim);
+
+  std::atomic_bool writerDone{false};
+  std::thread writer([&]() {
+    auto observation = getObservation(0.0, stateDim, inputDim);
+    for (size_t i = 1; i <= numWrites; i++) {
+      const auto time = static_cast<scalar_t>(i);
+      observation.mode = i;
+      observation.time = time;
+      observation.state.setConstant(time);
+      observation.input.setConstant(-time);
+      observationSeqlock.write(observation);
+    }
+    writerDone = true;
+  });
+
+  // every snapshot should belong to a single observation and the snapshots should not go back in time
+  SystemObservation observation;
+  scalar_t previousTime = 0.0;
+  size_t numInconsistentReads = 0;
+  while (!writerDone) {
+    if (observationSeqlock.read(observation) > 0) {
+      const bool isConsistent = observation.mode == static_cast<size_t>(observation.time) &&
+                                (observation.state.array() == observation.time).all() &&
+                                (observation.input.array() == -observation.time).all();
+      numInconsistentReads += isConsistent ? 0 : 1;
+      EXPECT_GE(observation.time, previousTime);
+      previousTime = observation.time;
+    }
+  }
+  writer.join();
+
+  EXPECT_EQ(numInconsistentReads, 0);
+  EXPECT_EQ(observationSeqlock.read(observation), numWrites);
+  EXPECT_DOUBLE_EQ(observation.time, static_cast<scalar_t>(numWrites));
+}
+
+TEST(testObservationSeqlock, concurrentGrowingDimensions) {
+  constexpr size_t numWrites = 20000;
+  constexpr size_t numWritesPerDim = 50;
+  auto getStateDim = [&](size_t i) { return 1 + i / numWritesPerDim; };
+
+  ObservationSeqlock observationSeqlock;
+  observationSeqlock.reserve(1, 0);
+
+  // every write which increases the dimensions publishes a new slot
+  std::atomic_bool writerDone{false};
+  std::thread writer([&]() {
+    for (size_t i = 1; i <= numWrites; i++) {
+      const size_t stateDim = getStateDim(i);
+      observationSeqlock.write(getObservation(static_cast<scalar_t>(i), stateDim, stateDim / 2));
+    }
+    writerDone = true;
+  });
+
+  // every snapshot should have the dimensions and the values of a single observation
+  SystemObservation observation;
+  scalar_t previousTime = 0.0;
+  size_t numInconsistentReads = 0;
+  while (!writerDone) {
+    if (observationSeqlock.read(observation) > 0) {
+      const size_t stateDim = getStateDim(observation.mode);
+      const bool isConsistent = observation.mode == static_cast<size_t>(observation.time) &&
+                                static_cast<size_t>(observation.state.size()) == stateDim &&
+                                static_cast<size_t>(observation.input.size()) == stateDim / 2 &&
+                                (observation.state.array() == observation.time).all() &&
+                                (observation.input.array() == -observation.time).all();
+      numInconsistentReads += isConsistent ? 0 : 1;
+      EXPECT_GE(observation.time, previousTime);
+      previousTime = observation.time;
+    }
+  }
+  writer.join();
+
+  EXPECT_EQ(numInconsistentReads, 0);
+  EXPECT_EQ(observationSeqlock.read(observation), numWrites);
+  EXPECT_EQ(static_cast<size_t>(observation.state.size()), getStateDim(numWrites));
+}
@@ -0,0 +1,550 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** Creates a random policy with two events. */
+void createRandomPolicy(size_t numNodes, size_t stateDim, size_t inputDim, ControllerType controllerType, PrimalSolution& primalSolution,
+                        CommandData& commandData, PerformanceIndex& performanceIndex) {
+  primalSolution.timeTrajectory_.clear();
+  primalSolution.stateTrajectory_.clear();
+  primalSolution.inputTrajectory_.clear();
+  for (size_t k = 0; k < numNodes; k++) {
+    primalSolution.timeTrajectory_.push_back(0.01 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+  }
+  primalSolution.postEventIndices_ = {numNodes / 3, 2 * numNodes / 3};
+  primalSolution.modeSchedule_ = ModeSchedule({0.1, 0.2}, {3, 1, 4});
+
+  if (controllerType == ControllerType::LINEAR) {
+    matrix_array_t gainArray;
+    vector_array_t biasArray;
+    for (size_t k = 0; k < numNodes; k++) {
+      gainArray.push_back(matrix_t::Random(inputDim, stateDim));
+      biasArray.push_back(vector_t::Random(inputDim));
+    }
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  }
+
+  commandData.mpcInitObservation_.mode = 3;
+  commandData.mpcInitObservation_.time = 0.0;
+  commandData.mpcInitObservation_.state = vector_t::Random(stateDim);
+  commandData.mpcInitObservation_.input = vector_t::Random(inputDim);
+  commandData.mpcTargetTrajectories_ = TargetTrajectories({0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)});
+
+  performanceIndex.merit = 1.0;
+  performanceIndex.cost = 2.0;
+  performanceIndex.dynamicsViolationSSE = 3.0;
+  performanceIndex.equalityConstraintsSSE = 4.0;
+  performanceIndex.equalityLagrangian = 5.0;
+  performanceIndex.inequalityLagrangian = 6.0;
+}
+
+/** Creates the policy of the next MPC iteration: the base policy shifted by numShiftedNodes nodes and extended by as many new nodes. */
+void createShiftedPolicy(const PrimalSolution& basePrimalSolution, size_t numShiftedNodes, PrimalSolution& primalSolution) {
+  const auto& baseController = static_cast<const LinearController&>(*basePrimalSolution.controllerPtr_);
+  const size_t numNodes = basePrimalSolution.timeTrajectory_.size();
+  const size_t stateDim = basePrimalSolution.stateTrajectory_.front().size();
+  const size_t inputDim = basePrimalSolution.inputTrajectory_.front().size();
+
+  primalSolution = PrimalSolution();
+  primalSolution.postEventIndices_ = basePrimalSolution.postEventIndices_;
+  primalSolution.modeSchedule_ = basePrimalSolution.modeSchedule_;
+  matrix_array_t gainArray;
+  vector_array_t biasArray;
+  for (size_t k = numShiftedNodes; k < numNodes + numShiftedNodes; k++) {
+    if (k < numNodes) {
+      primalSolution.timeTrajectory_.push_back(basePrimalSolution.timeTrajectory_[k]);
+      primalSolution.stateTrajectory_.push_back(basePrimalSolution.stateTrajectory_[k]);
+      primalSolution.inputTrajectory_.push_back(basePrimalSolution.inputTrajectory_[k]);
+      gainArray.push_back(baseController.gainArray_[k]);
+      biasArray.push_back(baseController.biasArray_[k]);
+    } else {
+      primalSolution.timeTrajectory_.push_back(0.01 * k);
+      primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+      primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+      gainArray.push_back(matrix_t::Random(inputDim, stateDim));
+      biasArray.push_back(vector_t::Random(inputDim));
+    }
+  }
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+}
+
+void expectEqual(const PrimalSolution& lhs, const PrimalSolution& rhs, scalar_t gainTolerance) {
+  EXPECT_EQ(lhs.timeTrajectory_, rhs.timeTrajectory_);
+  EXPECT_EQ(lhs.postEventIndices_, rhs.postEventIndices_);
+  EXPECT_EQ(lhs.modeSchedule_.eventTimes, rhs.modeSchedule_.eventTimes);
+  EXPECT_EQ(lhs.modeSchedule_.modeSequence, rhs.modeSchedule_.modeSequence);
+  ASSERT_EQ(lhs.stateTrajectory_.size(), rhs.stateTrajectory_.size());
+  for (size_t k = 0; k < lhs.stateTrajectory_.size(); k++) {
+    EXPECT_TRUE(lhs.stateTrajectory_[k] == rhs.stateTrajectory_[k]);
+    EXPECT_TRUE(lhs.inputTrajectory_[k] == rhs.inputTrajectory_[k]);
+  }
+
+  ASSERT_EQ(lhs.controllerPtr_->getType(), rhs.controllerPtr_->getType());
+  if (lhs.controllerPtr_->getType() == ControllerType::LINEAR) {
+    const auto& lhsController = static_cast<const LinearController&>(*lhs.controllerPtr_);
+    const auto& rhsController = static_cast<const LinearController&>(*rhs.controllerPtr_);
+    EXPECT_EQ(lhsController.timeStamp_, rhsController.timeStamp_);
+    ASSERT_EQ(lhsController.gainArray_.size(), rhsController.gainArray_.size());
+    for (size_t k = 0; k < lhsController.gainArray_.size(); k++) {
+      EXPECT_TRUE(lhsController.biasArray_[k] == rhsController.biasArray_[k]);
+      EXPECT_TRUE(lhsController.gainArray_[k].isApprox(rhsController.gainArray_[k], gainTolerance));
+    }
+  } else {
+    const auto& lhsController = static_cast<const FeedforwardController&>(*lhs.controllerPtr_);
+    const auto& rhsController = static_cast<const FeedforwardController&>(*rhs.controllerPtr_);
+    EXPECT_EQ(lhsController.timeStamp_, rhsController.timeStamp_);
+    ASSERT_EQ(lhsController.uffArray_.size(), rhsController.uffArray_.size());
+    for (size_t k = 0; k < lhsController.uffArray_.size(); k++) {
+      EXPECT_TRUE(lhsController.uffArray_[k] == rhsController.uffArray_[k]);
+    }
+  }
+}
+
+void expectEqual(const CommandData& lhs, const CommandData& rhs) {
+  EXPECT_EQ(lhs.mpcInitObservation_.mode, rhs.mpcInitObservation_.mode);
+  EXPECT_EQ(lhs.mpcInitObservation_.time, rhs.mpcInitObservation_.time);
+  EXPECT_TRUE(lhs.mpcInitObservation_.state == rhs.mpcInitObservation_.state);
+  EXPECT_TRUE(lhs.mpcInitObservation_.input == rhs.mpcInitObservation_.input);
+  auto lhsTargetTrajectories = lhs.mpcTargetTrajectories_;
+  EXPECT_TRUE(lhsTargetTrajectories == rhs.mpcTargetTrajectories_);
+}
+
+void expectEqual(const PerformanceIndex& lhs, const PerformanceIndex& rhs) {
+  EXPECT_EQ(lhs.merit, rhs.merit);
+  EXPECT_EQ(lhs.cost, rhs.cost);
+  EXPECT_EQ(lhs.dynamicsViolationSSE, rhs.dynamicsViolationSSE);
+  EXPECT_EQ(lhs.equalityConstraintsSSE, rhs.equalityConstraintsSSE);
+  EXPECT_EQ(lhs.equalityLagrangian, rhs.equalityLagrangian);
+  EXPECT_EQ(lhs.inequalityLagrangian, rhs.inequalityLagrangian);
+}
+
+}  // unnamed namespace
+
+TEST(testPolicySerialization, roundTrip) {
+  constexpr size_t numNodes = 50;
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 6;
+
+  for (const auto controllerType : {ControllerType::LINEAR, ControllerType::FEEDFORWARD}) {
+    PrimalSolution primalSolution;
+    CommandData commandData;
+    PerformanceIndex performanceIndex;
+    createRandomPolicy(numNodes, stateDim, inputDim, controllerType, primalSolution, commandData, performanceIndex);
+
+    std::vector<char> buffer;
+    policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+
+    PrimalSolution decodedPrimalSolution;
+    CommandData decodedCommandData;
+    PerformanceIndex decodedPerformanceIndex;
+    policy_serialization::decodePolicy(policy_serialization::PolicyView(buffer), decodedPrimalSolution, decodedCommandData,
+                                       decodedPerformanceIndex);
+
+    expectEqual(primalSolution, decodedPrimalSolution, 0.0);
+    expectEqual(commandData, decodedCommandData);
+    expectEqual(performanceIndex, decodedPerformanceIndex);
+  }
+}
+
+TEST(testPolicySerialization, quantizedGains) {
+  constexpr size_t numNodes = 50;
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 6;
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+
+  std::vector<char> buffer;
+  std::vector<char> quantizedBuffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, quantizedBuffer, true);
+  EXPECT_EQ(buffer.size() - quantizedBuffer.size(), numNodes * stateDim * inputDim * sizeof(float));
+
+  const policy_serialization::PolicyView policyView(quantizedBuffer);
+  EXPECT_TRUE(policyView.hasQuantizedGains());
+
+  PrimalSolution decodedPrimalSolution;
+  CommandData decodedCommandData;
+  PerformanceIndex decodedPerformanceIndex;
+  policy_serialization::decodePolicy(policyView, decodedPrimalSolution, decodedCommandData, decodedPerformanceIndex);
+
+  expectEqual(primalSolution, decodedPrimalSolution, 1e-6);
+  expectEqual(commandData, decodedCommandData);
+  expectEqual(performanceIndex, decodedPerformanceIndex);
+}
+
+TEST(testPolicySerialization, zeroCopyView) {
+  constexpr size_t numNodes = 20;
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+
+  std::vector<char> buffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+  const policy_serialization::PolicyView policyView(buffer);
+
+  // the view maps the memory of the buffer
+  const auto stateTrajectory = policyView.stateTrajectory();
+  EXPECT_GE(reinterpret_cast<const char*>(stateTrajectory.data()), buffer.data());
+  EXPECT_LT(reinterpret_cast<const char*>(stateTrajectory.data()), buffer.data() + buffer.size());
+
+  ASSERT_EQ(policyView.numNodes(), numNodes);
+  ASSERT_EQ(stateTrajectory.rows(), stateDim);
+  ASSERT_EQ(stateTrajectory.cols(), numNodes);
+  const auto& controller = static_cast<const LinearController&>(*primalSolution.controllerPtr_);
+  for (size_t k = 0; k < numNodes; k++) {
+    EXPECT_EQ(policyView.timeTrajectory()(k), primalSolution.timeTrajectory_[k]);
+    EXPECT_TRUE(stateTrajectory.col(k) == primalSolution.stateTrajectory_[k]);
+    EXPECT_TRUE(policyView.inputTrajectory().col(k) == primalSolution.inputTrajectory_[k]);
+    EXPECT_TRUE(policyView.controllerBias().col(k) == controller.biasArray_[k]);
+    EXPECT_TRUE(policyView.gain(k) == controller.gainArray_[k]);
+  }
+  EXPECT_EQ(policyView.postEventIndices()[1], primalSolution.postEventIndices_[1]);
+  EXPECT_EQ(policyView.modeSequence()[2], primalSolution.modeSchedule_.modeSequence[2]);
+}
+
+TEST(testPolicySerialization, invalidBuffer) {
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(10, 3, 2, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+
+  std::vector<char> buffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+
+  // truncated
+  EXPECT_THROW(policy_serialization::PolicyView(buffer.data(), buffer.size() - 1), std::runtime_error);
+  EXPECT_THROW(policy_serialization::PolicyView(buffer.data(), sizeof(policy_serialization::Header) - 1), std::runtime_error);
+
+  // wrong version
+  auto wrongVersion = buffer;
+  reinterpret_cast<policy_serialization::Header*>(wrongVersion.data())->version += 1;
+  EXPECT_THROW(policy_serialization::PolicyView{wrongVersion}, std::runtime_error);
+
+  // not a policy
+  auto wrongMagic = buffer;
+  reinterpret_cast<policy_serialization::Header*>(wrongMagic.data())->magic = 0;
+  EXPECT_THROW(policy_serialization::PolicyView{wrongMagic}, std::runtime_error);
+
+  // a primal solution without controller
+  primalSolution.controllerPtr_.reset();
+  EXPECT_THROW(policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer), std::runtime_error);
+}
+
+TEST(testPolicySerialization, throughput) {
+  constexpr size_t numNodes = 200;
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 24;
+  constexpr size_t numRepetitions = 200;
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+
+  std::vector<char> buffer;
+  PrimalSolution decodedPrimalSolution;
+  CommandData decodedCommandData;
+  PerformanceIndex decodedPerformanceIndex;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+  const auto* bufferData = buffer.data();
+
+  benchmark::RepeatedTimer encodeTimer;
+  benchmark::RepeatedTimer decodeTimer;
+  benchmark::RepeatedTimer flattenTimer;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    encodeTimer.startTimer();
+    policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+    encodeTimer.endTimer();
+
+    decodeTimer.startTimer();
+    policy_serialization::decodePolicy(policy_serialization::PolicyView(buffer), decodedPrimalSolution, decodedCommandData,
+                                       decodedPerformanceIndex);
+    decodeTimer.endTimer();
+
+    // the element-wise flattening of the controller as done for the ROS message, for reference
+    flattenTimer.startTimer();
+    std::vector<std::vector<float>> flatData(numNodes);
+    std::vector<std::vector<float>*> flatDataPtrs;
+    for (auto& data : flatData) {
+      flatDataPtrs.push_back(&data);
+    }
+    primalSolution.controllerPtr_->flatten(primalSolution.timeTrajectory_, flatDataPtrs);
+    flattenTimer.endTimer();
+  }
+
+  // the buffer memory is reused
+  EXPECT_EQ(buffer.data(), bufferData);
+  expectEqual(primalSolution, decodedPrimalSolution, 0.0);
+
+  std::cerr << "Policy with " << numNodes << " nodes (" << buffer.size() / 1024 << " KiB):\n";
+  std::cerr << "  encode:                  " << encodeTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "  decode:                  " << decodeTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "  flatten controller only: " << flattenTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+TEST(testPolicySerialization, policyDelta) {
+  constexpr size_t numNodes = 100;
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 6;
+  constexpr size_t numShiftedNodes = 10;
+
+  // the base policy as decoded by the receiver
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+  std::vector<char> baseBuffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, baseBuffer);
+  PrimalSolution basePrimalSolution;
+  CommandData baseCommandData;
+  PerformanceIndex basePerformanceIndex;
+  policy_serialization::decodePolicy(policy_serialization::PolicyView(baseBuffer), basePrimalSolution, baseCommandData,
+                                     basePerformanceIndex);
+
+  // the next policy: shifted, the state of node 30 and the gain of node 50 are changed
+  createShiftedPolicy(basePrimalSolution, numShiftedNodes, primalSolution);
+  primalSolution.stateTrajectory_[30].array() += 1.0;
+  static_cast<LinearController&>(*primalSolution.controllerPtr_).gainArray_[50].array() += 1.0;
+  commandData.mpcInitObservation_.time = primalSolution.timeTrajectory_.front();
+  performanceIndex.cost = 0.5;
+  std::vector<char> buffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+
+  std::vector<char> delta;
+  ASSERT_TRUE(policy_serialization::encodePolicyDelta(basePrimalSolution, 7, primalSolution, commandData, performanceIndex, delta));
+  ASSERT_TRUE(policy_serialization::isPolicyDelta(delta.data(), delta.size()));
+  ASSERT_FALSE(policy_serialization::isPolicyDelta(buffer.data(), buffer.size()));
+
+  const auto deltaHeader = policy_serialization::readDeltaHeader(delta.data(), delta.size());
+  EXPECT_EQ(deltaHeader.baseNumber, 7);
+  EXPECT_EQ(deltaHeader.baseNumNodes, numNodes);
+  EXPECT_EQ(deltaHeader.timeShift, numShiftedNodes);
+  EXPECT_EQ(deltaHeader.policySize, buffer.size());
+  EXPECT_EQ(deltaHeader.numNodeRanges, 2);  // node 30 and the new nodes
+  EXPECT_EQ(deltaHeader.numGainRanges, 2);  // node 50 and the new nodes
+  EXPECT_LT(5 * delta.size(), buffer.size());
+
+  // a truncated delta or a wrong base policy are rejected before the base policy is modified
+  PrimalSolution wrongBasePrimalSolution;
+  createShiftedPolicy(basePrimalSolution, 0, wrongBasePrimalSolution);
+  wrongBasePrimalSolution.timeTrajectory_.pop_back();
+  EXPECT_THROW(policy_serialization::applyPolicyDelta(delta.data(), delta.size() - 8, basePrimalSolution, baseCommandData,
+                                                      basePerformanceIndex),
+               std::runtime_error);
+  EXPECT_THROW(policy_serialization::applyPolicyDelta(delta.data(), delta.size(), wrongBasePrimalSolution, baseCommandData,
+                                                      basePerformanceIndex),
+               std::runtime_error);
+
+  // the delta is applied in place: the unchanged nodes keep their memory
+  const auto* unchangedStateData = basePrimalSolution.stateTrajectory_[numShiftedNodes].data();
+  policy_serialization::applyPolicyDelta(delta.data(), delta.size(), basePrimalSolution, baseCommandData, basePerformanceIndex);
+  EXPECT_EQ(basePrimalSolution.stateTrajectory_.front().data(), unchangedStateData);
+
+  // the updated base policy is identical to the decoded policy
+  PrimalSolution decodedPrimalSolution;
+  CommandData decodedCommandData;
+  PerformanceIndex decodedPerformanceIndex;
+  policy_serialization::decodePolicy(policy_serialization::PolicyView(buffer), decodedPrimalSolution, decodedCommandData,
+                                     decodedPerformanceIndex);
+  expectEqual(decodedPrimalSolution, basePrimalSolution, 0.0);
+  expectEqual(decodedCommandData, baseCommandData);
+  expectEqual(decodedPerformanceIndex, basePerformanceIndex);
+
+  std::cerr << "Policy with " << numNodes << " nodes: " << buffer.size() / 1024 << " KiB, delta: " << delta.size() / 1024 << " KiB\n";
+}
+
+TEST(testPolicySerialization, policyDeltaTolerance) {
+  constexpr size_t numNodes = 50;
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+  constexpr scalar_t tolerance = 1e-6;
+
+  PrimalSolution basePrimalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::LINEAR, basePrimalSolution, commandData, performanceIndex);
+
+  // a drift below the tolerance is dropped until it accumulates beyond the tolerance
+  PrimalSolution primalSolution;
+  createShiftedPolicy(basePrimalSolution, 0, primalSolution);
+  std::vector<char> delta;
+  for (int i = 1; i <= 3; i++) {
+    primalSolution.stateTrajectory_[10].array() += 0.4 * tolerance;
+    ASSERT_TRUE(policy_serialization::encodePolicyDelta(basePrimalSolution, i, primalSolution, commandData, performanceIndex, delta,
+                                                        tolerance));
+    const auto deltaHeader = policy_serialization::readDeltaHeader(delta.data(), delta.size());
+    EXPECT_EQ(deltaHeader.numNodeRanges, i < 3 ? 0 : 1);
+    EXPECT_EQ(deltaHeader.numGainRanges, 0);
+    CommandData receivedCommandData;
+    PerformanceIndex receivedPerformanceIndex;
+    policy_serialization::applyPolicyDelta(delta.data(), delta.size(), basePrimalSolution, receivedCommandData, receivedPerformanceIndex);
+    EXPECT_LE((basePrimalSolution.stateTrajectory_[10] - primalSolution.stateTrajectory_[10]).lpNorm<Eigen::Infinity>(), tolerance);
+  }
+
+  // the quantized gains are compared in single precision
+  createShiftedPolicy(basePrimalSolution, 0, primalSolution);
+  ASSERT_TRUE(policy_serialization::encodePolicyDelta(basePrimalSolution, 1, primalSolution, commandData, performanceIndex, delta, 0.0,
+                                                      true));
+  EXPECT_EQ(policy_serialization::readDeltaHeader(delta.data(), delta.size()).numGainRanges, 1);
+  PrimalSolution quantizedPrimalSolution(basePrimalSolution);
+  CommandData receivedCommandData;
+  PerformanceIndex receivedPerformanceIndex;
+  policy_serialization::applyPolicyDelta(delta.data(), delta.size(), quantizedPrimalSolution, receivedCommandData,
+                                         receivedPerformanceIndex);
+  expectEqual(primalSolution, quantizedPrimalSolution, 1e-6);
+  ASSERT_TRUE(policy_serialization::encodePolicyDelta(quantizedPrimalSolution, 2, primalSolution, commandData, performanceIndex, delta,
+                                                      0.0, true));
+  EXPECT_EQ(policy_serialization::readDeltaHeader(delta.data(), delta.size()).numGainRanges, 0);
+
+  // the policies with different dimensions or controller types are not encoded as deltas
+  createRandomPolicy(numNodes, stateDim + 1, inputDim, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+  EXPECT_FALSE(policy_serialization::encodePolicyDelta(basePrimalSolution, 1, primalSolution, commandData, performanceIndex, delta));
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::FEEDFORWARD, primalSolution, commandData, performanceIndex);
+  EXPECT_FALSE(policy_serialization::encodePolicyDelta(basePrimalSolution, 1, primalSolution, commandData, performanceIndex, delta));
+}
+
+TEST(testPolicySerialization, policyDeltaThroughput) {
+  constexpr size_t numNodes = 200;
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 24;
+  constexpr size_t numShiftedNodes = 10;
+  constexpr size_t numRepetitions = 100;
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndex;
+  createRandomPolicy(numNodes, stateDim, inputDim, ControllerType::LINEAR, primalSolution, commandData, performanceIndex);
+  std::vector<char> buffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+  PrimalSolution basePrimalSolution;
+  CommandData decodedCommandData;
+  PerformanceIndex decodedPerformanceIndex;
+  policy_serialization::decodePolicy(policy_serialization::PolicyView(buffer), basePrimalSolution, decodedCommandData,
+                                     decodedPerformanceIndex);
+  createShiftedPolicy(basePrimalSolution, numShiftedNodes, primalSolution);
+
+  // the shared memory slot and the receiving buffer of the MRT
+  std::vector<char> slot(buffer.size());
+  std::vector<char> messageBuffer(buffer.size());
+  auto copyThroughSlot = [&](const std::vector<char>& message) {
+    std::memcpy(slot.data(), message.data(), message.size());
+    std::memcpy(messageBuffer.data(), slot.data(), message.size());
+  };
+
+  std::vector<char> delta;
+  PrimalSolution decodedPrimalSolution(basePrimalSolution);
+  PrimalSolution receivedPrimalSolution(basePrimalSolution);
+  const auto* decodedStateData = decodedPrimalSolution.stateTrajectory_.back().data();
+  const auto* decodedGainData = static_cast<const LinearController&>(*decodedPrimalSolution.controllerPtr_).gainArray_.back().data();
+
+  benchmark::RepeatedTimer fullEncodeTimer;
+  benchmark::RepeatedTimer fullCopyTimer;
+  benchmark::RepeatedTimer fullDecodeTimer;
+  benchmark::RepeatedTimer deltaEncodeTimer;
+  benchmark::RepeatedTimer deltaCopyTimer;
+  benchmark::RepeatedTimer deltaApplyTimer;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    // full policy
+    fullEncodeTimer.startTimer();
+    policy_serialization::encodePolicy(primalSolution, commandData, performanceIndex, buffer);
+    fullEncodeTimer.endTimer();
+
+    fullCopyTimer.startTimer();
+    copyThroughSlot(buffer);
+    fullCopyTimer.endTimer();
+
+    fullDecodeTimer.startTimer();
+    policy_serialization::decodePolicy(policy_serialization::PolicyView(buffer), decodedPrimalSolution, decodedCommandData,
+                                       decodedPerformanceIndex);
+    fullDecodeTimer.endTimer();
+
+    // policy delta against the base policy, compared directly with the primal solution
+    deltaEncodeTimer.startTimer();
+    ASSERT_TRUE(policy_serialization::encodePolicyDelta(basePrimalSolution, 1, primalSolution, commandData, performanceIndex, delta));
+    deltaEncodeTimer.endTimer();
+
+    deltaCopyTimer.startTimer();
+    copyThroughSlot(delta);
+    deltaCopyTimer.endTimer();
+
+    // the receiver holds the base policy again, its memory is kept
+    for (size_t k = 0; k < numNodes; k++) {
+      receivedPrimalSolution.stateTrajectory_[k] = basePrimalSolution.stateTrajectory_[k];
+      receivedPrimalSolution.inputTrajectory_[k] = basePrimalSolution.inputTrajectory_[k];
+    }
+    receivedPrimalSolution.timeTrajectory_ = basePrimalSolution.timeTrajectory_;
+    static_cast<LinearController&>(*receivedPrimalSolution.controllerPtr_) =
+        static_cast<const LinearController&>(*basePrimalSolution.controllerPtr_);
+
+    deltaApplyTimer.startTimer();
+    policy_serialization::applyPolicyDelta(messageBuffer.data(), delta.size(), receivedPrimalSolution, decodedCommandData,
+                                           decodedPerformanceIndex);
+    deltaApplyTimer.endTimer();
+  }
+
+  // the policy is decoded in place into the reused objects
+  EXPECT_EQ(decodedPrimalSolution.stateTrajectory_.back().data(), decodedStateData);
+  EXPECT_EQ(static_cast<const LinearController&>(*decodedPrimalSolution.controllerPtr_).gainArray_.back().data(), decodedGainData);
+  expectEqual(primalSolution, decodedPrimalSolution, 0.0);
+  expectEqual(primalSolution, receivedPrimalSolution, 0.0);
+  EXPECT_LT(5 * delta.size(), buffer.size());
+
+  std::cerr << "Policy with " << numNodes << " nodes, shifted by " << numShiftedNodes << " nodes:\n";
+  std::cerr << "  full:  " << buffer.size() << " [bytes], encode: " << fullEncodeTimer.getAverageInMilliseconds()
+            << " [ms], copy: " << fullCopyTimer.getAverageInMilliseconds()
+            << " [ms], decode: " << fullDecodeTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "  delta: " << delta.size() << " [bytes], encode: " << deltaEncodeTimer.getAverageInMilliseconds()
+            << " [ms], copy: " << deltaCopyTimer.getAverageInMilliseconds()
+            << " [ms], apply in place: " << deltaApplyTimer.getAverageInMilliseconds() << " [ms]\n";
+}
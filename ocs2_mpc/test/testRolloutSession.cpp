@@ -0,0 +1,168 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include "ocs2_mpc/MRT_BASE.h"
+#include "ocs2_mpc/RolloutSession.h"
+
+using namespace ocs2;
+
+namespace {
+/** An MRT which receives the policies directly from the test. */
+class TestMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories&) override {}
+  void setCurrentObservation(const SystemObservation&) override {}
+
+  void publishPolicy(const LinearController& controller, const ModeSchedule& modeSchedule) {
+    std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+    primalSolutionPtr->timeTrajectory_ = controller.timeStamp_;
+    primalSolutionPtr->modeSchedule_ = modeSchedule;
+    primalSolutionPtr->controllerPtr_.reset(controller.clone());
+    moveToBuffer(std::unique_ptr<CommandData>(new CommandData), std::move(primalSolutionPtr),
+                 std::unique_ptr<PerformanceIndex>(new PerformanceIndex));
+  }
+};
+}  // unnamed namespace
+
+class RolloutSessionTest : public testing::Test {
+ protected:
+  RolloutSessionTest()
+      : systemDynamics((matrix_t(2, 2) << 0.0, 1.0, -1.0, -0.2).finished(), (matrix_t(2, 1) << 0.0, 1.0).finished(),
+                       0.5 * matrix_t::Identity(2, 2)),
+        controller({0.0, 2.0}, {vector_t::Ones(1), vector_t::Ones(1)},
+                   {(matrix_t(1, 2) << -1.0, -0.5).finished(), (matrix_t(1, 2) << -1.0, -0.5).finished()}),
+        initState((vector_t(2) << 1.0, 0.0).finished()) {}
+
+  /** Reference solution with an accurate adaptive rollout */
+  vector_t rollout(scalar_t finalTime, ModeSchedule modeSchedule) {
+    rollout::Settings rolloutSettings;
+    rolloutSettings.integratorType = IntegratorType::ODE45;
+    rolloutSettings.absTolODE = 1e-12;
+    rolloutSettings.relTolODE = 1e-10;
+    TimeTriggeredRollout timeTriggeredRollout(systemDynamics, rolloutSettings);
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory, inputTrajectory;
+    return timeTriggeredRollout.run(0.0, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices,
+                                    stateTrajectory, inputTrajectory);
+  }
+
+  LinearSystemDynamics systemDynamics;
+  LinearController controller;
+  const vector_t initState;
+};
+
+TEST_F(RolloutSessionTest, ticks) {
+  const ModeSchedule modeSchedule;
+  constexpr scalar_t timeStep = 1e-3;
+  constexpr size_t numTicks = 1000;
+
+  RolloutSession rolloutSession(systemDynamics, timeStep);
+  rolloutSession.reset(0.0, initState, &controller);
+  for (size_t i = 1; i <= numTicks; i++) {
+    rolloutSession.advance(i * timeStep, modeSchedule);
+  }
+  EXPECT_DOUBLE_EQ(rolloutSession.getTime(), numTicks * timeStep);
+  EXPECT_TRUE(rolloutSession.getState().isApprox(rollout(numTicks * timeStep, modeSchedule), 1e-9));
+  EXPECT_TRUE(rolloutSession.getInput().isApprox(controller.computeInput(rolloutSession.getTime(), rolloutSession.getState())));
+
+  // a tick continues the session only from its current time and state
+  const vector_t state = rolloutSession.getState();
+  EXPECT_TRUE(rolloutSession.isAt(numTicks * timeStep, state));
+  EXPECT_FALSE(rolloutSession.isAt(numTicks * timeStep, state + vector_t::Constant(2, 1e-6)));
+  EXPECT_FALSE(rolloutSession.isAt(0.0, state));
+
+  EXPECT_THROW(rolloutSession.advance(0.0, modeSchedule), std::runtime_error);
+}
+
+TEST_F(RolloutSessionTest, events) {
+  const ModeSchedule modeSchedule({0.3005, 0.7}, {0, 1, 0});
+  constexpr scalar_t timeStep = 1e-3;
+  constexpr size_t numTicks = 1000;
+
+  RolloutSession rolloutSession(systemDynamics, 0.5 * timeStep);
+  rolloutSession.reset(0.0, initState, &controller);
+  for (size_t i = 1; i <= numTicks; i++) {
+    rolloutSession.advance(i * timeStep, modeSchedule);
+  }
+  EXPECT_TRUE(rolloutSession.getState().isApprox(rollout(numTicks * timeStep, modeSchedule), 1e-6));
+}
+
+TEST_F(RolloutSessionTest, mrtRolloutPolicy) {
+  const ModeSchedule modeSchedule({0.3005}, {0, 1});
+  constexpr scalar_t timeStep = 1e-3;
+  constexpr size_t numTicks = 500;
+
+  TestMrt mrt;
+  mrt.initRolloutSession(systemDynamics, timeStep);
+  ASSERT_TRUE(mrt.isRolloutSet());
+  mrt.publishPolicy(controller, modeSchedule);
+  ASSERT_TRUE(mrt.updatePolicy());
+
+  // the ticks which continue from the end of the previous one continue the session
+  scalar_t time = 0.0;
+  vector_t state = initState;
+  vector_t mpcState, mpcInput;
+  size_t mode = 0;
+  for (size_t i = 0; i < numTicks; i++) {
+    mrt.rolloutPolicy(time, state, timeStep, mpcState, mpcInput, mode);
+    time += timeStep;
+    state = mpcState;
+  }
+  EXPECT_TRUE(state.isApprox(rollout(time, modeSchedule), 1e-9));
+  EXPECT_EQ(mode, 1);
+
+  // a new policy restarts the session with its controller from the current time and state
+  LinearController newController = controller;
+  for (auto& bias : newController.biasArray_) {
+    bias.setConstant(-1.0);
+  }
+  mrt.publishPolicy(newController, modeSchedule);
+  ASSERT_TRUE(mrt.updatePolicy());
+  mrt.rolloutPolicy(time, state, timeStep, mpcState, mpcInput, mode);
+
+  RolloutSession rolloutSession(systemDynamics, timeStep);
+  rolloutSession.reset(time, state, &newController);
+  rolloutSession.advance(time + timeStep, modeSchedule);
+  EXPECT_TRUE(mpcState.isApprox(rolloutSession.getState()));
+  EXPECT_TRUE(mpcInput.isApprox(rolloutSession.getInput()));
+
+  // so does a tick which does not start from the end of the previous one
+  const vector_t otherState = state + vector_t::Constant(2, 0.1);
+  mrt.rolloutPolicy(time, otherState, timeStep, mpcState, mpcInput, mode);
+  rolloutSession.reset(time, otherState, &newController);
+  rolloutSession.advance(time + timeStep, modeSchedule);
+  EXPECT_TRUE(mpcState.isApprox(rolloutSession.getState()));
+}
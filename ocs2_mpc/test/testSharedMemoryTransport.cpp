@@ -0,0 +1,299 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_mpc/MRT_SharedMemory_Interface.h"
+#include "ocs2_mpc/PolicySerialization.h"
+#include "ocs2_mpc/SharedMemoryTransport.h"
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t stateDim = 4;
+constexpr size_t inputDim = 2;
+
+shared_memory::Settings getSettings() {
+  shared_memory::Settings settings;
+  settings.name_ = "/ocs2_mpc_test_" + std::to_string(::getpid());
+  settings.policySlotCapacity_ = 256 * 1024;
+  settings.messageSlotCapacity_ = 16 * 1024;
+  return settings;
+}
+
+/** Creates a linear policy whose time trajectory starts at the given time. */
+void createTestPolicy(scalar_t initTime, PrimalSolution& primalSolution, CommandData& commandData) {
+  constexpr size_t numNodes = 50;
+  primalSolution = PrimalSolution();
+  matrix_array_t gainArray;
+  vector_array_t biasArray;
+  for (size_t k = 0; k < numNodes; k++) {
+    primalSolution.timeTrajectory_.push_back(initTime + 0.01 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Constant(stateDim, initTime));
+    primalSolution.inputTrajectory_.push_back(vector_t::Constant(inputDim, initTime));
+    gainArray.push_back(matrix_t::Constant(inputDim, stateDim, initTime));
+    biasArray.push_back(vector_t::Constant(inputDim, initTime));
+  }
+  primalSolution.modeSchedule_ = ModeSchedule({}, {0});
+  primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+
+  commandData.mpcInitObservation_.time = initTime;
+  commandData.mpcInitObservation_.state = vector_t::Constant(stateDim, initTime);
+  commandData.mpcInitObservation_.input = vector_t::Zero(inputDim);
+  commandData.mpcTargetTrajectories_ = TargetTrajectories({initTime}, {vector_t::Zero(stateDim)}, {vector_t::Zero(inputDim)});
+}
+
+/** Creates an encoded linear policy whose time trajectory starts at the given time. */
+void encodeTestPolicy(scalar_t initTime, std::vector<char>& buffer) {
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  createTestPolicy(initTime, primalSolution, commandData);
+  policy_serialization::encodePolicy(primalSolution, commandData, PerformanceIndex(), buffer);
+}
+
+}  // unnamed namespace
+
+TEST(testSharedMemoryTransport, messageRoundTrip) {
+  SystemObservation observation;
+  observation.mode = 2;
+  observation.time = 1.5;
+  observation.state = vector_t::Random(stateDim);
+  observation.input = vector_t::Random(inputDim);
+
+  std::vector<char> buffer;
+  shared_memory::encodeObservation(observation, buffer);
+  SystemObservation decodedObservation;
+  shared_memory::decodeObservation(buffer, decodedObservation);
+  EXPECT_EQ(decodedObservation.mode, observation.mode);
+  EXPECT_DOUBLE_EQ(decodedObservation.time, observation.time);
+  EXPECT_TRUE(decodedObservation.state.isApprox(observation.state));
+  EXPECT_TRUE(decodedObservation.input.isApprox(observation.input));
+
+  const TargetTrajectories targetTrajectories({0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)},
+                                              {vector_t::Random(inputDim), vector_t::Random(inputDim)});
+  shared_memory::encodeTargetTrajectories(targetTrajectories, buffer);
+  TargetTrajectories decodedTargetTrajectories;
+  shared_memory::decodeTargetTrajectories(buffer, decodedTargetTrajectories);
+  EXPECT_TRUE(decodedTargetTrajectories == targetTrajectories);
+
+  buffer.resize(buffer.size() / 2);
+  EXPECT_THROW(shared_memory::decodeTargetTrajectories(buffer, decodedTargetTrajectories), std::runtime_error);
+}
+
+TEST(testSharedMemoryTransport, latestMessage) {
+  const auto settings = getSettings();
+  shared_memory::SharedMemorySegment writer(settings, true);
+  shared_memory::SharedMemorySegment reader(settings, false);
+
+  uint64_t lastNumber = 0;
+  std::vector<char> buffer;
+  EXPECT_FALSE(reader.read(shared_memory::Channel::POLICY, lastNumber, buffer));
+
+  // the reader only receives the latest message
+  for (int i = 1; i <= 10; i++) {
+    const std::vector<char> message(100 * i, static_cast<char>(i));
+    EXPECT_EQ(writer.write(shared_memory::Channel::POLICY, message.data(), message.size()), i);
+  }
+  ASSERT_TRUE(reader.read(shared_memory::Channel::POLICY, lastNumber, buffer));
+  EXPECT_EQ(lastNumber, 10);
+  EXPECT_EQ(buffer, std::vector<char>(1000, static_cast<char>(10)));
+  EXPECT_FALSE(reader.read(shared_memory::Channel::POLICY, lastNumber, buffer));
+
+  // the channels are independent
+  EXPECT_FALSE(reader.read(shared_memory::Channel::OBSERVATION, lastNumber = 0, buffer));
+
+  // too large messages are rejected
+  const std::vector<char> largeMessage(settings.messageSlotCapacity_ + 1);
+  EXPECT_THROW(writer.write(shared_memory::Channel::OBSERVATION, largeMessage.data(), largeMessage.size()), std::runtime_error);
+}
+
+TEST(testSharedMemoryTransport, openMissingSegment) {
+  auto settings = getSettings();
+  settings.name_ += "_missing";
+  EXPECT_THROW(shared_memory::SharedMemorySegment(settings, false), std::runtime_error);
+}
+
+TEST(testSharedMemoryTransport, policyDelta) {
+  const auto settings = getSettings();
+  shared_memory::SharedMemorySegment segment(settings, true);
+  MRT_SharedMemory_Interface mrt(settings);
+
+  // the full policy is acknowledged as the base of the next delta
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  createTestPolicy(0.0, primalSolution, commandData);
+  std::vector<char> policyBuffer;
+  policy_serialization::encodePolicy(primalSolution, commandData, PerformanceIndex(), policyBuffer);
+  auto policyNumber = segment.write(shared_memory::Channel::POLICY, policyBuffer.data(), policyBuffer.size());
+  ASSERT_TRUE(mrt.spinMRT());
+  EXPECT_EQ(segment.acknowledgedPolicy(), policyNumber);
+
+  // a delta of the last node, applied in place to the buffered policy
+  std::vector<char> delta;
+  const auto publishDelta = [&](scalar_t lastState) {
+    PrimalSolution basePrimalSolution(primalSolution);
+    primalSolution.stateTrajectory_.back()(0) = lastState;
+    ASSERT_TRUE(policy_serialization::encodePolicyDelta(basePrimalSolution, policyNumber, primalSolution, commandData, PerformanceIndex(),
+                                                        delta));
+    EXPECT_LT(5 * delta.size(), policyBuffer.size());
+    policyNumber = segment.write(shared_memory::Channel::POLICY, delta.data(), delta.size());
+  };
+  publishDelta(10.0);
+  ASSERT_TRUE(mrt.spinMRT());
+  EXPECT_EQ(segment.acknowledgedPolicy(), policyNumber);
+  ASSERT_TRUE(mrt.updatePolicy());
+  const auto* activePolicyPtr = &mrt.getPolicy();
+  EXPECT_DOUBLE_EQ(mrt.getPolicy().stateTrajectory_.back()(0), 10.0);
+  EXPECT_DOUBLE_EQ(mrt.getPolicy().stateTrajectory_.front()(0), 0.0);
+
+  // the next delta is deferred to updatePolicy() which applies it in place to the active policy
+  publishDelta(20.0);
+  ASSERT_TRUE(mrt.spinMRT());
+  EXPECT_DOUBLE_EQ(mrt.getPolicy().stateTrajectory_.back()(0), 10.0);
+  ASSERT_TRUE(mrt.updatePolicy());
+  EXPECT_EQ(&mrt.getPolicy(), activePolicyPtr);
+  EXPECT_DOUBLE_EQ(mrt.getPolicy().stateTrajectory_.back()(0), 20.0);
+  EXPECT_FALSE(mrt.updatePolicy());
+
+  // a delta against an unknown base policy is dropped and not acknowledged
+  const auto acknowledgedPolicy = segment.acknowledgedPolicy();
+  policyNumber += 100;
+  publishDelta(30.0);
+  EXPECT_FALSE(mrt.spinMRT());
+  EXPECT_EQ(segment.acknowledgedPolicy(), acknowledgedPolicy);
+  EXPECT_FALSE(mrt.updatePolicy());
+}
+
+TEST(testSharedMemoryTransport, recycledPolicies) {
+  const auto settings = getSettings();
+  shared_memory::SharedMemorySegment segment(settings, true);
+  MRT_SharedMemory_Interface mrt(settings);
+
+  // the policies are decoded into three objects which rotate through the decoding, the buffered, and the active policy
+  std::vector<char> policyBuffer;
+  std::vector<const PrimalSolution*> policyPtrs;
+  for (size_t i = 0; i < 6; i++) {
+    encodeTestPolicy(static_cast<scalar_t>(i), policyBuffer);
+    segment.write(shared_memory::Channel::POLICY, policyBuffer.data(), policyBuffer.size());
+    ASSERT_TRUE(mrt.spinMRT());
+    ASSERT_TRUE(mrt.updatePolicy());
+    EXPECT_DOUBLE_EQ(mrt.getPolicy().timeTrajectory_.front(), static_cast<scalar_t>(i));
+    policyPtrs.push_back(&mrt.getPolicy());
+  }
+  EXPECT_NE(policyPtrs[0], policyPtrs[1]);
+  EXPECT_NE(policyPtrs[1], policyPtrs[2]);
+  EXPECT_NE(policyPtrs[0], policyPtrs[2]);
+  for (size_t i = 3; i < policyPtrs.size(); i++) {
+    EXPECT_EQ(policyPtrs[i], policyPtrs[i - 3]);
+  }
+}
+
+/**
+ * The MRT runs in a child process. It requests a reset, waits for a policy published after the reset, and sends back an observation.
+ * The parent process mimics the MPC side.
+ */
+TEST(testSharedMemoryTransport, twoProcesses) {
+  const auto settings = getSettings();
+  shared_memory::SharedMemorySegment segment(settings, true);
+
+  // a policy published before the reset which should be ignored by the MRT
+  std::vector<char> policyBuffer;
+  encodeTestPolicy(-1.0, policyBuffer);
+  segment.write(shared_memory::Channel::POLICY, policyBuffer.data(), policyBuffer.size());
+
+  const pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+
+  if (pid == 0) {
+    // child: MRT
+    bool success = true;
+    try {
+      MRT_SharedMemory_Interface mrt(settings);
+      mrt.resetMpcNode(TargetTrajectories({0.0}, {vector_t::Ones(stateDim)}, {vector_t::Zero(inputDim)}));
+      mrt.launchSpinner();
+      while (!mrt.updatePolicy()) {
+        shared_memory::waitForPollingPeriod(settings);
+      }
+      mrt.shutdownSpinner();
+
+      const auto& policy = mrt.getPolicy();
+      success = success && policy.timeTrajectory_.size() == 50 && policy.timeTrajectory_.front() >= 0.0;
+      success = success && policy.stateTrajectory_.back().isApprox(vector_t::Constant(stateDim, policy.timeTrajectory_.front()));
+
+      SystemObservation observation;
+      observation.time = 42.0;
+      observation.state = vector_t::Ones(stateDim);
+      observation.input = vector_t::Zero(inputDim);
+      mrt.setCurrentObservation(observation);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << '\n';
+      success = false;
+    }
+    ::_exit(success ? 0 : 1);
+  }
+
+  // parent: MPC
+  uint64_t lastResetNumber = 0;
+  uint64_t lastObservationNumber = 0;
+  std::vector<char> messageBuffer;
+  SystemObservation observation;
+  bool resetReceived = false;
+  bool observationReceived = false;
+  for (size_t i = 0; i < 200000 && !observationReceived; i++) {
+    if (segment.read(shared_memory::Channel::RESET, lastResetNumber, messageBuffer)) {
+      TargetTrajectories targetTrajectories;
+      shared_memory::decodeTargetTrajectories(messageBuffer, targetTrajectories);
+      EXPECT_TRUE(targetTrajectories.stateTrajectory.front().isApprox(vector_t::Ones(stateDim)));
+      segment.acknowledgeReset(lastResetNumber);
+      resetReceived = true;
+    }
+    if (resetReceived) {
+      encodeTestPolicy(0.1 * i, policyBuffer);
+      segment.write(shared_memory::Channel::POLICY, policyBuffer.data(), policyBuffer.size());
+    }
+    if (segment.read(shared_memory::Channel::OBSERVATION, lastObservationNumber, messageBuffer)) {
+      shared_memory::decodeObservation(messageBuffer, observation);
+      observationReceived = true;
+    }
+    shared_memory::waitForPollingPeriod(settings);
+  }
+
+  int status = 0;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  EXPECT_TRUE(resetReceived);
+  ASSERT_TRUE(observationReceived);
+  EXPECT_DOUBLE_EQ(observation.time, 42.0);
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace scenario {
+
+/** This structure contains the settings for the scenario solver. */
+struct Settings {
+  /** The number of the perturbed problems, i.e., the scenarios. */
+  size_t numScenarios_ = 1;
+  /**
+   * The total number of the threads. The scenarios are solved concurrently on min(nThreads, numScenarios) threads, and the solver of each
+   * scenario is given the rest of the budget, nThreads / min(nThreads, numScenarios) threads but at least one. Hence, the scenario
+   * solvers are single threaded if there are at least as many scenarios as threads.
+   */
+  size_t nThreads_ = 1;
+  /** The priority of the threads. */
+  int threadPriority_ = 0;
+  /** The maximum number of the consensus iterations. Each iteration solves all the scenarios once. */
+  size_t maxNumConsensusIterations_ = 3;
+  /** The penalty of the deviation of the first input of a scenario from the consensus input. */
+  scalar_t consensusPenalty_ = 1.0;
+  /** The consensus iterations stop if the first inputs of all the scenarios are within this distance from the consensus input. */
+  scalar_t consensusTolerance_ = 1e-3;
+  /** The length of the time window at the beginning of the horizon in which the non-anticipativity penalty is active [s]. */
+  scalar_t nonAnticipativityWindow_ = 0.01;
+  /** Whether to print the consensus residual of each iteration. */
+  bool displayInfo_ = false;
+};
+
+/**
+ * Loads the scenario solver settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "scenario", bool verbose = true);
+
+}  // namespace scenario
+}  // namespace ocs2
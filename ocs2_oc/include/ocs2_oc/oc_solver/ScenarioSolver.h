@@ -0,0 +1,185 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_problem/OptimalControlProblem.h"
+#include "ocs2_oc/oc_solver/ScenarioSettings.h"
+#include "ocs2_oc/oc_solver/SolverBase.h"
+
+namespace ocs2 {
+
+/**
+ * A scenario solver for the robustness against model errors. It solves several perturbed copies of an optimal control problem, e.g., with
+ * different dynamics parameters provided through the PreComputation, concurrently on a shared thread pool. The first inputs of the
+ * scenarios are brought to a consensus by progressive hedging: each scenario is penalized for the deviation of its input from the
+ * consensus input at the beginning of the horizon, and the scenarios are solved again until their first inputs agree. All the scenarios
+ * are solved by the same type of solver with the same settings, hence they share the workspace shape.
+ *
+ * The solution of the solver is the solution of the first scenario, which is usually the nominal problem, with its first input replaced
+ * by the consensus input. The controller is shifted by the same correction at its first node if it is a linear or a feedforward
+ * controller. If the consensus is not reached, the first scenario is solved once more with the last consensus penalty, so that the rest
+ * of its solution is pulled towards the consensus input. The references of this solver are forwarded to all the scenarios before each
+ * run.
+ *
+ * The thread budget of scenario::Settings::nThreads_ is split between the concurrent scenarios and the scenario solvers, such that the
+ * nested thread pools do not oversubscribe the cores. The number of threads of a scenario solver is passed to the solver factory.
+ *
+ * @note The LQ approximation reuse of the multiple shooting solver (shiftWarmStart) should be disabled for the scenarios, as the
+ * non-anticipativity penalty changes between the consensus iterations while the references do not.
+ */
+class ScenarioSolver final : public SolverBase {
+ public:
+  /** Perturbs the copy of the optimal control problem of the given scenario. */
+  using perturbation_t = std::function<void(size_t scenarioIndex, OptimalControlProblem& optimalControlProblem)>;
+  /** Creates the solver of a scenario for its perturbed optimal control problem. The solver should use at most numThreads threads. */
+  using solver_factory_t =
+      std::function<std::unique_ptr<SolverBase>(const OptimalControlProblem& optimalControlProblem, size_t numThreads)>;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] settings: The scenario solver settings.
+   * @param [in] optimalControlProblem: The nominal optimal control problem, which is copied for each scenario.
+   * @param [in] perturbation: Perturbs the copy of the optimal control problem of each scenario.
+   * @param [in] solverFactory: Creates the solver of each scenario with its share of the thread budget.
+   */
+  ScenarioSolver(scenario::Settings settings, const OptimalControlProblem& optimalControlProblem, const perturbation_t& perturbation,
+                 const solver_factory_t& solverFactory);
+
+  ~ScenarioSolver() override = default;
+
+  void reset() override;
+
+  /** The number of the scenarios. */
+  size_t getNumScenarios() const { return scenarios_.size(); }
+
+  /** Gets the solver of a scenario. */
+  SolverBase& getScenarioSolver(size_t scenarioIndex) { return *scenarios_[scenarioIndex].solverPtr; }
+  const SolverBase& getScenarioSolver(size_t scenarioIndex) const { return *scenarios_[scenarioIndex].solverPtr; }
+
+  /** The consensus of the first inputs of the scenarios in the last run. */
+  const vector_t& getConsensusInput() const { return consensusInput_; }
+
+  /** The largest distance of the first input of a scenario from the consensus input in the last run. */
+  scalar_t getConsensusResidual() const { return consensusResidual_; }
+
+  /** The number of the consensus iterations in the last run. */
+  size_t getNumConsensusIterations() const { return numConsensusIterations_; }
+
+  /** Whether the first inputs of the scenarios reached the consensus tolerance in the last run. */
+  bool isConsensusConverged() const { return consensusConverged_; }
+
+  scalar_t getFinalTime() const override { return nominalSolver().getFinalTime(); }
+
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override;
+
+  const DualSolution& getDualSolution() const override { return nominalSolver().getDualSolution(); }
+
+  const ProblemMetrics& getSolutionMetrics() const override { return nominalSolver().getSolutionMetrics(); }
+
+  size_t getNumIterations() const override { return nominalSolver().getNumIterations(); }
+
+  const OptimalControlProblem& getOptimalControlProblem() const override { return nominalSolver().getOptimalControlProblem(); }
+
+  const PerformanceIndex& getPerformanceIndeces() const override { return nominalSolver().getPerformanceIndeces(); }
+
+  const std::vector<PerformanceIndex>& getIterationsLog() const override { return nominalSolver().getIterationsLog(); }
+
+  ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override {
+    return nominalSolver().getValueFunction(time, state);
+  }
+
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override {
+    return scenarios_.front().solverPtr->getHamiltonian(time, state, input);
+  }
+
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override {
+    return nominalSolver().getStateInputEqualityConstraintLagrangian(time, state);
+  }
+
+  MultiplierCollection getIntermediateDualSolution(scalar_t time) const override {
+    return nominalSolver().getIntermediateDualSolution(time);
+  }
+
+  std::string getBenchmarkingInfo() const override { return nominalSolver().getBenchmarkingInfo(); }
+
+ private:
+  /** The non-anticipativity penalty of a scenario, it is shared with the cost term in the problem of the scenario. */
+  struct Consensus {
+    scalar_t startTime = 0.0;
+    bool isActive = false;
+    vector_t input;       // the consensus input
+    vector_t multiplier;  // the multiplier of the non-anticipativity constraint of the scenario
+  };
+
+  /** The non-anticipativity penalty as a cost term. */
+  class NonAnticipativityCost;
+
+  struct Scenario {
+    std::shared_ptr<Consensus> consensusPtr;
+    std::unique_ptr<SolverBase> solverPtr;
+    PrimalSolution primalSolution;
+  };
+
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
+
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) override;
+
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override;
+
+  /** Runs the consensus iterations. The first solve of each scenario is performed by the given function. */
+  void runConsensus(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const std::function<void(SolverBase&)>& firstSolve);
+
+  /** Solves all the scenarios concurrently. */
+  void solveScenarios(const std::function<void(SolverBase&)>& solve);
+
+  /** Updates the consensus input and the multipliers from the first inputs of the scenarios. Returns the consensus residual. */
+  scalar_t updateConsensus(scalar_t initTime, scalar_t finalTime);
+
+  const SolverBase& nominalSolver() const { return *scenarios_.front().solverPtr; }
+
+  scenario::Settings settings_;
+  size_t numConcurrentScenarios_;  // the number of the scenarios which are solved concurrently
+  ThreadPool threadPool_;
+  std::vector<Scenario> scenarios_;
+
+  vector_t consensusInput_;
+  scalar_t consensusResidual_ = 0.0;
+  size_t numConsensusIterations_ = 0;
+  bool consensusConverged_ = false;
+};
+
+}  // namespace ocs2
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -102,6 +103,18 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution);
 
+  /**
+   * Sets a wall-clock deadline for the next call of the "run" routine. The solver terminates at the first iteration or line-search
+   * boundary at which the next phase is not expected to finish before the deadline, and it keeps its best iterate. At least one
+   * iteration is performed. The deadline is cleared at the end of the run.
+   *
+   * @param [in] deadline: The time point at which the solver should have returned.
+   */
+  void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
+  /** Whether the last call of the "run" routine has been terminated by the deadline. */
+  bool isTerminatedByDeadline() const { return terminatedByDeadline_; }
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -254,6 +267,19 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /** Gets the deadline of the current run. It is the maximum time point if no deadline is set. */
+  std::chrono::steady_clock::time_point getDeadline() const { return deadline_; }
+
+  /**
+   * Checks whether a phase of the solver with the given expected duration finishes before the deadline. If not, the current run is
+   * flagged as terminated by the deadline.
+   *
+   * @param [in] expectedDurationInMilliseconds: The expected duration of the phase, e.g., the average of its timer.
+   * @return Whether the phase fits before the deadline.
+   */
+  bool fitsBeforeDeadline(scalar_t expectedDurationInMilliseconds);
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -272,6 +298,8 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<AugmentedLagrangianObserver>> augmentedLagrangianObservers_;
+  std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+  bool terminatedByDeadline_ = false;
 };
 
 }  // namespace ocs2
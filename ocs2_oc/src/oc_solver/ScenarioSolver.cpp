@@ -0,0 +1,295 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_solver/ScenarioSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/cost/StateInputCost.h>
+
+namespace ocs2 {
+
+/**
+ * The progressive hedging penalty of a scenario: w' u + rho/2 |u - u_c|^2, where w is the multiplier of the scenario and u_c is the
+ * consensus input. It is active in a short window at the beginning of the horizon and it is scaled by the inverse of the window length,
+ * so that its integral is the penalty of the first input.
+ */
+class ScenarioSolver::NonAnticipativityCost final : public StateInputCost {
+ public:
+  NonAnticipativityCost(std::shared_ptr<const Consensus> consensusPtr, scalar_t penalty, scalar_t window)
+      : consensusPtr_(std::move(consensusPtr)), penalty_(penalty), window_(window) {}
+
+  ~NonAnticipativityCost() override = default;
+
+  NonAnticipativityCost* clone() const override { return new NonAnticipativityCost(*this); }
+
+  bool isActive(scalar_t time) const override {
+    return consensusPtr_->isActive && time >= consensusPtr_->startTime && time < consensusPtr_->startTime + window_;
+  }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    const auto& consensus = *consensusPtr_;
+    return (consensus.multiplier.dot(input) + 0.5 * penalty_ * (input - consensus.input).squaredNorm()) / window_;
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    const auto& consensus = *consensusPtr_;
+    auto cost = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+    cost.f = getValue(time, state, input, targetTrajectories, preComp);
+    cost.dfdu = (consensus.multiplier + penalty_ * (input - consensus.input)) / window_;
+    cost.dfduu.diagonal().setConstant(penalty_ / window_);
+    return cost;
+  }
+
+ private:
+  NonAnticipativityCost(const NonAnticipativityCost& other) = default;
+
+  std::shared_ptr<const Consensus> consensusPtr_;
+  scalar_t penalty_;
+  scalar_t window_;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScenarioSolver::ScenarioSolver(scenario::Settings settings, const OptimalControlProblem& optimalControlProblem,
+                               const perturbation_t& perturbation, const solver_factory_t& solverFactory)
+    : settings_(std::move(settings)),
+      numConcurrentScenarios_(std::max(std::min(settings_.nThreads_, settings_.numScenarios_), size_t(1))),
+      threadPool_(numConcurrentScenarios_ - 1, settings_.threadPriority_) {
+  if (settings_.numScenarios_ < 1) {
+    throw std::runtime_error("[ScenarioSolver::ScenarioSolver] There should be at least one scenario!");
+  }
+  if (settings_.nonAnticipativityWindow_ <= 0.0) {
+    throw std::runtime_error("[ScenarioSolver::ScenarioSolver] The non-anticipativity window should be positive!");
+  }
+
+  // the rest of the thread budget is shared by the concurrent scenarios
+  const size_t numThreadsPerScenario = std::max(settings_.nThreads_ / numConcurrentScenarios_, size_t(1));
+
+  scenarios_.resize(settings_.numScenarios_);
+  for (size_t i = 0; i < scenarios_.size(); i++) {
+    auto& scenario = scenarios_[i];
+    scenario.consensusPtr = std::make_shared<Consensus>();
+
+    OptimalControlProblem scenarioProblem(optimalControlProblem);
+    perturbation(i, scenarioProblem);
+    scenarioProblem.costPtr->add("nonAnticipativity",
+                                 std::unique_ptr<StateInputCost>(new NonAnticipativityCost(
+                                     scenario.consensusPtr, settings_.consensusPenalty_, settings_.nonAnticipativityWindow_)));
+
+    scenario.solverPtr = solverFactory(scenarioProblem, numThreadsPerScenario);
+    if (scenario.solverPtr == nullptr) {
+      throw std::runtime_error("[ScenarioSolver::ScenarioSolver] The solver factory returned a nullptr!");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::reset() {
+  for (auto& scenario : scenarios_) {
+    *scenario.consensusPtr = Consensus();
+    scenario.solverPtr->reset();
+    scenario.primalSolution = PrimalSolution();
+  }
+  consensusInput_ = vector_t();
+  consensusResidual_ = 0.0;
+  numConsensusIterations_ = 0;
+  consensusConverged_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const {
+  nominalSolver().getPrimalSolution(finalTime, primalSolutionPtr);
+
+  // publish the consensus input as the first input, even if the first input of the nominal scenario is not within the tolerance
+  auto& inputTrajectory = primalSolutionPtr->inputTrajectory_;
+  if (consensusInput_.size() == 0 || inputTrajectory.empty() || inputTrajectory.front().size() != consensusInput_.size()) {
+    return;
+  }
+  const vector_t correction = consensusInput_ - inputTrajectory.front();
+  inputTrajectory.front() = consensusInput_;
+
+  auto* controllerPtr = primalSolutionPtr->controllerPtr_.get();
+  if (auto* linearControllerPtr = dynamic_cast<LinearController*>(controllerPtr)) {
+    if (!linearControllerPtr->biasArray_.empty()) {
+      linearControllerPtr->biasArray_.front() += correction;
+    }
+  } else if (auto* feedforwardControllerPtr = dynamic_cast<FeedforwardController*>(controllerPtr)) {
+    if (!feedforwardControllerPtr->uffArray_.empty()) {
+      feedforwardControllerPtr->uffArray_.front() += correction;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runConsensus(initTime, initState, finalTime, [&](SolverBase& solver) { solver.run(initTime, initState, finalTime); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                             const ControllerBase* externalControllerPtr) {
+  runConsensus(initTime, initState, finalTime,
+               [&](SolverBase& solver) { solver.run(initTime, initState, finalTime, externalControllerPtr); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) {
+  runConsensus(initTime, initState, finalTime, [&](SolverBase& solver) { solver.run(initTime, initState, finalTime, primalSolution); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::runConsensus(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                  const std::function<void(SolverBase&)>& firstSolve) {
+  // forward the references and start without the non-anticipativity penalty
+  const auto& referenceManager = getReferenceManager();
+  for (auto& scenario : scenarios_) {
+    scenario.solverPtr->getReferenceManager().setTargetTrajectories(referenceManager.getTargetTrajectories());
+    scenario.solverPtr->getReferenceManager().setModeSchedule(referenceManager.getModeSchedule());
+    *scenario.consensusPtr = Consensus();
+    scenario.consensusPtr->startTime = initTime;
+  }
+
+  numConsensusIterations_ = 0;
+  scalar_t iterationDuration = 0.0;
+  while (true) {
+    const auto startTime = std::chrono::steady_clock::now();
+    if (numConsensusIterations_ == 0) {
+      solveScenarios(firstSolve);
+    } else {
+      solveScenarios([&](SolverBase& solver) { solver.run(initTime, initState, finalTime); });
+    }
+    numConsensusIterations_++;
+    consensusResidual_ = updateConsensus(initTime, finalTime);
+    iterationDuration = std::chrono::duration<scalar_t, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (settings_.displayInfo_) {
+      std::cerr << "[ScenarioSolver] consensus iteration: " << numConsensusIterations_ << ", residual: " << consensusResidual_ << '\n';
+    }
+    if (consensusResidual_ <= settings_.consensusTolerance_ || numConsensusIterations_ >= settings_.maxNumConsensusIterations_ ||
+        !fitsBeforeDeadline(iterationDuration)) {
+      break;
+    }
+  }
+
+  // the first scenario is solved once more with the last consensus penalty, so that its solution is pulled towards the consensus input
+  consensusConverged_ = consensusResidual_ <= settings_.consensusTolerance_;
+  if (!consensusConverged_) {
+    if (settings_.displayInfo_) {
+      std::cerr << "[ScenarioSolver] the consensus is not reached after " << numConsensusIterations_
+                << " iterations, residual: " << consensusResidual_ << '\n';
+    }
+    const auto numSolvesPerThread = (scenarios_.size() + numConcurrentScenarios_ - 1) / numConcurrentScenarios_;
+    if (fitsBeforeDeadline(iterationDuration / static_cast<scalar_t>(numSolvesPerThread))) {
+      auto& nominalSolver = *scenarios_.front().solverPtr;
+      nominalSolver.setDeadline(getDeadline());
+      nominalSolver.run(initTime, initState, finalTime);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ScenarioSolver::solveScenarios(const std::function<void(SolverBase&)>& solve) {
+  const auto deadline = getDeadline();
+  std::atomic_size_t nextScenario{0};
+  auto task = [&](int) {
+    size_t i;
+    while ((i = nextScenario++) < scenarios_.size()) {
+      auto& solver = *scenarios_[i].solverPtr;
+      solver.setDeadline(deadline);
+      solve(solver);
+    }
+  };
+  threadPool_.runParallel(std::move(task), numConcurrentScenarios_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t ScenarioSolver::updateConsensus(scalar_t initTime, scalar_t finalTime) {
+  // the consensus input is the average of the first inputs
+  for (size_t i = 0; i < scenarios_.size(); i++) {
+    auto& scenario = scenarios_[i];
+    scenario.solverPtr->getPrimalSolution(finalTime, &scenario.primalSolution);
+    if (scenario.primalSolution.inputTrajectory_.empty()) {
+      throw std::runtime_error("[ScenarioSolver::updateConsensus] The solution of scenario " + std::to_string(i) + " is empty!");
+    }
+    const auto& firstInput = scenario.primalSolution.inputTrajectory_.front();
+    if (i == 0) {
+      consensusInput_ = firstInput;
+    } else {
+      consensusInput_ += firstInput;
+    }
+  }
+  consensusInput_ /= static_cast<scalar_t>(scenarios_.size());
+
+  // progressive hedging update of the multipliers
+  scalar_t residual = 0.0;
+  for (auto& scenario : scenarios_) {
+    const vector_t deviation = scenario.primalSolution.inputTrajectory_.front() - consensusInput_;
+    residual = std::max(residual, deviation.norm());
+
+    auto& consensus = *scenario.consensusPtr;
+    if (!consensus.isActive) {
+      consensus.multiplier = vector_t::Zero(consensusInput_.size());
+      consensus.isActive = true;
+    }
+    consensus.startTime = initTime;
+    consensus.input = consensusInput_;
+    consensus.multiplier += settings_.consensusPenalty_ * deviation;
+  }
+
+  return residual;
+}
+
+}  // namespace ocs2
@@ -79,6 +79,19 @@ PrimalSolution SolverBase::primalSolution(scalar_t finalTime) const {
   return primalSolution;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SolverBase::fitsBeforeDeadline(scalar_t expectedDurationInMilliseconds) {
+  if (deadline_ == std::chrono::steady_clock::time_point::max()) {
+    return true;
+  }
+  const auto expectedDuration = std::chrono::duration<scalar_t, std::milli>(expectedDurationInMilliseconds);
+  const bool fits = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::nanoseconds>(expectedDuration) <= deadline_;
+  terminatedByDeadline_ = terminatedByDeadline_ || !fits;
+  return fits;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -91,6 +104,7 @@ void SolverBase::printString(const std::string& text) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  terminatedByDeadline_ = false;
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
@@ -102,6 +116,8 @@ void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t f
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::postRun() {
+  deadline_ = std::chrono::steady_clock::time_point::max();
+
   if (!synchronizedModules_.empty() || !augmentedLagrangianObservers_.empty()) {
     const auto solution = primalSolution(getFinalTime());
     for (auto& module : synchronizedModules_) {
@@ -0,0 +1,232 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/cost/StateInputCost.h>
+
+#include "ocs2_oc/oc_solver/ScenarioSolver.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** The cost 0.5 |u - target|^2. */
+class InputTargetCost final : public StateInputCost {
+ public:
+  explicit InputTargetCost(vector_t target) : target_(std::move(target)) {}
+  InputTargetCost* clone() const override { return new InputTargetCost(*this); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories&,
+                    const PreComputation&) const override {
+    return 0.5 * (input - target_).squaredNorm();
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    auto cost = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+    cost.f = getValue(time, state, input, targetTrajectories, preComp);
+    cost.dfdu = input - target_;
+    cost.dfduu.setIdentity();
+    return cost;
+  }
+
+ private:
+  vector_t target_;
+};
+
+/** A solver whose input minimizes the cost at the initial time. It is exact for the costs which are quadratic in the input. */
+class InputMinimizingSolver final : public SolverBase {
+ public:
+  InputMinimizingSolver(const OptimalControlProblem& optimalControlProblem, size_t inputDim)
+      : optimalControlProblem_(optimalControlProblem), inputDim_(inputDim) {}
+
+  ~InputMinimizingSolver() override = default;
+
+  void reset() override { numRuns_ = 0; }
+
+  size_t getNumRuns() const { return numRuns_; }
+
+  scalar_t getFinalTime() const override { return primalSolution_.timeTrajectory_.back(); }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
+  const DualSolution& getDualSolution() const override { throw std::runtime_error("not implemented"); }
+  const ProblemMetrics& getSolutionMetrics() const override { throw std::runtime_error("not implemented"); }
+  size_t getNumIterations() const override { return numRuns_; }
+  const OptimalControlProblem& getOptimalControlProblem() const override { return optimalControlProblem_; }
+  const PerformanceIndex& getPerformanceIndeces() const override { return performanceIndex_; }
+  const std::vector<PerformanceIndex>& getIterationsLog() const override { return iterationsLog_; }
+  ScalarFunctionQuadraticApproximation getValueFunction(scalar_t, const vector_t&) const override {
+    throw std::runtime_error("not implemented");
+  }
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t, const vector_t&, const vector_t&) override {
+    throw std::runtime_error("not implemented");
+  }
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t, const vector_t&) const override {
+    throw std::runtime_error("not implemented");
+  }
+  MultiplierCollection getIntermediateDualSolution(scalar_t) const override { throw std::runtime_error("not implemented"); }
+
+ private:
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    const auto& preComputation = *optimalControlProblem_.preComputationPtr;
+    const auto cost = optimalControlProblem_.costPtr->getQuadraticApproximation(initTime, initState, vector_t::Zero(inputDim_),
+                                                                                TargetTrajectories(), preComputation);
+    const vector_t input = cost.dfduu.ldlt().solve(-cost.dfdu);
+
+    primalSolution_.timeTrajectory_ = {initTime, finalTime};
+    primalSolution_.stateTrajectory_ = {initState, initState};
+    primalSolution_.inputTrajectory_ = {input, input};
+    primalSolution_.controllerPtr_.reset(new FeedforwardController(primalSolution_.timeTrajectory_, primalSolution_.inputTrajectory_));
+    numRuns_++;
+  }
+
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase*) override {
+    runImpl(initTime, initState, finalTime);
+  }
+
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution&) override {
+    runImpl(initTime, initState, finalTime);
+  }
+
+  OptimalControlProblem optimalControlProblem_;
+  const size_t inputDim_;
+  size_t numRuns_ = 0;
+  PrimalSolution primalSolution_;
+  PerformanceIndex performanceIndex_;
+  std::vector<PerformanceIndex> iterationsLog_;
+};
+
+}  // unnamed namespace
+
+class ScenarioSolverTest : public testing::Test {
+ protected:
+  /** The scenarios disagree on the input target, the consensus is their average. */
+  static constexpr size_t numScenarios = 3;
+  const std::vector<scalar_t> inputTargets{1.0, 2.0, 6.0};
+  const scalar_t averageInputTarget = 3.0;
+
+  std::unique_ptr<ScenarioSolver> createSolver(const scenario::Settings& settings) {
+    const auto perturbation = [&](size_t scenarioIndex, OptimalControlProblem& problem) {
+      problem.costPtr->add("inputTarget",
+                           std::unique_ptr<StateInputCost>(new InputTargetCost(vector_t::Constant(1, inputTargets[scenarioIndex]))));
+    };
+    const auto solverFactory = [&](const OptimalControlProblem& problem, size_t numThreads) {
+      numThreadsPerScenario.push_back(numThreads);
+      return std::unique_ptr<SolverBase>(new InputMinimizingSolver(problem, 1));
+    };
+    return std::unique_ptr<ScenarioSolver>(new ScenarioSolver(settings, OptimalControlProblem(), perturbation, solverFactory));
+  }
+
+  static scenario::Settings getSettings() {
+    scenario::Settings settings;
+    settings.numScenarios_ = numScenarios;
+    settings.nThreads_ = numScenarios;
+    settings.consensusPenalty_ = 0.01;
+    settings.nonAnticipativityWindow_ = 0.01;
+    settings.consensusTolerance_ = 1e-6;
+    settings.maxNumConsensusIterations_ = 100;
+    return settings;
+  }
+
+  const vector_t initState = vector_t::Zero(1);
+  std::vector<size_t> numThreadsPerScenario;
+};
+
+constexpr size_t ScenarioSolverTest::numScenarios;
+
+TEST_F(ScenarioSolverTest, consensus) {
+  auto solverPtr = createSolver(getSettings());
+  solverPtr->run(0.0, initState, 1.0);
+
+  EXPECT_TRUE(solverPtr->isConsensusConverged());
+  EXPECT_GT(solverPtr->getNumConsensusIterations(), 1);
+  EXPECT_LE(solverPtr->getConsensusResidual(), 1e-6);
+  EXPECT_NEAR(solverPtr->getConsensusInput()(0), averageInputTarget, 1e-6);
+
+  // the published first input is the consensus input
+  EXPECT_NEAR(solverPtr->primalSolution(1.0).inputTrajectory_.front()(0), averageInputTarget, 1e-6);
+}
+
+TEST_F(ScenarioSolverTest, nonConvergence) {
+  auto settings = getSettings();
+  settings.maxNumConsensusIterations_ = 1;
+  auto solverPtr = createSolver(settings);
+  solverPtr->run(0.0, initState, 1.0);
+
+  // the scenarios are solved without the non-anticipativity penalty, hence they disagree
+  EXPECT_FALSE(solverPtr->isConsensusConverged());
+  EXPECT_EQ(solverPtr->getNumConsensusIterations(), 1);
+  EXPECT_NEAR(solverPtr->getConsensusResidual(), inputTargets.back() - averageInputTarget, 1e-9);
+
+  // only the nominal scenario is solved again with the last consensus penalty, which pulls its first input to the consensus input
+  const auto& nominalSolver = static_cast<const InputMinimizingSolver&>(solverPtr->getScenarioSolver(0));
+  EXPECT_EQ(nominalSolver.getNumRuns(), 2);
+  for (size_t i = 1; i < numScenarios; i++) {
+    EXPECT_EQ(static_cast<const InputMinimizingSolver&>(solverPtr->getScenarioSolver(i)).getNumRuns(), 1);
+  }
+  EXPECT_NEAR(solverPtr->primalSolution(1.0).inputTrajectory_.front()(0), averageInputTarget, 1e-9);
+}
+
+TEST_F(ScenarioSolverTest, publishedConsensusInput) {
+  auto settings = getSettings();
+  settings.maxNumConsensusIterations_ = 1;
+  settings.consensusPenalty_ = 0.001;
+  auto solverPtr = createSolver(settings);
+  solverPtr->run(0.0, initState, 1.0);
+  EXPECT_FALSE(solverPtr->isConsensusConverged());
+
+  // the weak penalty does not pull the first input of the nominal scenario to the consensus input
+  const auto nominalSolution = solverPtr->getScenarioSolver(0).primalSolution(1.0);
+  EXPECT_GT(std::abs(nominalSolution.inputTrajectory_.front()(0) - averageInputTarget), 1.0);
+
+  // the published solution and its controller still apply the consensus input at the initial time
+  const auto primalSolution = solverPtr->primalSolution(1.0);
+  EXPECT_NEAR(primalSolution.inputTrajectory_.front()(0), averageInputTarget, 1e-9);
+  EXPECT_NEAR(primalSolution.controllerPtr_->computeInput(0.0, initState)(0), averageInputTarget, 1e-9);
+  EXPECT_DOUBLE_EQ(primalSolution.inputTrajectory_.back()(0), nominalSolution.inputTrajectory_.back()(0));
+}
+
+TEST_F(ScenarioSolverTest, threadBudget) {
+  auto settings = getSettings();
+
+  // a single thread for each scenario solver if there are at least as many scenarios as threads
+  settings.nThreads_ = 2;
+  createSolver(settings);
+  EXPECT_EQ(numThreadsPerScenario, std::vector<size_t>(numScenarios, 1));
+
+  // the rest of the budget is split between the scenario solvers
+  numThreadsPerScenario.clear();
+  settings.nThreads_ = 7;
+  createSolver(settings);
+  EXPECT_EQ(numThreadsPerScenario, std::vector<size_t>(numScenarios, 2));
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <fstream>
+#include <iostream>
+
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_mpc/MpcReplay.h>
+#include <ocs2_sqp/MultipleShootingMpc.h>
+
+#include "ocs2_ballbot/BallbotInterface.h"
+#include "ocs2_ballbot/package_path.h"
+
+/**
+ * Records and replays MPC logs of the ballbot. The recording runs a closed loop, in which the state is propagated by the optimized state
+ * trajectory. The replay runs the logged MPC cycles as fast as possible with the DDP or the SQP solver and prints the per-cycle statistics.
+ *
+ * Usage:
+ *   ballbot_mpc_replay record <log file> [duration]
+ *   ballbot_mpc_replay replay <log file> [ddp|sqp] [csv file]
+ */
+
+using namespace ocs2;
+using namespace ballbot;
+
+namespace {
+
+const std::string TASK_FILE = ballbot::getPath() + "/config/mpc/task.info";
+const std::string LIB_FOLDER = ballbot::getPath() + "/auto_generated";
+
+std::unique_ptr<MPC_BASE> getMpc(BallbotInterface& interface, const std::string& solverName) {
+  auto mpcSettings = interface.mpcSettings();
+  mpcSettings.debugPrint_ = false;
+
+  std::unique_ptr<MPC_BASE> mpcPtr;
+  if (solverName == "ddp") {
+    mpcPtr.reset(new GaussNewtonDDP_MPC(mpcSettings, interface.ddpSettings(), interface.getRollout(), interface.getOptimalControlProblem(),
+                                        interface.getInitializer()));
+  } else if (solverName == "sqp") {
+    auto sqpSettings = interface.sqpSettings();
+    sqpSettings.printSolverStatus = false;
+    sqpSettings.printSolverStatistics = false;
+    sqpSettings.printLinesearch = false;
+    mpcPtr.reset(new MultipleShootingMpc(mpcSettings, sqpSettings, interface.getOptimalControlProblem(), interface.getInitializer()));
+  } else {
+    throw std::runtime_error("[BallbotMpcReplay] Unknown solver " + solverName + "!");
+  }
+  mpcPtr->getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  return mpcPtr;
+}
+
+void record(const std::string& logFileName, scalar_t duration) {
+  BallbotInterface interface(TASK_FILE, LIB_FOLDER);
+  auto mpcPtr = getMpc(interface, "ddp");
+  MPC_MRT_Interface mpcMrtInterface(*mpcPtr);
+  // the MPC runs once per MPC period, or at 100 Hz if the MPC runs as fast as possible
+  const scalar_t mpcFrequency = interface.mpcSettings().mpcDesiredFrequency_ > 0.0 ? interface.mpcSettings().mpcDesiredFrequency_ : 100.0;
+  const scalar_t dt = 1.0 / mpcFrequency;
+
+  SystemObservation observation;
+  observation.time = 0.0;
+  observation.state = interface.getInitialState();
+  observation.input = vector_t::Zero(INPUT_DIM);
+
+  // move to a new position in the middle of the recording
+  vector_t targetState = interface.getInitialState();
+  const TargetTrajectories initTargetTrajectories({0.0}, {targetState}, {observation.input});
+  targetState.head<2>() << 1.0, 0.5;
+  const TargetTrajectories targetTrajectories({0.5 * duration}, {targetState}, {observation.input});
+
+  mpc_replay::LogWriter logWriter(logFileName);
+  mpcMrtInterface.resetMpcNode(initTargetTrajectories);
+  logWriter.writeTargetTrajectories(initTargetTrajectories);
+  bool targetSent = false;
+  while (observation.time < duration) {
+    if (!targetSent && observation.time >= 0.5 * duration) {
+      mpcMrtInterface.getReferenceManager().setTargetTrajectories(targetTrajectories);
+      logWriter.writeTargetTrajectories(targetTrajectories);
+      targetSent = true;
+    }
+    mpcMrtInterface.setCurrentObservation(observation);
+    logWriter.writeObservation(observation);
+    mpcMrtInterface.advanceMpc();
+
+    observation.time += dt;
+    mpcMrtInterface.updatePolicy();
+    mpcMrtInterface.evaluatePolicy(observation.time, observation.state, observation.state, observation.input, observation.mode);
+  }
+  logWriter.flush();
+}
+
+void replay(const std::string& logFileName, const std::string& solverName, const std::string& csvFileName) {
+  BallbotInterface interface(TASK_FILE, LIB_FOLDER);
+  auto mpcPtr = getMpc(interface, solverName);
+
+  const auto cycles = mpc_replay::loadLog(logFileName);
+  const auto statistics = mpc_replay::replay(*mpcPtr, cycles);
+
+  if (csvFileName.empty()) {
+    mpc_replay::writeStatistics(statistics, std::cout);
+  } else {
+    std::ofstream csvFile(csvFileName);
+    mpc_replay::writeStatistics(statistics, csvFile);
+  }
+  mpc_replay::printSummary(statistics, std::cerr);
+}
+
+}  // unnamed namespace
+
+int main(int argc, char** argv) {
+  const std::string mode = argc > 1 ? argv[1] : "";
+  if (argc < 3 || (mode != "record" && mode != "replay")) {
+    std::cerr << "Usage:\n";
+    std::cerr << "  " << argv[0] << " record <log file> [duration]\n";
+    std::cerr << "  " << argv[0] << " replay <log file> [ddp|sqp] [csv file]\n";
+    return 1;
+  }
+
+  if (mode == "record") {
+    record(argv[2], argc > 3 ? std::stod(argv[3]) : 10.0);
+  } else {
+    replay(argv[2], argc > 3 ? argv[3] : "ddp", argc > 4 ? argv[4] : "");
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include <ocs2_core/thread_support/ExecuteAndSleep.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_mpc/LatencyStatistics.h>
+#include <ocs2_mpc/PipelinedMPC_MRT_Interface.h>
+
+#include "ocs2_ballbot/BallbotInterface.h"
+#include "ocs2_ballbot/package_path.h"
+
+/**
+ * Measures the distribution of the policy age, i.e., the time between the observation used to compute the policy and the time at which
+ * the policy is evaluated, for the pipelined MPC of the ballbot with a growing number of MPC instances.
+ */
+
+using namespace ocs2;
+using namespace ballbot;
+
+namespace {
+
+const std::string TASK_FILE = ballbot::getPath() + "/config/mpc/task.info";
+const std::string LIB_FOLDER = ballbot::getPath() + "/auto_generated";
+constexpr scalar_t BENCHMARK_DURATION = 5.0;  // [s]
+constexpr size_t MAX_NUM_INSTANCES = 3;
+
+void runBenchmark(size_t numInstances) {
+  // the interfaces are kept alive as the MPC instances refer to their problems
+  std::vector<std::unique_ptr<BallbotInterface>> interfacePtrs;
+  std::vector<std::unique_ptr<MPC_BASE>> mpcPtrs;
+  for (size_t i = 0; i < numInstances; ++i) {
+    interfacePtrs.emplace_back(new BallbotInterface(TASK_FILE, LIB_FOLDER));
+    auto& interface = *interfacePtrs.back();
+    auto mpcSettings = interface.mpcSettings();
+    mpcSettings.debugPrint_ = false;
+    mpcPtrs.emplace_back(new GaussNewtonDDP_MPC(mpcSettings, interface.ddpSettings(), interface.getRollout(),
+                                                interface.getOptimalControlProblem(), interface.getInitializer()));
+    mpcPtrs.back()->getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  }
+  auto& interface = *interfacePtrs.front();
+  const scalar_t mrtFrequency = interface.mpcSettings().mrtDesiredFrequency_;
+
+  SystemObservation observation;
+  observation.time = 0.0;
+  observation.state = interface.getInitialState();
+  observation.input = vector_t::Zero(INPUT_DIM);
+
+  vector_t targetState = interface.getInitialState();
+  targetState.head<2>() << 1.0, 0.5;
+  const TargetTrajectories targetTrajectories({0.0}, {targetState}, {observation.input});
+
+  PipelinedMPC_MRT_Interface pipeline(std::move(mpcPtrs));
+  pipeline.setCurrentObservation(observation);
+  pipeline.resetMpcNode(targetTrajectories);
+  pipeline.launch();
+  while (!pipeline.initialPolicyReceived()) {
+    pipeline.updatePolicy();
+  }
+
+  // real-time MRT loop: the state is propagated by the optimized state trajectory
+  LatencyStatistics policyAge(static_cast<size_t>(BENCHMARK_DURATION * mrtFrequency) + 1);
+  const scalar_t dt = 1.0 / mrtFrequency;
+  while (observation.time < BENCHMARK_DURATION) {
+    executeAndSleep(
+        [&]() {
+          pipeline.updatePolicy();
+          observation.time += dt;
+          size_t mode;
+          pipeline.evaluatePolicy(observation.time, observation.state, observation.state, observation.input, mode);
+          pipeline.setCurrentObservation(observation);
+          policyAge.addSample(observation.time - pipeline.getCommand().mpcInitObservation_.time);
+        },
+        mrtFrequency);
+  }
+  pipeline.shutdown();
+
+  std::cerr << "\n### Number of MPC instances: " << numInstances << "\n";
+  std::cerr << "###   Solve time [ms]:  median " << 1e3 * pipeline.getSolveTimeStatistics().getMedian() << ", p99 "
+            << 1e3 * pipeline.getSolveTimeStatistics().getP99() << "\n";
+  std::cerr << "###   Policy age [ms]:  median " << 1e3 * policyAge.getMedian() << ", p99 " << 1e3 * policyAge.getP99() << ", max "
+            << 1e3 * policyAge.getMax() << "\n";
+  std::cerr << "###   Discarded solutions: " << pipeline.getNumDiscardedSolutions() << "\n";
+}
+
+}  // unnamed namespace
+
+int main(int argc, char** argv) {
+  for (size_t numInstances = 1; numInstances <= MAX_NUM_INSTANCES; ++numInstances) {
+    runBenchmark(numInstances);
+  }
+  return 0;
+}
@@ -28,15 +28,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
 #include <cmath>
+#include <cstdio>
 
 #include <gtest/gtest.h>
 
 #include <ocs2_double_integrator/DoubleIntegratorInterface.h>
 #include <ocs2_double_integrator/package_path.h>
 
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/thread_support/ExecuteAndSleep.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_mpc/MpcReplay.h>
+#include <ocs2_mpc/PipelinedMPC_MRT_Interface.h>
+#include <ocs2_mpc/ScenarioMpc.h>
 
 using namespace ocs2;
 using namespace double_integrator;
@@ -57,10 +62,11 @@ class DoubleIntegratorIntegrationTest : public testing::Test {
     doubleIntegratorInterfacePtr->getReferenceManagerPtr()->setTargetTrajectories(std::move(targetTrajectories));
   }
 
-  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(bool warmStart) {
+  std::unique_ptr<GaussNewtonDDP_MPC> getMpc(bool warmStart, bool compensateDelay = false) {
     auto& interface = *doubleIntegratorInterfacePtr;
     auto mpcSettings = interface.mpcSettings();
     auto ddpSettings = interface.ddpSettings();
+    mpcSettings.compensateDelay_ = compensateDelay;
     if (!warmStart) {
       mpcSettings.coldStart_ = true;
       ddpSettings.maxNumIterations_ = 5;
@@ -153,6 +159,143 @@ TEST_F(DoubleIntegratorIntegrationTest, coldStartMPC) {
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
 
+TEST_F(DoubleIntegratorIntegrationTest, delayCompensation) {
+  auto mpcPtr = getMpc(true, true);
+  MPC_MRT_Interface mpcInterface(*mpcPtr);
+  mpcInterface.initDelayCompensation(*doubleIntegratorInterfacePtr->getOptimalControlProblem().dynamicsPtr,
+                                     doubleIntegratorInterfacePtr->getRollout().settings().timeStep);
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+
+  // run MPC for N iterations
+  auto time = initTime;
+  while (time < finalTime) {
+    // run MPC
+    const auto expectedDelay = mpcInterface.getLatencyStatistics().getPercentile(mpcPtr->settings().delayPercentile_);
+    mpcInterface.advanceMpc();
+    time += 1.0 / f_mpc;
+
+    // the MPC optimizes from the observation predicted after the expected delay
+    mpcInterface.updatePolicy();
+    const auto& mpcInitObservation = mpcInterface.getCommand().mpcInitObservation_;
+    ASSERT_GE(mpcInitObservation.time, observation.time);
+    ASSERT_NEAR(mpcInitObservation.time, observation.time + expectedDelay, 1e-9);
+
+    size_t mode;
+    vector_t optimalState, optimalInput;
+    mpcInterface.evaluatePolicy(time, vector_t::Zero(STATE_DIM), optimalState, optimalInput, mode);
+
+    // use optimal state for the next observation:
+    observation.time = time;
+    observation.state = optimalState;
+    observation.input.setZero(INPUT_DIM);
+    mpcInterface.setCurrentObservation(observation);
+  }
+
+  EXPECT_GT(mpcInterface.getLatencyStatistics().getNumSamples(), 0);
+  EXPECT_LE(mpcInterface.getLatencyStatistics().getMedian(), mpcInterface.getLatencyStatistics().getP99());
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+}
+
+TEST_F(DoubleIntegratorIntegrationTest, replay) {
+  const std::string logFileName = "/tmp/ocs2_double_integrator_replay.log";
+  const TargetTrajectories targetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)});
+
+  // record a closed loop
+  std::vector<scalar_t> recordedCosts;
+  {
+    auto mpcPtr = getMpc(true);
+    MPC_MRT_Interface mpcInterface(*mpcPtr);
+    mpcInterface.resetMpcNode(targetTrajectories);
+    mpc_replay::LogWriter logWriter(logFileName);
+    logWriter.writeTargetTrajectories(targetTrajectories);
+
+    SystemObservation observation;
+    observation.time = initTime;
+    observation.state = initState;
+    observation.input.setZero(INPUT_DIM);
+    while (observation.time < finalTime) {
+      logWriter.writeObservation(observation);
+      mpcInterface.setCurrentObservation(observation);
+      mpcInterface.advanceMpc();
+      recordedCosts.push_back(mpcPtr->getSolverPtr()->getPerformanceIndeces().cost);
+
+      observation.time += 1.0 / f_mpc;
+      mpcInterface.updatePolicy();
+      mpcInterface.evaluatePolicy(observation.time, vector_t::Zero(STATE_DIM), observation.state, observation.input, observation.mode);
+    }
+    logWriter.flush();
+  }
+
+  // replay the log with a fresh MPC
+  const auto cycles = mpc_replay::loadLog(logFileName);
+  std::remove(logFileName.c_str());
+  ASSERT_EQ(cycles.size(), recordedCosts.size());
+
+  auto mpcPtr = getMpc(true);
+  const auto statistics = mpc_replay::replay(*mpcPtr, cycles);
+  ASSERT_EQ(statistics.size(), cycles.size());
+  for (size_t i = 0; i < statistics.size(); i++) {
+    EXPECT_DOUBLE_EQ(statistics[i].time, cycles[i].observation.time);
+    EXPECT_GT(statistics[i].latency, 0.0);
+    EXPECT_GT(statistics[i].numIterations, 0);
+    EXPECT_NEAR(statistics[i].cost, recordedCosts[i], 1e-9 * (1.0 + std::abs(recordedCosts[i])));
+  }
+}
+
+TEST_F(DoubleIntegratorIntegrationTest, scenarioTracking) {
+  auto& interface = *doubleIntegratorInterfacePtr;
+  scenario::Settings scenarioSettings;
+  scenarioSettings.numScenarios_ = 3;
+  scenarioSettings.nThreads_ = 3;
+  scenarioSettings.maxNumConsensusIterations_ = 10;
+
+  // the input gain of the scenarios is off by up to 20%
+  const auto perturbation = [](size_t scenarioIndex, OptimalControlProblem& problem) {
+    const std::vector<scalar_t> inputGains{1.0, 0.8, 1.2};
+    const matrix_t A = (matrix_t(STATE_DIM, STATE_DIM) << 0.0, 1.0, 0.0, 0.0).finished();
+    const matrix_t B = (matrix_t(STATE_DIM, INPUT_DIM) << 0.0, inputGains[scenarioIndex]).finished();
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(A, B));
+  };
+  const auto solverFactory = [&](const OptimalControlProblem& problem, size_t numThreads) {
+    auto ddpSettings = interface.ddpSettings();
+    ddpSettings.nThreads_ = numThreads;
+    const TimeTriggeredRollout rollout(*problem.dynamicsPtr, interface.getRollout().settings());
+    return std::unique_ptr<SolverBase>(new SLQ(ddpSettings, rollout, problem, interface.getInitializer()));
+  };
+
+  ScenarioMpc mpc(interface.mpcSettings(), scenarioSettings, interface.getOptimalControlProblem(), perturbation, solverFactory);
+  mpc.getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  MPC_MRT_Interface mpcInterface(mpc);
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  while (observation.time < finalTime) {
+    mpcInterface.setCurrentObservation(observation);
+    mpcInterface.advanceMpc();
+
+    const auto& solver = *mpc.getSolverPtr();
+    EXPECT_GE(solver.getNumConsensusIterations(), 1);
+    EXPECT_LE(solver.getNumConsensusIterations(), scenarioSettings.maxNumConsensusIterations_);
+    EXPECT_TRUE(mpc.isConsensusConverged());
+    EXPECT_LE(solver.getConsensusResidual(), scenarioSettings.consensusTolerance_);
+    ASSERT_EQ(solver.getConsensusInput().size(), INPUT_DIM);
+
+    observation.time += 1.0 / f_mpc;
+    mpcInterface.updatePolicy();
+    mpcInterface.evaluatePolicy(observation.time, vector_t::Zero(STATE_DIM), observation.state, observation.input, observation.mode);
+  }
+
+  EXPECT_EQ(mpc.getNumUnconvergedRuns(), 0);
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+}
+
 #ifdef NDEBUG
 TEST_F(DoubleIntegratorIntegrationTest, asynchronousTracking) {
   auto mpcPtr = getMpc(true);
@@ -208,4 +351,108 @@ TEST_F(DoubleIntegratorIntegrationTest, asynchronousTracking) {
 
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
+
+TEST_F(DoubleIntegratorIntegrationTest, pipelinedTracking) {
+  constexpr size_t numInstances = 3;
+  const scalar_t f_mrt = 100;
+
+  // each MPC instance has its own reference manager as they run concurrently
+  std::vector<std::unique_ptr<MPC_BASE>> mpcPtrs;
+  for (size_t i = 0; i < numInstances; i++) {
+    auto mpcPtr = getMpc(true);
+    mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<ReferenceManager>());
+    mpcPtrs.push_back(std::move(mpcPtr));
+  }
+  PipelinedMPC_MRT_Interface mpcInterface(std::move(mpcPtrs));
+  mpcInterface.resetMpcNode(TargetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)}));
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+  mpcInterface.launch();
+
+  // Wait for the first policy
+  while (!mpcInterface.initialPolicyReceived()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // run MRT
+  while (observation.time < finalTime) {
+    ocs2::executeAndSleep(
+        [&]() {
+          observation.time += 1.0 / f_mrt;
+
+          // Evaluate the policy
+          mpcInterface.updatePolicy();
+          mpcInterface.evaluatePolicy(observation.time, vector_t::Zero(STATE_DIM), observation.state, observation.input, observation.mode);
+
+          // use optimal state for the next observation:
+          mpcInterface.setCurrentObservation(observation);
+        },
+        f_mrt);
+  }
+  mpcInterface.shutdown();
+
+  EXPECT_GT(mpcInterface.getLatencyStatistics().getNumSamples(), 1);
+  EXPECT_GT(mpcInterface.getSolveTimeStatistics().getNumSamples(), 1);
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+}
+
+TEST_F(DoubleIntegratorIntegrationTest, pipelinedException) {
+  // a reference manager which fails the solves after the given time
+  class FailingReferenceManager final : public ReferenceManager {
+   public:
+    explicit FailingReferenceManager(scalar_t failureTime) : failureTime_(failureTime) {}
+
+   private:
+    void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
+                          ModeSchedule& modeSchedule) override {
+      if (initTime > failureTime_) {
+        throw std::runtime_error("Failing reference manager");
+      }
+    }
+    const scalar_t failureTime_;
+  };
+
+  std::vector<std::unique_ptr<MPC_BASE>> mpcPtrs;
+  for (size_t i = 0; i < 2; i++) {
+    auto mpcPtr = getMpc(true);
+    mpcPtr->getSolverPtr()->setReferenceManager(std::make_shared<FailingReferenceManager>(initTime + 1.0));
+    mpcPtrs.push_back(std::move(mpcPtr));
+  }
+  PipelinedMPC_MRT_Interface mpcInterface(std::move(mpcPtrs));
+  mpcInterface.resetMpcNode(TargetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)}));
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+  mpcInterface.setCurrentObservation(observation);
+  mpcInterface.launch();
+  while (!mpcInterface.initialPolicyReceived()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_NO_THROW(mpcInterface.updatePolicy());
+
+  // the exception of the failed solve reaches the thread of the MRT
+  observation.time = initTime + 2.0;
+  mpcInterface.setCurrentObservation(observation);
+  bool isRethrown = false;
+  for (size_t i = 0; i < 5000 && !isRethrown; i++) {
+    try {
+      mpcInterface.updatePolicy();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } catch (const std::runtime_error& e) {
+      EXPECT_STREQ(e.what(), "Failing reference manager");
+      isRethrown = true;
+    }
+  }
+  EXPECT_TRUE(isRethrown);
+
+  // the exception is rethrown once
+  EXPECT_NO_THROW(mpcInterface.updatePolicy());
+  mpcInterface.shutdown();
+}
 #endif
@@ -56,9 +56,11 @@ class WheelBasedMobileManipulatorDynamics final : public SystemDynamicsBaseAD {
    * @param [in] modelFolder : folder to save the model library files to
    * @param [in] recompileLibraries : If true, always compile the model library, else try to load existing library if available.
    * @param [in] verbose : Display information.
+   * @param [in] generateFlowMapHessian : If true, the second-order derivatives of the flow map are generated (required by DDP).
    */
   WheelBasedMobileManipulatorDynamics(ManipulatorModelInfo modelInfo, const std::string& modelName,
-                                      const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
+                                      const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true,
+                                      bool generateFlowMapHessian = false);
 
   ~WheelBasedMobileManipulatorDynamics() override = default;
   WheelBasedMobileManipulatorDynamics* clone() const override { return new WheelBasedMobileManipulatorDynamics(*this); }
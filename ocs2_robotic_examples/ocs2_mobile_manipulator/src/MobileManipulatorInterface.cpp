@@ -179,26 +179,27 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
                                                     libraryFolder, recompileLibraries));
   }
 
-  // Dynamics
+  // Dynamics: the second-order DDP requires the Hessian of the flow map
+  const bool generateFlowMapHessian = ddpSettings_.algorithm_ == ddp::Algorithm::DDP;
   switch (manipulatorModelInfo_.manipulatorModelType) {
     case ManipulatorModelType::DefaultManipulator: {
-      problem_.dynamicsPtr.reset(
-          new DefaultManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new DefaultManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true,
+                                                                generateFlowMapHessian));
       break;
     }
     case ManipulatorModelType::FloatingArmManipulator: {
-      problem_.dynamicsPtr.reset(
-          new FloatingArmManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new FloatingArmManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries,
+                                                                    true, generateFlowMapHessian));
       break;
     }
     case ManipulatorModelType::FullyActuatedFloatingArmManipulator: {
-      problem_.dynamicsPtr.reset(
-          new FullyActuatedFloatingArmManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new FullyActuatedFloatingArmManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder,
+                                                                                 recompileLibraries, true, generateFlowMapHessian));
       break;
     }
     case ManipulatorModelType::WheelBasedMobileManipulator: {
-      problem_.dynamicsPtr.reset(
-          new WheelBasedMobileManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder, recompileLibraries, true));
+      problem_.dynamicsPtr.reset(new WheelBasedMobileManipulatorDynamics(manipulatorModelInfo_, "dynamics", libraryFolder,
+                                                                         recompileLibraries, true, generateFlowMapHessian));
       break;
     }
     default:
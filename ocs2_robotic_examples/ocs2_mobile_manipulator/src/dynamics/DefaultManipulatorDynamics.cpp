@@ -37,8 +37,8 @@ namespace mobile_manipulator {
 /******************************************************************************************************/
 DefaultManipulatorDynamics::DefaultManipulatorDynamics(const ManipulatorModelInfo& info, const std::string& modelName,
                                                        const std::string& modelFolder, bool recompileLibraries /*= true*/,
-                                                       bool verbose /*= true*/) {
-  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose);
+                                                       bool verbose /*= true*/, bool generateFlowMapHessian /*= false*/) {
+  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose, generateFlowMapHessian);
 }
 
 /******************************************************************************************************/
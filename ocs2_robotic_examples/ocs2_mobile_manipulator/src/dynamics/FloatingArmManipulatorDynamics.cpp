@@ -37,8 +37,9 @@ namespace mobile_manipulator {
 /******************************************************************************************************/
 FloatingArmManipulatorDynamics::FloatingArmManipulatorDynamics(const ManipulatorModelInfo& info, const std::string& modelName,
                                                                const std::string& modelFolder /*= "/tmp/ocs2"*/,
-                                                               bool recompileLibraries /*= true*/, bool verbose /*= true*/) {
-  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose);
+                                                               bool recompileLibraries /*= true*/, bool verbose /*= true*/,
+                                                               bool generateFlowMapHessian /*= false*/) {
+  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose, generateFlowMapHessian);
 }
 
 /******************************************************************************************************/
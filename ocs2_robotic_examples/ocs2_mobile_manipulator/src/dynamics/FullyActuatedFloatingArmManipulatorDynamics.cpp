@@ -39,8 +39,9 @@ FullyActuatedFloatingArmManipulatorDynamics::FullyActuatedFloatingArmManipulator
                                                                                          const std::string& modelName,
                                                                                          const std::string& modelFolder /*= "/tmp/ocs2"*/,
                                                                                          bool recompileLibraries /*= true*/,
-                                                                                         bool verbose /*= true*/) {
-  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose);
+                                                                                         bool verbose /*= true*/,
+                                                                                         bool generateFlowMapHessian /*= false*/) {
+  this->initialize(info.stateDim, info.inputDim, modelName, modelFolder, recompileLibraries, verbose, generateFlowMapHessian);
 }
 
 /******************************************************************************************************/
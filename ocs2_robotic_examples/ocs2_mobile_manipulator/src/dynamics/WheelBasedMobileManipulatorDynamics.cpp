@@ -37,9 +37,10 @@ namespace mobile_manipulator {
 /******************************************************************************************************/
 WheelBasedMobileManipulatorDynamics::WheelBasedMobileManipulatorDynamics(ManipulatorModelInfo info, const std::string& modelName,
                                                                          const std::string& modelFolder /*= "/tmp/ocs2"*/,
-                                                                         bool recompileLibraries /*= true*/, bool verbose /*= true*/)
+                                                                         bool recompileLibraries /*= true*/, bool verbose /*= true*/,
+                                                                         bool generateFlowMapHessian /*= false*/)
     : info_(std::move(info)) {
-  this->initialize(info_.stateDim, info_.inputDim, modelName, modelFolder, recompileLibraries, verbose);
+  this->initialize(info_.stateDim, info_.inputDim, modelName, modelFolder, recompileLibraries, verbose, generateFlowMapHessian);
 }
 
 /******************************************************************************************************/
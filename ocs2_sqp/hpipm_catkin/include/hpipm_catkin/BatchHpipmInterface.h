@@ -0,0 +1,94 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "hpipm_catkin/HpipmInterface.h"
+
+namespace ocs2 {
+
+/**
+ * Solves a batch of K discrete linear quadratic optimal control problems of identical size in parallel, for example for scenario trees or
+ * multi-start initial guesses. Each problem has its own HPIPM workspace, the problem dimensions are shared between them.
+ */
+class BatchHpipmInterface {
+ public:
+  using OcpSize = hpipm_interface::OcpSize;
+  using Settings = hpipm_interface::Settings;
+
+  /**
+   * Constructor
+   *
+   * @param batchSize : Number of problems K in the batch.
+   * @param ocpSize : Size shared by all problems in the batch.
+   * @param settings : HPIPM settings used for all problems in the batch.
+   * @param nThreads : Number of threads used to solve the batch, including the calling thread.
+   * @param threadPriority : Priority of the worker threads.
+   */
+  BatchHpipmInterface(size_t batchSize, OcpSize ocpSize = OcpSize(), const Settings& settings = Settings(), size_t nThreads = 1,
+                      int threadPriority = 0);
+
+  /** Resize all problems in the batch */
+  void resize(OcpSize ocpSize);
+
+  /** Number of problems in the batch */
+  size_t size() const { return interfaces_.size(); }
+
+  /**
+   * Solves all problems in the batch. The arguments are the same as for HpipmInterface::solve, with one entry per problem.
+   *
+   * @param x0 : Initial state (deviation) of each problem.
+   * @param dynamics : Linearized approximation of the discrete dynamics of each problem.
+   * @param cost : Quadratic approximation of the cost of each problem.
+   * @param constraints : Linearized approximation of constraints of each problem, nullptr to solve all problems without constraints.
+   * @param [out] stateTrajectories : Solution state (deviation) trajectory of each problem. Storage of matching size is reused.
+   * @param [out] inputTrajectories : Solution input (deviation) trajectory of each problem. Storage of matching size is reused.
+   * @return HPIPM status of each problem.
+   */
+  std::vector<hpipm_status> solve(const vector_array_t& x0, std::vector<std::vector<VectorFunctionLinearApproximation>>& dynamics,
+                                  std::vector<std::vector<ScalarFunctionQuadraticApproximation>>& cost,
+                                  std::vector<std::vector<VectorFunctionLinearApproximation>>* constraints,
+                                  std::vector<vector_array_t>& stateTrajectories, std::vector<vector_array_t>& inputTrajectories);
+
+  /** Access to the interface of problem k, e.g. to retrieve the multipliers or Riccati terms of the last solution */
+  HpipmInterface& operator[](size_t k) { return *interfaces_[k]; }
+  const HpipmInterface& operator[](size_t k) const { return *interfaces_[k]; }
+
+ private:
+  std::vector<std::unique_ptr<HpipmInterface>> interfaces_;
+  size_t nThreads_;
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
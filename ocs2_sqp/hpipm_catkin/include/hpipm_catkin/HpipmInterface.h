@@ -41,15 +41,34 @@ extern "C" {
 #include "hpipm_catkin/OcpSize.h"
 
 namespace ocs2 {
+namespace hpipm_interface {
+
+/**
+ * Multipliers of a QP solved by HPIPM. The constraints C*dx + D*du + e = 0 are passed to HPIPM as two-sided inequalities, each side has
+ * a separate multiplier and slack. The slacks are needed next to the multipliers to warm start the interior point iterations.
+ */
+struct Multipliers {
+  vector_array_t costate;          // Multipliers of the dynamics x[k+1] = A[k]*x[k] + B[k]*u[k] + b[k], size N
+  vector_array_t lowerConstraint;  // Multipliers of the lower bound of the constraints, size N+1 (empty when solved without constraints)
+  vector_array_t upperConstraint;  // Multipliers of the upper bound of the constraints, size N+1 (empty when solved without constraints)
+  vector_array_t lowerSlack;       // Slacks of the lower bound of the constraints, size N+1 (empty when solved without constraints)
+  vector_array_t upperSlack;       // Slacks of the upper bound of the constraints, size N+1 (empty when solved without constraints)
+};
+
+}  // namespace hpipm_interface
 
 /**
  * This class implements the interface between Linear Quadratic optimal control problems defined in OCS2 and the HPIPM solver.
  * If the problem dimensions change, resize needs to be called to re-initialize HPIPM.
+ *
+ * All memory needed by HPIPM is allocated in resize. Repeatedly solving problems of the same size does not allocate memory when the
+ * output arguments are reused between the calls.
  */
 class HpipmInterface {
  public:
   using OcpSize = hpipm_interface::OcpSize;
   using Settings = hpipm_interface::Settings;
+  using Multipliers = hpipm_interface::Multipliers;
 
   /**
    * Construct the Hpipm interface with given size and settings.
@@ -63,6 +82,12 @@ class HpipmInterface {
   /** Resize the problem */
   void resize(OcpSize ocpSize);
 
+  /**
+   * Resize the problem to the size of another interface. The problem dimensions are not modified by HPIPM after creation and are
+   * shared with the other interface instead of being allocated again.
+   */
+  void shareDimension(const HpipmInterface& other);
+
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
    * this function
@@ -73,8 +98,8 @@ class HpipmInterface {
    * @param dynamics : Linearized approximation of the discrete dynamics.
    * @param cost : Quadratic approximation of the cost.
    * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
-   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
-   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory. Storage of matching size is reused.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory. Storage of matching size is reused.
    * @param verbose : Prints the HPIPM iteration statistics if true.
    * @return HPIPM returned with flag hpipm_status::
    *    SUCCESS = QP solved;
@@ -87,6 +112,29 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Return the multipliers of the previously solved problem.
+   *
+   * @param withConstraints : Also extract the constraint multipliers. Set to true only if the problem was solved with constraints.
+   * @return Multipliers of the dynamics and constraints.
+   */
+  Multipliers getMultipliers(bool withConstraints);
+
+  /** Same as above, but writes into the given multipliers. Storage of matching size is reused. */
+  void getMultipliers(bool withConstraints, Multipliers& multipliers);
+
+  /**
+   * Provides multipliers to warm start the next call to solve. The primal variables are initialized at zero.
+   * Stages for which the provided multipliers do not match the problem size, for example at the tail of a shifted horizon, keep their
+   * default initialization. The warm start is only used for the next call to solve.
+   *
+   * @param multipliers : Multipliers to warm start with, e.g. obtained with getMultipliers after solving a previous problem.
+   */
+  void setWarmStart(const Multipliers& multipliers);
+
+  /** Return the number of interior point iterations used in the last call to solve */
+  int getNumIterations() const;
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -101,6 +149,10 @@ class HpipmInterface {
   std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                        const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Same as above, but writes into the given cost-to-go's. Storage of matching size is reused. */
+  void getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          std::vector<ScalarFunctionQuadraticApproximation>& riccatiCostToGo);
+
   /**
    * Return the sequence of N feedback matrices for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -111,6 +163,10 @@ class HpipmInterface {
    */
   matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Same as above, but writes into the given feedback matrices. Storage of matching size is reused. */
+  void getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          matrix_array_t& riccatiFeedback);
+
   /**
    * Return the sequence of N feedforward input vectors for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -122,6 +178,10 @@ class HpipmInterface {
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0);
 
+  /** Same as above, but writes into the given feedforward vectors. Storage of matching size is reused. */
+  void getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                             vector_array_t& riccatiFeedforward);
+
  private:
   class Impl;
   std::unique_ptr<Impl> pImpl_;
@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "hpipm_catkin/BatchHpipmInterface.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace ocs2 {
+
+BatchHpipmInterface::BatchHpipmInterface(size_t batchSize, OcpSize ocpSize, const Settings& settings, size_t nThreads,
+                                         int threadPriority)
+    : nThreads_(std::max(nThreads, size_t(1))), threadPool_(nThreads_ - 1, threadPriority) {
+  if (batchSize == 0) {
+    throw std::runtime_error("[BatchHpipmInterface] The batch size must be at least 1.");
+  }
+
+  interfaces_.reserve(batchSize);
+  interfaces_.emplace_back(new HpipmInterface(std::move(ocpSize), settings));
+  for (size_t k = 1; k < batchSize; ++k) {
+    interfaces_.emplace_back(new HpipmInterface(OcpSize(), settings));
+    interfaces_[k]->shareDimension(*interfaces_.front());
+  }
+}
+
+void BatchHpipmInterface::resize(OcpSize ocpSize) {
+  interfaces_.front()->resize(std::move(ocpSize));
+  for (size_t k = 1; k < interfaces_.size(); ++k) {
+    interfaces_[k]->shareDimension(*interfaces_.front());
+  }
+}
+
+std::vector<hpipm_status> BatchHpipmInterface::solve(const vector_array_t& x0,
+                                                     std::vector<std::vector<VectorFunctionLinearApproximation>>& dynamics,
+                                                     std::vector<std::vector<ScalarFunctionQuadraticApproximation>>& cost,
+                                                     std::vector<std::vector<VectorFunctionLinearApproximation>>* constraints,
+                                                     std::vector<vector_array_t>& stateTrajectories,
+                                                     std::vector<vector_array_t>& inputTrajectories) {
+  const size_t batchSize = interfaces_.size();
+  if (x0.size() != batchSize || dynamics.size() != batchSize || cost.size() != batchSize ||
+      (constraints != nullptr && constraints->size() != batchSize)) {
+    throw std::runtime_error("[BatchHpipmInterface] The number of problems does not match the batch size: " + std::to_string(batchSize));
+  }
+  const int K = static_cast<int>(batchSize);
+
+  stateTrajectories.resize(K);
+  inputTrajectories.resize(K);
+  std::vector<hpipm_status> status(K, hpipm_status::NAN_SOL);
+
+  std::atomic_int problemIndex{0};
+  auto parallelTask = [&](int workerId) {
+    int k = problemIndex++;
+    while (k < K) {
+      auto* constraintsPtr = (constraints != nullptr) ? &(*constraints)[k] : nullptr;
+      status[k] = interfaces_[k]->solve(x0[k], dynamics[k], cost[k], constraintsPtr, stateTrajectories[k], inputTrajectories[k]);
+
+      k = problemIndex++;
+    }
+  };
+  threadPool_.runParallel(std::move(parallelTask), std::min<int>(nThreads_, K));
+
+  return status;
+}
+
+}  // namespace ocs2
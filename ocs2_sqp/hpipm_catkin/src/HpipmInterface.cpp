@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -87,47 +89,97 @@ namespace ocs2 {
 
 class HpipmInterface::Impl {
  public:
+  /** The HPIPM problem dimensions. Only read after creation, and therefore shareable between interfaces of the same size. */
+  struct Dimension {
+    MemoryBlock dimMem;
+    d_ocp_qp_dim dim;
+  };
+
   Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
 
-  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false) {
+  /**
+   * Initializes the memory for the given problem size.
+   *
+   * @param ocpSize : Problem size.
+   * @param forceInitialization : Initialize even if the size did not change.
+   * @param sharedDimension : Dimensions created by another interface for the same problem size. If not provided, the dimensions are
+   * created for this interface.
+   */
+  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false, std::shared_ptr<Dimension> sharedDimension = nullptr) {
     // We will remove the initial state from the decision variables before passing the data to HPIPM.
     // This removes the need for adding constraints to enforce x[0] = x_init
     ocpSize.numStates[0] = 0;
 
     // Skip memory initialization if problem size didn't change.
-    if (!forceInitialization && ocpSize_ == ocpSize) {
+    if (!forceInitialization && ocpSize_ == ocpSize && (sharedDimension == nullptr || sharedDimension == dimension_)) {
       return;
     }
 
     ocpSize_ = std::move(ocpSize);
+    isWarmStarted_ = false;
 
-    const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
-    dimMem_.reserve(dim_size);
-    d_ocp_qp_dim_create(ocpSize_.numStages, &dim_, dimMem_.get());
-    d_ocp_qp_dim_set_all(ocpSize_.numStates.data(), ocpSize_.numInputs.data(), ocpSize_.numStateBoxConstraints.data(),
-                         ocpSize_.numInputBoxConstraints.data(), ocpSize_.numIneqConstraints.data(), ocpSize_.numStateBoxSlack.data(),
-                         ocpSize_.numInputBoxSlack.data(), ocpSize_.numIneqSlack.data(), &dim_);
+    // Pointer tables and data passed to HPIPM, allocated once per problem size
+    const int N = ocpSize_.numStages;
+    AA_.assign(N, nullptr);
+    BB_.assign(N, nullptr);
+    bb_.assign(N, nullptr);
+    QQ_.assign(N + 1, nullptr);
+    RR_.assign(N + 1, nullptr);
+    SS_.assign(N + 1, nullptr);
+    qq_.assign(N + 1, nullptr);
+    rr_.assign(N + 1, nullptr);
+    CC_.assign(N + 1, nullptr);
+    DD_.assign(N + 1, nullptr);
+    llg_.assign(N + 1, nullptr);
+    uug_.assign(N + 1, nullptr);
+    b0_.resize(N > 0 ? ocpSize_.numStates[1] : 0);
+    r0_.resize(ocpSize_.numInputs[0]);
+    boundData_.resize(N + 1);
+    for (int k = 0; k <= N; ++k) {
+      boundData_[k].resize(ocpSize_.numIneqConstraints[k]);
+    }
+    zeros_.setZero(std::max(*std::max_element(ocpSize_.numStates.begin(), ocpSize_.numStates.end()),
+                            *std::max_element(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end())));
 
-    const int qp_size = d_ocp_qp_memsize(&dim_);
+    if (sharedDimension != nullptr) {
+      dimension_ = std::move(sharedDimension);
+    } else {
+      // Never overwrite dimensions that are in use by other interfaces
+      if (dimension_ == nullptr || dimension_.use_count() > 1) {
+        dimension_ = std::make_shared<Dimension>();
+      }
+      const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
+      dimension_->dimMem.reserve(dim_size);
+      d_ocp_qp_dim_create(ocpSize_.numStages, &dimension_->dim, dimension_->dimMem.get());
+      d_ocp_qp_dim_set_all(ocpSize_.numStates.data(), ocpSize_.numInputs.data(), ocpSize_.numStateBoxConstraints.data(),
+                           ocpSize_.numInputBoxConstraints.data(), ocpSize_.numIneqConstraints.data(), ocpSize_.numStateBoxSlack.data(),
+                           ocpSize_.numInputBoxSlack.data(), ocpSize_.numIneqSlack.data(), &dimension_->dim);
+    }
+    auto& dim = dimension_->dim;
+
+    const int qp_size = d_ocp_qp_memsize(&dim);
     qpMem_.reserve(qp_size);
-    d_ocp_qp_create(&dim_, &qp_, qpMem_.get());
+    d_ocp_qp_create(&dim, &qp_, qpMem_.get());
 
-    const int qp_sol_size = d_ocp_qp_sol_memsize(&dim_);
+    const int qp_sol_size = d_ocp_qp_sol_memsize(&dim);
     qpSolMem_.reserve(qp_sol_size);
-    d_ocp_qp_sol_create(&dim_, &qpSol_, qpSolMem_.get());
+    d_ocp_qp_sol_create(&dim, &qpSol_, qpSolMem_.get());
 
-    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim_);
+    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim);
     ipmArgMem_.reserve(ipm_arg_size);
-    d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
+    d_ocp_qp_ipm_arg_create(&dim, &arg_, ipmArgMem_.get());
 
     applySettings(settings_);
 
     // Setup workspace after applying the settings
-    const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
+    const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim, &arg_);
     ipmMem_.reserve(ipm_size);
-    d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+    d_ocp_qp_ipm_ws_create(&dim, &arg_, &workspace_, ipmMem_.get());
   }
 
+  /** Resizes to the size of another interface, sharing its dimensions */
+  void shareDimension(const Impl& other) { initializeMemory(other.ocpSize_, false, other.dimension_); }
+
   void applySettings(Settings& settings) {
     d_ocp_qp_ipm_arg_set_default(settings.hpipmMode, &arg_);
     d_ocp_qp_ipm_arg_set_iter_max(&settings.iter_max, &arg_);
@@ -170,10 +222,6 @@ class HpipmInterface::Impl {
     verifySizes(x0, dynamics, cost, constraints);
 
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
-
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
     // The first dynamics becomes:
@@ -181,85 +229,77 @@ class HpipmInterface::Impl {
     //         = B[0]*u[0] + (b[0] + A[0]*x[0])
     //         = B[0]*u[0] + \tilde{b}[0]
     // numState[0] = 0 --> No need to specify A[0] here
-    vector_t b0 = dynamics[0].f;
-    b0.noalias() += dynamics[0].dfdx * x0;
-    BB[0] = dynamics[0].dfdu.data();
-    bb[0] = b0.data();
+    b0_ = dynamics[0].f;
+    b0_.noalias() += dynamics[0].dfdx * x0;
+    BB_[0] = dynamics[0].dfdu.data();
+    bb_[0] = b0_.data();
 
     // k = 1 -> N-1
     for (int k = 1; k < N; k++) {
-      AA[k] = dynamics[k].dfdx.data();
-      BB[k] = dynamics[k].dfdu.data();
-      bb[k] = dynamics[k].f.data();
+      AA_[k] = dynamics[k].dfdx.data();
+      BB_[k] = dynamics[k].dfdu.data();
+      bb_[k] = dynamics[k].f.data();
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
-
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
-    vector_t r0 = cost[0].dfdu;
-    r0 += cost[0].dfdux * x0;
-    RR[0] = cost[0].dfduu.data();
-    rr[0] = r0.data();
+    r0_ = cost[0].dfdu;
+    r0_.noalias() += cost[0].dfdux * x0;
+    RR_[0] = cost[0].dfduu.data();
+    rr_[0] = r0_.data();
 
     // k = 1 -> (N-1)
     for (int k = 1; k < N; k++) {
-      QQ[k] = cost[k].dfdxx.data();
-      RR[k] = cost[k].dfduu.data();
-      SS[k] = cost[k].dfdux.data();
-      qq[k] = cost[k].dfdx.data();
-      rr[k] = cost[k].dfdu.data();
+      QQ_[k] = cost[k].dfdxx.data();
+      RR_[k] = cost[k].dfduu.data();
+      SS_[k] = cost[k].dfdux.data();
+      qq_[k] = cost[k].dfdx.data();
+      rr_[k] = cost[k].dfdu.data();
     }
 
     // k = N, no inputs
-    QQ[N] = cost[N].dfdxx.data();
-    qq[N] = cost[N].dfdx.data();
+    QQ_[N] = cost[N].dfdxx.data();
+    qq_[N] = cost[N].dfdx.data();
 
     // === Constraints ===
     // for ocs2 --> C*dx + D*du + e = 0
     // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
+    std::fill(CC_.begin(), CC_.end(), nullptr);
+    std::fill(DD_.begin(), DD_.end(), nullptr);
+    std::fill(llg_.begin(), llg_.end(), nullptr);
+    std::fill(uug_.begin(), uug_.end(), nullptr);
 
     if (constraints != nullptr) {
       auto& constr = *constraints;
-      boundData.resize(N + 1);
 
       // k = 0, eliminate initial state
       // numState[0] = 0 --> No need to specify C[0] here
       if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+        boundData_[0] = -constr[0].f;
+        boundData_[0].noalias() -= constr[0].dfdx * x0;
+        llg_[0] = boundData_[0].data();
+        uug_[0] = boundData_[0].data();
+        DD_[0] = constr[0].dfdu.data();
       }
 
       // k = 1 -> (N-1)
       for (int k = 1; k < N; k++) {
         if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+          CC_[k] = constr[k].dfdx.data();
+          DD_[k] = constr[k].dfdu.data();
+          boundData_[k] = -constr[k].f;
+          llg_[k] = boundData_[k].data();
+          uug_[k] = boundData_[k].data();
         }
       }
 
       // k = N, no inputs
       if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+        CC_[N] = constr[N].dfdx.data();
+        boundData_[N] = -constr[N].f;
+        llg_[N] = boundData_[N].data();
+        uug_[N] = boundData_[N].data();
       }
     }
 
@@ -279,10 +319,16 @@ class HpipmInterface::Impl {
     scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    d_ocp_qp_set_all(AA_.data(), BB_.data(), bb_.data(), QQ_.data(), SS_.data(), RR_.data(), qq_.data(), rr_.data(), hidxbx, hlbx, hubx,
+                     hidxbu, hlbu, hubu, CC_.data(), DD_.data(), llg_.data(), uug_.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
 
+    // A warm start only applies to a single solve
+    if (isWarmStarted_) {
+      d_ocp_qp_ipm_arg_set_warm_start(&settings_.warm_start, &arg_);
+      isWarmStarted_ = false;
+    }
+
     if (verbose) {
       printStatus();
     }
@@ -327,131 +373,213 @@ class HpipmInterface::Impl {
     return true;
   }
 
-  matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0) {
+  void getMultipliers(bool withConstraints, Multipliers& multipliers) {
+    const int N = ocpSize_.numStages;
+
+    multipliers.costate.resize(N);
+    for (int k = 0; k < N; ++k) {
+      multipliers.costate[k].resize(ocpSize_.numStates[k + 1]);
+      d_ocp_qp_sol_get_pi(k, &qpSol_, multipliers.costate[k].data());
+    }
+
+    if (withConstraints) {
+      multipliers.lowerConstraint.resize(N + 1);
+      multipliers.upperConstraint.resize(N + 1);
+      multipliers.lowerSlack.resize(N + 1);
+      multipliers.upperSlack.resize(N + 1);
+      for (int k = 0; k <= N; ++k) {
+        multipliers.lowerConstraint[k].resize(ocpSize_.numIneqConstraints[k]);
+        multipliers.upperConstraint[k].resize(ocpSize_.numIneqConstraints[k]);
+        multipliers.lowerSlack[k].resize(ocpSize_.numIneqConstraints[k]);
+        multipliers.upperSlack[k].resize(ocpSize_.numIneqConstraints[k]);
+        if (ocpSize_.numIneqConstraints[k] > 0) {
+          d_ocp_qp_sol_get_lam_lg(k, &qpSol_, multipliers.lowerConstraint[k].data());
+          d_ocp_qp_sol_get_lam_ug(k, &qpSol_, multipliers.upperConstraint[k].data());
+          d_ocp_qp_sol_get_t_lg(k, &qpSol_, multipliers.lowerSlack[k].data());
+          d_ocp_qp_sol_get_t_ug(k, &qpSol_, multipliers.upperSlack[k].data());
+        }
+      }
+    } else {
+      multipliers.lowerConstraint.clear();
+      multipliers.upperConstraint.clear();
+      multipliers.lowerSlack.clear();
+      multipliers.upperSlack.clear();
+    }
+  }
+
+  void setWarmStart(const Multipliers& multipliers) {
+    const int N = ocpSize_.numStages;
+
+    // Primal variables start from zero, the QP is solved in deviation coordinates.
+    for (int k = 0; k <= N; ++k) {
+      d_ocp_qp_sol_set_u(k, zeros_.data(), &qpSol_);
+      d_ocp_qp_sol_set_x(k, zeros_.data(), &qpSol_);
+    }
+
+    // Dual variables for the stages with matching size. HPIPM does not accept const data, but only copies from it.
+    for (int k = 0; k < std::min<int>(N, multipliers.costate.size()); ++k) {
+      const auto& pi = multipliers.costate[k];
+      if (pi.size() == ocpSize_.numStates[k + 1]) {
+        d_ocp_qp_sol_set_pi(k, const_cast<scalar_t*>(pi.data()), &qpSol_);
+      }
+    }
+    for (int k = 0; k < std::min<int>(N + 1, multipliers.lowerConstraint.size()); ++k) {
+      const auto& lam_lg = multipliers.lowerConstraint[k];
+      const auto& lam_ug = multipliers.upperConstraint[k];
+      if (ocpSize_.numIneqConstraints[k] > 0 && lam_lg.size() == ocpSize_.numIneqConstraints[k]) {
+        d_ocp_qp_sol_set_lam_lg(k, const_cast<scalar_t*>(lam_lg.data()), &qpSol_);
+        d_ocp_qp_sol_set_lam_ug(k, const_cast<scalar_t*>(lam_ug.data()), &qpSol_);
+      }
+    }
+    // The complementarity lam * t of the warm start is only meaningful if the slacks are restored together with the multipliers.
+    for (int k = 0; k < std::min<int>(N + 1, multipliers.lowerSlack.size()); ++k) {
+      const auto& t_lg = multipliers.lowerSlack[k];
+      const auto& t_ug = multipliers.upperSlack[k];
+      if (ocpSize_.numIneqConstraints[k] > 0 && t_lg.size() == ocpSize_.numIneqConstraints[k]) {
+        d_ocp_qp_sol_set_t_lg(k, const_cast<scalar_t*>(t_lg.data()), &qpSol_);
+        d_ocp_qp_sol_set_t_ug(k, const_cast<scalar_t*>(t_ug.data()), &qpSol_);
+      }
+    }
+
+    int primalDualWarmStart = 2;
+    d_ocp_qp_ipm_arg_set_warm_start(&primalDualWarmStart, &arg_);
+    isWarmStarted_ = true;
+  }
+
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    return iter;
+  }
+
+  void getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          matrix_array_t& riccatiFeedback) {
     const int N = ocpSize_.numStages;
-    matrix_array_t RiccatiFeedback(N);
+    riccatiFeedback.resize(N);
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    P1_.resize(ocpSize_.numStates[1], ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1_.data());
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());  // Lr matrix is lower triangular
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());  // Lr matrix is lower triangular
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
-    // RiccatiFeedback[0] = - (inv(Lr)^T * inv(Lr)) * (S0 + B0^T * P1 * A0)
-    RiccatiFeedback[0] = -cost0.dfdux;
-    const matrix_t P1_A0 = P1 * dynamics0.dfdx;
-    RiccatiFeedback[0].noalias() -= dynamics0.dfdu.transpose() * P1_A0;
-    Lr.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedback[0]);
-    Lr.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedback[0]);
+    // riccatiFeedback[0] = - (inv(Lr)^T * inv(Lr)) * (S0 + B0^T * P1 * A0)
+    riccatiFeedback[0] = -cost0.dfdux;
+    P1_A0_.noalias() = P1_ * dynamics0.dfdx;
+    riccatiFeedback[0].noalias() -= dynamics0.dfdu.transpose() * P1_A0_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(riccatiFeedback[0]);
+    Lr_.triangularView<Eigen::Lower>().transpose().solveInPlace(riccatiFeedback[0]);
 
     // k > 0
-    matrix_t Ls;
     for (int k = 1; k < N; ++k) {
       const auto numInput = ocpSize_.numInputs[k];
       if (numInput > 0) {
-        // RiccatiFeedback[k] = -(Ls * Lr.inverse()).transpose();
-        Lr.resize(numInput, numInput);
-        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr.data());  // Lr matrix is lower triangular
-        LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
-
-        Ls.resize(ocpSize_.numStates[k], numInput);
-        d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls.data());
-        RiccatiFeedback[k].noalias() = -Lr.triangularView<Eigen::Lower>().transpose().solve(Ls.transpose());
+        // riccatiFeedback[k] = -(Ls * Lr.inverse()).transpose();
+        Lr_.resize(numInput, numInput);
+        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr_.data());  // Lr matrix is lower triangular
+        LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
+
+        Ls_.resize(ocpSize_.numStates[k], numInput);
+        d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls_.data());
+        riccatiFeedback[k] = -Ls_.transpose();
+        Lr_.triangularView<Eigen::Lower>().transpose().solveInPlace(riccatiFeedback[k]);
+      } else {
+        riccatiFeedback[k].resize(0, 0);
       }
     }
-
-    return RiccatiFeedback;
   }
 
-  vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
-                                       const ScalarFunctionQuadraticApproximation& cost0) {
+  void getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                             vector_array_t& riccatiFeedforward) {
     const int N = ocpSize_.numStages;
-    vector_array_t RiccatiFeedforward(N);
+    riccatiFeedforward.resize(N);
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    P1_.resize(ocpSize_.numStates[1], ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1_.data());
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
-    vector_t p1(ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1.data());
+    p1_.resize(ocpSize_.numStates[1]);
+    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1_.data());
 
-    // RiccatiFeedforward[0] = -(inv(Lr)^T * inv(Lr)) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
-    RiccatiFeedforward[0] = -cost0.dfdu;
-    p1.noalias() += P1 * dynamics0.f;  // p1 + P1 * b0
-    RiccatiFeedforward[0].noalias() -= dynamics0.dfdu.transpose() * p1;
-    Lr.triangularView<Eigen::Lower>().solveInPlace(RiccatiFeedforward[0]);
-    Lr.triangularView<Eigen::Lower>().transpose().solveInPlace(RiccatiFeedforward[0]);
+    // riccatiFeedforward[0] = -(inv(Lr)^T * inv(Lr)) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
+    riccatiFeedforward[0] = -cost0.dfdu;
+    p1_.noalias() += P1_ * dynamics0.f;  // p1 + P1 * b0
+    riccatiFeedforward[0].noalias() -= dynamics0.dfdu.transpose() * p1_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(riccatiFeedforward[0]);
+    Lr_.triangularView<Eigen::Lower>().transpose().solveInPlace(riccatiFeedforward[0]);
 
     // k > 0
     for (int k = 1; k < N; ++k) {
-      RiccatiFeedforward[k].resize(ocpSize_.numInputs[k]);
-      d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, RiccatiFeedforward[k].data());
+      riccatiFeedforward[k].resize(ocpSize_.numInputs[k]);
+      d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, riccatiFeedforward[k].data());
     }
-
-    return RiccatiFeedforward;
   }
 
-  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
-                                                                       const ScalarFunctionQuadraticApproximation& cost0) {
+  void getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0,
+                          std::vector<ScalarFunctionQuadraticApproximation>& riccatiCostToGo) {
     /*
      * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
      */
     const int N = ocpSize_.numStages;
-    std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo(N + 1);
+    riccatiCostToGo.resize(N + 1);
 
     // k > 0, this first so we have P[1] ready for P[0].
     for (int k = 1; k <= N; k++) {
-      RiccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
-      RiccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
-      d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdxx.data());
-      d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdx.data());
+      riccatiCostToGo[k].f = 0.0;
+      riccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
+      riccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
+      d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, riccatiCostToGo[k].dfdxx.data());
+      d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, riccatiCostToGo[k].dfdx.data());
     }
 
     // k = 0
-    matrix_t Lr0(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr0.data());
-    LinearAlgebra::setTriangularMinimumEigenvalues(Lr0);
+    Lr_.resize(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
+    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr_.data());
+    LinearAlgebra::setTriangularMinimumEigenvalues(Lr_);
 
     // Shorthand notation
     const matrix_t& A0 = dynamics0.dfdx;
     const matrix_t& B0 = dynamics0.dfdu;
     const vector_t& b0 = dynamics0.f;
     const matrix_t& Q0 = cost0.dfdxx;
-    matrix_t tmp1 = cost0.dfdux;
     const vector_t& q0 = cost0.dfdx;
-    vector_t tmp2 = cost0.dfdu;
-    const matrix_t& P1 = RiccatiCostToGo[1].dfdxx;
-    vector_t tmp3 = RiccatiCostToGo[1].dfdx;
+    const matrix_t& P1 = riccatiCostToGo[1].dfdxx;
+    auto& tmp1 = tmpMatrix_;
+    tmp1 = cost0.dfdux;
+    auto& tmp2 = tmpVector_;
+    tmp2 = cost0.dfdu;
+    auto& tmp3 = p1_;
+    tmp3 = riccatiCostToGo[1].dfdx;
 
     // Matrix terms
-    // RiccatiCostToGo[0].dfdxx = Q0 + A0.transpose() * P1 * A0 -
+    // riccatiCostToGo[0].dfdxx = Q0 + A0.transpose() * P1 * A0 -
     //                              (S0 + B0.transpose() * P1 * A0).transpose() * (R0 + B0.transpose() * P1 * B0).inverse() *
     //                                  (S0 + B0.transpose() * P1 * A0)
     // Use that inv(Lr0)^T * inv(Lr0) = (R0 + B0.transpose() * P1 * B0).inverse();
-    const matrix_t P1_A0 = P1 * A0;
-    tmp1.noalias() += B0.transpose() * P1_A0;
-    Lr0.triangularView<Eigen::Lower>().solveInPlace(tmp1);  // tmp1 = inv(Lr0) * (S0.transpose() + A0.transpose() * P1 * B0)
-    RiccatiCostToGo[0].dfdxx = Q0;
-    RiccatiCostToGo[0].dfdxx.noalias() += A0.transpose() * P1_A0;
-    RiccatiCostToGo[0].dfdxx.noalias() -= tmp1.transpose() * tmp1;
+    P1_A0_.noalias() = P1 * A0;
+    tmp1.noalias() += B0.transpose() * P1_A0_;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(tmp1);  // tmp1 = inv(Lr0) * (S0.transpose() + A0.transpose() * P1 * B0)
+    riccatiCostToGo[0].f = 0.0;
+    riccatiCostToGo[0].dfdxx = Q0;
+    riccatiCostToGo[0].dfdxx.noalias() += A0.transpose() * P1_A0_;
+    riccatiCostToGo[0].dfdxx.noalias() -= tmp1.transpose() * tmp1;
 
     // Vector terms
-    // RiccatiCostToGo[0].dfdx = qk + A0.transpose() * p1 + A0.transpose() * P1 * b0 -
+    // riccatiCostToGo[0].dfdx = qk + A0.transpose() * p1 + A0.transpose() * P1 * b0 -
     //                   (S0.transpose() + A0.transpose() * P1 * B0) * (R0 + B0.transpose() * P1 * B0).inverse() *
     //                       (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
     tmp3.noalias() += P1 * b0;  // tmp3 = p1 + B0.transpose() * P1 * b0
     tmp2.noalias() += B0.transpose() * tmp3;
-    Lr0.triangularView<Eigen::Lower>().solveInPlace(tmp2);  // tmp2 = inv(Lr0) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0)
-    RiccatiCostToGo[0].dfdx = q0;
-    RiccatiCostToGo[0].dfdx.noalias() += A0.transpose() * tmp3;
-    RiccatiCostToGo[0].dfdx.noalias() -= tmp1.transpose() * tmp2;
-    return RiccatiCostToGo;
+    Lr_.triangularView<Eigen::Lower>().solveInPlace(tmp2);  // tmp2 = inv(Lr0) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0)
+    riccatiCostToGo[0].dfdx = q0;
+    riccatiCostToGo[0].dfdx.noalias() += A0.transpose() * tmp3;
+    riccatiCostToGo[0].dfdx.noalias() -= tmp1.transpose() * tmp2;
   }
 
   void printStatus() {
@@ -505,9 +633,29 @@ class HpipmInterface::Impl {
  private:
   Settings settings_;
   OcpSize ocpSize_;
-
-  MemoryBlock dimMem_;
-  d_ocp_qp_dim dim_;
+  bool isWarmStarted_ = false;
+
+  // Pointer tables passed to HPIPM, sized in initializeMemory
+  std::vector<scalar_t*> AA_, BB_, bb_;
+  std::vector<scalar_t*> QQ_, RR_, SS_, qq_, rr_;
+  std::vector<scalar_t*> CC_, DD_, llg_, uug_;
+
+  // Data adapted for the elimination of the initial state and the constraint bounds, HPIPM points into these during solve
+  vector_t b0_;
+  vector_t r0_;
+  vector_array_t boundData_;
+  vector_t zeros_;
+
+  // Workspace for the Riccati getters
+  matrix_t P1_;
+  matrix_t P1_A0_;
+  matrix_t Lr_;
+  matrix_t Ls_;
+  vector_t p1_;
+  matrix_t tmpMatrix_;
+  vector_t tmpVector_;
+
+  std::shared_ptr<Dimension> dimension_;
 
   MemoryBlock qpMem_;
   d_ocp_qp qp_;
@@ -531,6 +679,10 @@ void HpipmInterface::resize(OcpSize ocpSize) {
   pImpl_->initializeMemory(std::move(ocpSize));
 }
 
+void HpipmInterface::shareDimension(const HpipmInterface& other) {
+  pImpl_->shareDimension(*other.pImpl_);
+}
+
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                                    std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                    std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& stateTrajectory,
@@ -538,17 +690,54 @@ hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctio
   return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
 }
 
+hpipm_interface::Multipliers HpipmInterface::getMultipliers(bool withConstraints) {
+  Multipliers multipliers;
+  pImpl_->getMultipliers(withConstraints, multipliers);
+  return multipliers;
+}
+
+void HpipmInterface::getMultipliers(bool withConstraints, Multipliers& multipliers) {
+  pImpl_->getMultipliers(withConstraints, multipliers);
+}
+
+void HpipmInterface::setWarmStart(const Multipliers& multipliers) {
+  pImpl_->setWarmStart(multipliers);
+}
+
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
+}
+
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                                      const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiCostToGo(dynamics0, cost0);
+  std::vector<ScalarFunctionQuadraticApproximation> riccatiCostToGo;
+  pImpl_->getRiccatiCostToGo(dynamics0, cost0, riccatiCostToGo);
+  return riccatiCostToGo;
+}
+void HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
+                                        const ScalarFunctionQuadraticApproximation& cost0,
+                                        std::vector<ScalarFunctionQuadraticApproximation>& riccatiCostToGo) {
+  pImpl_->getRiccatiCostToGo(dynamics0, cost0, riccatiCostToGo);
 }
 matrix_array_t HpipmInterface::getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0,
                                                   const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiFeedback(dynamics0, cost0);
+  matrix_array_t riccatiFeedback;
+  pImpl_->getRiccatiFeedback(dynamics0, cost0, riccatiFeedback);
+  return riccatiFeedback;
+}
+void HpipmInterface::getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0,
+                                        const ScalarFunctionQuadraticApproximation& cost0, matrix_array_t& riccatiFeedback) {
+  pImpl_->getRiccatiFeedback(dynamics0, cost0, riccatiFeedback);
 }
 vector_array_t HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                                      const ScalarFunctionQuadraticApproximation& cost0) {
-  return pImpl_->getRiccatiFeedforward(dynamics0, cost0);
+  vector_array_t riccatiFeedforward;
+  pImpl_->getRiccatiFeedforward(dynamics0, cost0, riccatiFeedforward);
+  return riccatiFeedforward;
+}
+void HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
+                                           const ScalarFunctionQuadraticApproximation& cost0, vector_array_t& riccatiFeedforward) {
+  pImpl_->getRiccatiFeedforward(dynamics0, cost0, riccatiFeedforward);
 }
 
 }  // namespace ocs2
@@ -27,13 +27,34 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <atomic>
+#include <cstdlib>
+
 #include <gtest/gtest.h>
 
+#include "hpipm_catkin/BatchHpipmInterface.h"
 #include "hpipm_catkin/HpipmInterface.h"
 
 #include <ocs2_core/test/testTools.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
+/*
+ * Counts the heap allocations of the test binary. Both Eigen and the default operator new allocate through malloc, therefore it is
+ * interposed here. This relies on glibc which exports the original implementation as __libc_malloc.
+ */
+#ifdef __GLIBC__
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+std::atomic_size_t numMallocCalls{0};
+}  // unnamed namespace
+
+extern "C" void* malloc(size_t size) {
+  ++numMallocCalls;
+  return __libc_malloc(size);
+}
+#endif
+
 TEST(test_hpiphm_interface, solve_and_check_dynamic) {
   int nx = 3;
   int nu = 2;
@@ -205,6 +226,53 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, warmStart) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+
+  // Interface
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+
+  // Cold start
+  std::vector<ocs2::vector_t> xSolCold;
+  std::vector<ocs2::vector_t> uSolCold;
+  auto status = hpipmInterface.solve(x0, system, cost, &constraints, xSolCold, uSolCold, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  const int numIterationsCold = hpipmInterface.getNumIterations();
+  const auto multipliers = hpipmInterface.getMultipliers(true);
+  ASSERT_EQ(multipliers.costate.size(), N);
+  ASSERT_EQ(multipliers.lowerConstraint.size(), N + 1);
+
+  // Warm start from the multipliers of the same problem
+  std::vector<ocs2::vector_t> xSolWarm;
+  std::vector<ocs2::vector_t> uSolWarm;
+  hpipmInterface.setWarmStart(multipliers);
+  status = hpipmInterface.solve(x0, system, cost, &constraints, xSolWarm, uSolWarm, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  ASSERT_LE(hpipmInterface.getNumIterations(), numIterationsCold);
+
+  // Same solution
+  ASSERT_TRUE(ocs2::isEqual(xSolCold, xSolWarm, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSolCold, uSolWarm, 1e-6));
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
@@ -338,3 +406,115 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, reuseOutputStorage) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Interface
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+
+  // First solve sizes the outputs
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  std::vector<ocs2::matrix_t> KSol;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costToGo;
+  auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  hpipmInterface.getRiccatiFeedback(system[0], cost[0], KSol);
+  hpipmInterface.getRiccatiCostToGo(system[0], cost[0], costToGo);
+  const auto xSolFirst = xSol;
+  const auto uSolFirst = uSol;
+
+  const auto collectStorage = [&]() {
+    std::vector<const ocs2::scalar_t*> storage;
+    for (int k = 0; k <= N; k++) {
+      storage.push_back(xSol[k].data());
+      storage.push_back(costToGo[k].dfdxx.data());
+    }
+    for (int k = 0; k < N; k++) {
+      storage.push_back(uSol[k].data());
+      storage.push_back(KSol[k].data());
+    }
+    return storage;
+  };
+  const auto storageFirst = collectStorage();
+
+  // Second solve of the same problem writes into the same storage, without allocating
+#ifdef __GLIBC__
+  const size_t numMallocCallsBefore = numMallocCalls;
+#endif
+  status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, false);
+  hpipmInterface.getRiccatiFeedback(system[0], cost[0], KSol);
+  hpipmInterface.getRiccatiCostToGo(system[0], cost[0], costToGo);
+#ifdef __GLIBC__
+  const size_t numMallocCallsAfter = numMallocCalls;
+  EXPECT_EQ(numMallocCallsAfter - numMallocCallsBefore, 0);
+#endif
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  ASSERT_EQ(storageFirst, collectStorage());
+
+  // Same results as the first solve and as the allocating getters
+  ASSERT_TRUE(ocs2::isEqual(xSolFirst, xSol, 1e-12));
+  ASSERT_TRUE(ocs2::isEqual(uSolFirst, uSol, 1e-12));
+  ASSERT_TRUE(ocs2::isEqual(hpipmInterface.getRiccatiFeedback(system[0], cost[0]), KSol, 1e-12));
+}
+
+TEST(test_hpiphm_interface, batchSolve) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+  int K = 4;
+
+  // Problem setup, K different problems of the same size
+  ocs2::vector_array_t x0;
+  std::vector<std::vector<ocs2::VectorFunctionLinearApproximation>> system(K);
+  std::vector<std::vector<ocs2::ScalarFunctionQuadraticApproximation>> cost(K);
+  for (int i = 0; i < K; i++) {
+    x0.push_back(ocs2::vector_t::Random(nx));
+    for (int k = 0; k < N; k++) {
+      system[i].emplace_back(ocs2::getRandomDynamics(nx, nu));
+      cost[i].emplace_back(ocs2::getRandomCost(nx, nu));
+    }
+    cost[i].emplace_back(ocs2::getRandomCost(nx, 0));
+  }
+
+  // Solve the batch in parallel
+  ocs2::HpipmInterface::OcpSize ocpSize(N, nx, nu);
+  ocs2::BatchHpipmInterface batchInterface(K, ocpSize, ocs2::HpipmInterface::Settings(), 3);
+  std::vector<ocs2::vector_array_t> xSolBatch;
+  std::vector<ocs2::vector_array_t> uSolBatch;
+  const auto status = batchInterface.solve(x0, system, cost, nullptr, xSolBatch, uSolBatch);
+  ASSERT_EQ(status.size(), K);
+
+  // Compare to solving the problems one by one
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  for (int i = 0; i < K; i++) {
+    ASSERT_EQ(status[i], hpipm_status::SUCCESS);
+
+    std::vector<ocs2::vector_t> xSol;
+    std::vector<ocs2::vector_t> uSol;
+    ASSERT_EQ(hpipmInterface.solve(x0[i], system[i], cost[i], nullptr, xSol, uSol), hpipm_status::SUCCESS);
+    ASSERT_TRUE(ocs2::isEqual(xSol, xSolBatch[i], 1e-9));
+    ASSERT_TRUE(ocs2::isEqual(uSol, uSolBatch[i], 1e-9));
+
+    // Riccati terms are available per problem
+    const auto KSol = batchInterface[i].getRiccatiFeedback(system[i][0], cost[i][0]);
+    const auto kSol = batchInterface[i].getRiccatiFeedforward(system[i][0], cost[i][0]);
+    for (int k = 0; k < N; k++) {
+      ASSERT_TRUE(uSolBatch[i][k].isApprox(KSol[k] * xSolBatch[i][k] + kSol[k]));
+    }
+  }
+}
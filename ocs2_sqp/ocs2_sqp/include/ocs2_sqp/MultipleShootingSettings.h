@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <hpipm_catkin/HpipmInterfaceSettings.h>
 
+#include "ocs2_sqp/TimeDiscretization.h"
+
 namespace ocs2 {
 namespace multiple_shooting {
 
@@ -61,8 +63,21 @@ struct Settings {
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;  // user-defined time discretization, the initial step for GEOMETRIC
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  TimeDiscretizationType timeDiscretizationType = TimeDiscretizationType::UNIFORM;
+  scalar_t dtGrowthFactor = 1.0;       // GEOMETRIC: ratio between two consecutive steps
+  scalar_t dtMax = 0.1;                // GEOMETRIC: upper bound on the step
+  scalar_array_t piecewiseHorizons{};  // PIECEWISE: elapsed times at which the step changes
+  scalar_array_t piecewiseDt{};        // PIECEWISE: steps to use, has one more element than piecewiseHorizons
+
+  // Error-adaptive refinement of the time discretization, based on the dynamics defect of each interval
+  size_t maxTimeRefinements = 0;            // Number of refinement passes, 0 disables the refinement
+  scalar_t timeRefinementTolerance = 1e-6;  // Intervals with a discretization error above this value are bisected
+
+  // Warm start from the previous problem, e.g. the previous MPC iteration
+  bool shiftWarmStart = false;       // Reuse the LQ approximation of unchanged nodes and warm start the QP multipliers
+  scalar_t lqReuseTolerance = 1e-3;  // Maximum deviation (inf-norm) from the linearization point for which the LQ of a node is reused
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSettings.h"
 #include "ocs2_sqp/MultipleShootingSolverStatus.h"
+#include "ocs2_sqp/MultipleShootingTranscription.h"
 #include "ocs2_sqp/TimeDiscretization.h"
 
 namespace ocs2 {
@@ -66,16 +67,18 @@ class MultipleShootingSolver : public SolverBase {
 
   void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
 
-  const DualSolution& getDualSolution() const override {
-    throw std::runtime_error("[MultipleShootingSolver] getDualSolution() not available yet.");
-  }
+  const DualSolution& getDualSolution() const override { return dualSolution_; }
 
-  const ProblemMetrics& getSolutionMetrics() const override {
-    throw std::runtime_error("[MultipleShootingSolver] getSolutionMetrics() not available yet.");
-  }
+  const ProblemMetrics& getSolutionMetrics() const override { return problemMetrics_; }
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Number of nodes for which the LQ approximation of the previous iteration was reused, accumulated since the last reset */
+  size_t getNumReusedNodes() const { return totalNumReusedNodes_; }
+
+  /** Convergence status of the last run */
+  multiple_shooting::Convergence getConvergence() const { return convergence_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -84,16 +87,13 @@ class MultipleShootingSolver : public SolverBase {
 
   ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override;
 
-  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override {
-    throw std::runtime_error("[MultipleShootingSolver] getHamiltonian() not available yet.");
-  }
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override;
 
-  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override {
-    throw std::runtime_error("[MultipleShootingSolver] getStateInputEqualityConstraintLagrangian() not available yet.");
-  }
+  /** The multipliers are recovered along the optimized trajectory, the state argument is therefore not used. */
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override;
 
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const override {
-    throw std::runtime_error("[MultipleShootingSolver] getIntermediateDualSolution() not available yet.");
+    return getIntermediateDualSolutionAtTime(dualSolution_, time);
   }
 
  private:
@@ -123,6 +123,13 @@ class MultipleShootingSolver : public SolverBase {
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
+  /** Determines the time discretization with the configured time step policy, and refines it if requested */
+  std::vector<AnnotatedTime> getTimeDiscretization(scalar_t initTime, scalar_t finalTime, const vector_t& initState, vector_array_t& x,
+                                                   vector_array_t& u);
+
+  /** Computes the discretization error of each interval at the current {t, x(t), u(t)} */
+  scalar_array_t computeDiscretizationErrors(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u);
+
   /** Initializes for the state-input trajectories */
   void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
                                         vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
@@ -131,7 +138,7 @@ class MultipleShootingSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
+  /** Computes only the performance metrics at the current {t, x(t), u(t)}. The metrics of each node are stored in stepMetrics_. */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                       const vector_array_t& u);
 
@@ -141,14 +148,32 @@ class MultipleShootingSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  const OcpSubproblemSolution& getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
+
+  /** For each node, returns the index of the node in the previous LQ approximation that can be reused at {t, x(t), u(t)}, or -1 */
+  std::vector<int> getReusableNodes(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& u);
+
+  /**
+   * Re-expresses the reused LQ approximation of node i around the current iterate. The approximation is linearized at the previous
+   * iterate, dx, du, and dxNext are the deviations of x[i], u[i] and x[i+1] from that iterate.
+   */
+  void shiftReusedNode(int i, const vector_t& dx, const vector_t& du, const vector_t& dxNext);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
 
+  /** Computes the multiplier of the state-input equality constraints of node i from the last QP solution */
+  void computeStateInputEqualityConstraintLagrangian(const std::vector<AnnotatedTime>& time, int i, vector_t& nu) const;
+
   /** Set up the primal solution based on the optimized state and input trajectories */
   void setPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
 
+  /**
+   * Set up the dual solution and the problem metrics along the primal solution, timeDiscretization is the grid of the last QP. The
+   * problem metrics are assembled from the node metrics of the accepted iterate, nothing is re-evaluated.
+   */
+  void setDualSolutionAndMetrics(const std::vector<AnnotatedTime>& timeDiscretization);
+
   /** Compute 2-norm of the trajectory: sqrt(sum_i v[i]^2)  */
   static scalar_t trajectoryNorm(const vector_array_t& v);
 
@@ -166,6 +191,7 @@ class MultipleShootingSolver : public SolverBase {
 
   // Problem definition
   Settings settings_;
+  TimeStepPolicy timeStepPolicy_;
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
@@ -176,6 +202,11 @@ class MultipleShootingSolver : public SolverBase {
 
   // Solution
   PrimalSolution primalSolution_;
+  DualSolution dualSolution_;
+  ProblemMetrics problemMetrics_;
+
+  // Multipliers of the state-input equality constraints, on the time grid of the primal solution
+  vector_array_t stateInputEqConstraintLagrangian_;
 
   // Value function in absolute state coordinates (without the constant value)
   std::vector<ScalarFunctionQuadraticApproximation> valueFunction_;
@@ -188,13 +219,42 @@ class MultipleShootingSolver : public SolverBase {
   std::vector<ScalarFunctionQuadraticApproximation> cost_;
   std::vector<VectorFunctionLinearApproximation> constraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
+  std::vector<PerformanceIndex> nodePerformance_;
+
+  // Metrics of each node at the current iterate, and of the last line search candidate. Event nodes hold the pre-jump metrics and the
+  // last node the final metrics. The candidate metrics replace the current ones when the step is accepted.
+  std::vector<MetricsCollection> nodeMetrics_;
+  std::vector<MetricsCollection> stepMetrics_;
+
+  // Operating point of the LQ approximation, used to reuse the approximation of unchanged nodes. The approximation is expressed around
+  // {lqState_, lqInput_}. Reused nodes keep the point at which they were linearized, {lqLinearizationState_, lqLinearizationInput_}.
+  std::vector<AnnotatedTime> lqTime_;
+  vector_array_t lqState_;
+  vector_array_t lqInput_;
+  vector_array_t lqLinearizationState_;
+  vector_array_t lqLinearizationInput_;
+  TargetTrajectories lqTargetTrajectories_;
+  ModeSchedule lqModeSchedule_;
+
+  // Solution of the last QP, the storage is reused between iterations
+  OcpSubproblemSolution subproblemSolution_;
+
+  // Multipliers of the last QP, used to warm start the next QP
+  std::vector<AnnotatedTime> qpMultipliersTime_;
+  HpipmInterface::Multipliers qpMultipliers_;
+  HpipmInterface::Multipliers qpWarmStart_;
 
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
+  multiple_shooting::Convergence convergence_ = multiple_shooting::Convergence::FALSE;
 
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t totalNumQpIterations_{0};
+  size_t totalNumNodes_{0};
+  size_t totalNumReusedNodes_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 
@@ -38,7 +39,19 @@ namespace ocs2 {
 namespace multiple_shooting {
 
 /**
- * Results of the transcription at an intermediate node
+ * Coefficients to recover the continuous-time multipliers of the projected state-input equality constraints from the QP solution:
+ * nu = f + dfdx * dx + dfdu * du + dfdcostate * costate, where costate is the multiplier of the dynamics towards the next node.
+ */
+struct ProjectionMultiplierCoefficients {
+  matrix_t dfdx;
+  matrix_t dfdu;
+  matrix_t dfdcostate;
+  vector_t f;
+};
+
+/**
+ * Results of the transcription at an intermediate node. The metrics hold the undiscretized cost and constraint values at the node, the
+ * multipliers of the Lagrangian terms are not updated by the multiple shooting solver and the metrics use their initial value.
  */
 struct Transcription {
   PerformanceIndex performance;
@@ -46,6 +59,8 @@ struct Transcription {
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
   VectorFunctionLinearApproximation constraintsProjection;
+  ProjectionMultiplierCoefficients projectionMultiplierCoefficients;
+  MetricsCollection metrics;
 };
 
 /**
@@ -65,12 +80,45 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * Computes the coefficients to recover the multipliers of the projected state-input equality constraints. They follow from the
+ * stationarity of the QP Lagrangian w.r.t. the input: r + P * dx + R * du + B^T * costate + D^T * nu_k = 0, where nu_k = dt * nu.
+ *
+ * @param dynamics : Discrete dynamics before the projection.
+ * @param cost : Discrete cost before the projection.
+ * @param constraints : State-input equality constraints C * dx + D * du + e = 0. D is assumed to have full row rank.
+ * @param dt : Duration of the interval
+ * @param coefficients : The multiplier coefficients.
+ */
+void computeProjectionMultiplierCoefficients(const VectorFunctionLinearApproximation& dynamics,
+                                             const ScalarFunctionQuadraticApproximation& cost,
+                                             const VectorFunctionLinearApproximation& constraints, scalar_t dt,
+                                             ProjectionMultiplierCoefficients& coefficients);
+
 /**
  * Compute only the performance index for a single intermediate node.
  * Corresponds to the performance index returned by "setupIntermediateNode"
+ *
+ * @param [out] metricsPtr : Optional, the metrics of the node. Corresponds to the metrics returned by "setupIntermediateNode".
  */
 PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
-                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                                MetricsCollection* metricsPtr = nullptr);
+
+/**
+ * Estimates the discretization error of a single intermediate node. The error is the dynamics defect between one step of dt and two
+ * consecutive steps of dt/2, weighted in the same way as the dynamicsViolationSSE of the performance index.
+ *
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param discretizer : Integrator to use for creating the discrete dynamics.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @return discretization error of this node.
+ */
+scalar_t computeIntermediateDiscretizationError(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
+                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& u);
 
 /**
  * Results of the transcription at a terminal node
@@ -79,6 +127,7 @@ struct TerminalTranscription {
   PerformanceIndex performance;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
+  MetricsCollection metrics;
 };
 
 /**
@@ -94,8 +143,11 @@ TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalCont
 /**
  * Compute only the performance index for the terminal node.
  * Corresponds to the performance index returned by "setTerminalNode"
+ *
+ * @param [out] metricsPtr : Optional, the metrics of the node. Corresponds to the metrics returned by "setTerminalNode".
  */
-PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
+PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                            MetricsCollection* metricsPtr = nullptr);
 
 /**
  * Results of the transcription at an event
@@ -105,6 +157,7 @@ struct EventTranscription {
   VectorFunctionLinearApproximation dynamics;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
+  MetricsCollection metrics;
 };
 
 /**
@@ -122,9 +175,11 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
 /**
  * Compute only the performance index for the event node.
  * Corresponds to the performance index returned by "setupEventNode"
+ *
+ * @param [out] metricsPtr : Optional, the metrics of the node. Corresponds to the metrics returned by "setupEventNode".
  */
 PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
-                                         const vector_t& x_next);
+                                         const vector_t& x_next, MetricsCollection* metricsPtr = nullptr);
 
 }  // namespace multiple_shooting
 }  // namespace ocs2
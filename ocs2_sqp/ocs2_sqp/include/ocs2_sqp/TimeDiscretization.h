@@ -29,11 +29,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+
 #include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/Types.h>
 
 namespace ocs2 {
 
+/** Available policies to select the discretization step along the horizon */
+enum class TimeDiscretizationType { UNIFORM, GEOMETRIC, PIECEWISE };
+
+namespace time_discretization {
+
+/**
+ * Get string name of the time discretization type
+ * @param type: Time discretization type enum
+ */
+std::string toString(TimeDiscretizationType type);
+
+/**
+ * Get time discretization type from string name, useful for reading config file
+ * @param name: Time discretization name
+ */
+TimeDiscretizationType fromString(const std::string& name);
+
+}  // namespace time_discretization
+
 /**
  * Packs together a time, and if an event happens at exactly that time.
  */
@@ -60,6 +81,50 @@ scalar_t getIntervalEnd(const AnnotatedTime& end);
 /** Computes the interval duration that respects interpolation rules around event times */
 scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& end);
 
+/**
+ * A function handle that returns the desired discretization step.
+ * @param elapsedTime : time since the start of the horizon at which the step begins.
+ * Returns the desired step, must be strictly positive.
+ */
+using TimeStepPolicy = std::function<scalar_t(scalar_t)>;
+
+/** Constant step of dt along the full horizon */
+TimeStepPolicy uniformTimeStepPolicy(scalar_t dt);
+
+/**
+ * Steps that grow geometrically along the horizon: dt_{k+1} = growthFactor * dt_{k}.
+ *
+ * @param dtInit : step at the start of the horizon.
+ * @param growthFactor : ratio between two consecutive steps, needs to be >= 1.
+ * @param dtMax : upper bound on the step.
+ */
+TimeStepPolicy geometricTimeStepPolicy(scalar_t dtInit, scalar_t growthFactor, scalar_t dtMax);
+
+/**
+ * Piecewise constant steps along the horizon. The step dtList[i] is used until horizonList[i] has elapsed, the last step of dtList is
+ * used for the remainder of the horizon.
+ *
+ * @param horizonList : Strictly increasing list of elapsed times at which the step changes.
+ * @param dtList : List of steps, must be of size horizonList.size() + 1.
+ */
+TimeStepPolicy piecewiseTimeStepPolicy(scalar_array_t horizonList, scalar_array_t dtList);
+
+/**
+ * Decides on time discretization along the horizon. Tries to makes steps as requested by the time step policy, but will also ensure
+ * that eventtimes are part of the discretization.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param timeStepPolicy : desired discretization step as a function of the time elapsed since initTime.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, const TimeStepPolicy& timeStepPolicy,
+                                                        const scalar_array_t& eventTimes,
+                                                        scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
 /**
  * Decides on time discretization along the horizon. Tries to makes step of dt, but will also ensure that eventtimes are part of the
  * discretization.
@@ -76,4 +141,30 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Refines a time discretization by bisecting all intervals for which the discretization error exceeds the tolerance.
+ * Event nodes are preserved, and intervals across an event are never split.
+ *
+ * @param timeDiscretization : time discretization to refine.
+ * @param intervalErrors : Discretization error of each interval [t_i, t_{i+1}], must be of size timeDiscretization.size() - 1.
+ * @param tolerance : Intervals with an error above this value are bisected.
+ * @param dt_min : minimum discretization step. Intervals are not split if the resulting steps would be smaller than this value.
+ * @return refined vector of discrete time points
+ */
+std::vector<AnnotatedTime> refineTimeDiscretization(const std::vector<AnnotatedTime>& timeDiscretization,
+                                                    const scalar_array_t& intervalErrors, scalar_t tolerance,
+                                                    scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
+/**
+ * Matches the nodes of a time discretization to the nodes of a previous time discretization, e.g. of the previous MPC iteration.
+ * A node is matched if the previous discretization contains a node with identical time and event, and if the interval to the next node
+ * is identical as well. The terminal node can only be matched to the previous terminal node.
+ *
+ * @param timeDiscretization : time discretization to match.
+ * @param previousTimeDiscretization : previous time discretization.
+ * @return For each node, the index of the matching node in previousTimeDiscretization, or -1 if there is no match.
+ */
+std::vector<int> matchTimeDiscretization(const std::vector<AnnotatedTime>& timeDiscretization,
+                                         const std::vector<AnnotatedTime>& previousTimeDiscretization);
+
 }  // namespace ocs2
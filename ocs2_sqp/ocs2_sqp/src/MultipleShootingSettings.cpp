@@ -63,6 +63,17 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  auto timeDiscretizationName = time_discretization::toString(settings.timeDiscretizationType);
+  loadData::loadPtreeValue(pt, timeDiscretizationName, fieldName + ".timeDiscretizationType", verbose);
+  settings.timeDiscretizationType = time_discretization::fromString(timeDiscretizationName);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
+  loadData::loadStdVector(filename, fieldName + ".piecewiseHorizons", settings.piecewiseHorizons, verbose);
+  loadData::loadStdVector(filename, fieldName + ".piecewiseDt", settings.piecewiseDt, verbose);
+  loadData::loadPtreeValue(pt, settings.maxTimeRefinements, fieldName + ".maxTimeRefinements", verbose);
+  loadData::loadPtreeValue(pt, settings.timeRefinementTolerance, fieldName + ".timeRefinementTolerance", verbose);
+  loadData::loadPtreeValue(pt, settings.shiftWarmStart, fieldName + ".shiftWarmStart", verbose);
+  loadData::loadPtreeValue(pt, settings.lqReuseTolerance, fieldName + ".lqReuseTolerance", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
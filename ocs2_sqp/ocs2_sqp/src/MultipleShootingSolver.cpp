@@ -29,15 +29,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 #include "ocs2_sqp/MultipleShootingInitialization.h"
-#include "ocs2_sqp/MultipleShootingTranscription.h"
 
 namespace ocs2 {
 
@@ -50,6 +52,22 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
+  // Time discretization
+  switch (settings_.timeDiscretizationType) {
+    case TimeDiscretizationType::UNIFORM:
+      timeStepPolicy_ = uniformTimeStepPolicy(settings_.dt);
+      break;
+    case TimeDiscretizationType::GEOMETRIC:
+      timeStepPolicy_ = geometricTimeStepPolicy(settings_.dt, settings_.dtGrowthFactor, settings_.dtMax);
+      break;
+    case TimeDiscretizationType::PIECEWISE:
+      timeStepPolicy_ = piecewiseTimeStepPolicy(settings_.piecewiseHorizons, settings_.piecewiseDt);
+      break;
+    default:
+      throw std::runtime_error("[MultipleShootingSolver] Time discretization of type " +
+                               time_discretization::toString(settings_.timeDiscretizationType) + " not supported.");
+  }
+
   // Dynamics discretization
   discretizer_ = selectDynamicsDiscretization(settings.integratorType);
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings.integratorType);
@@ -76,12 +94,25 @@ MultipleShootingSolver::~MultipleShootingSolver() {
 void MultipleShootingSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  dualSolution_.clear();
+  problemMetrics_.clear();
+  stateInputEqConstraintLagrangian_.clear();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  convergence_ = multiple_shooting::Convergence::FALSE;
+
+  // Clear warm start
+  lqTime_.clear();
+  lqLinearizationState_.clear();
+  lqLinearizationInput_.clear();
+  qpMultipliersTime_.clear();
 
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  totalNumQpIterations_ = 0;
+  totalNumNodes_ = 0;
+  totalNumReusedNodes_ = 0;
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
@@ -110,6 +141,10 @@ std::string MultipleShootingSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    if (settings_.shiftWarmStart) {
+      infoStream << "Warm start: reused the LQ approximation of " << totalNumReusedNodes_ << " out of " << totalNumNodes_ << " nodes, "
+                 << static_cast<scalar_t>(totalNumQpIterations_) / totalNumIterations_ << " QP iterations on average.\n";
+    }
   }
   return infoStream.str();
 }
@@ -143,6 +178,41 @@ ScalarFunctionQuadraticApproximation MultipleShootingSolver::getValueFunction(sc
   }
 }
 
+ScalarFunctionQuadraticApproximation MultipleShootingSolver::getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) {
+  // Approximation of the cost, note that the multipliers of the Lagrangian terms are used as constants
+  const auto multiplierCollection = getIntermediateDualSolution(time);
+  const ModelData modelData = approximateIntermediateLQ(ocpDefinitions_.front(), time, state, input, multiplierCollection);
+
+  // Initialize the Hamiltonian with the cost
+  ScalarFunctionQuadraticApproximation hamiltonian(modelData.cost);
+
+  // Add the state-input equality constraint term nu * g(x,u), nu is used as a constant
+  const vector_t nu = getStateInputEqualityConstraintLagrangian(time, state);
+  if (nu.size() > 0) {
+    hamiltonian.f += nu.dot(modelData.stateInputEqConstraint.f);
+    hamiltonian.dfdx.noalias() += modelData.stateInputEqConstraint.dfdx.transpose() * nu;
+    hamiltonian.dfdu.noalias() += modelData.stateInputEqConstraint.dfdu.transpose() * nu;
+  }
+
+  // Add the "future cost" dVdx(x) * f(x,u)
+  const ScalarFunctionQuadraticApproximation V = getValueFunction(time, state);
+  const matrix_t dVdxx_dfdx = V.dfdxx.transpose() * modelData.dynamics.dfdx;
+  hamiltonian.f += V.dfdx.dot(modelData.dynamics.f);
+  hamiltonian.dfdx.noalias() += V.dfdxx.transpose() * modelData.dynamics.f + modelData.dynamics.dfdx.transpose() * V.dfdx;
+  hamiltonian.dfdu.noalias() += modelData.dynamics.dfdu.transpose() * V.dfdx;
+  hamiltonian.dfdxx.noalias() += dVdxx_dfdx + dVdxx_dfdx.transpose();
+  hamiltonian.dfdux.noalias() += modelData.dynamics.dfdu.transpose() * V.dfdxx;
+
+  return hamiltonian;
+}
+
+vector_t MultipleShootingSolver::getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const {
+  if (stateInputEqConstraintLagrangian_.empty()) {
+    throw std::runtime_error("[MultipleShootingSolver] The state-input equality constraint Lagrangian is empty! Did the solver run?");
+  }
+  return LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, stateInputEqConstraintLagrangian_);
+}
+
 void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -150,22 +220,21 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
   }
 
-  // Determine time discretization, taking into account event times.
-  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
-
-  // Initialize the state and input
-  vector_array_t x, u;
-  initializeStateInputTrajectories(initState, timeDiscretization, x, u);
-
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
   }
 
+  // Determine time discretization and initialize the state and input
+  vector_array_t x, u;
+  const auto timeDiscretization = getTimeDiscretization(initTime, finalTime, initState, x, u);
+
   // Bookkeeping
   performanceIndeces_.clear();
+  const size_t numQpIterationsBefore = totalNumQpIterations_;
+  const size_t numNodesBefore = totalNumNodes_;
+  const size_t numReusedNodesBefore = totalNumReusedNodes_;
 
   int iter = 0;
   multiple_shooting::Convergence convergence = multiple_shooting::Convergence::FALSE;
@@ -181,7 +250,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     // Solve QP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto& deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -194,6 +263,13 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Check whether the next iteration is expected to finish before the deadline
+    const auto expectedIterationTime = linearQuadraticApproximationTimer_.getAverageInMilliseconds() +
+                                       solveQpTimer_.getAverageInMilliseconds() + linesearchTimer_.getAverageInMilliseconds();
+    if (convergence == multiple_shooting::Convergence::FALSE && !fitsBeforeDeadline(expectedIterationTime)) {
+      convergence = multiple_shooting::Convergence::DEADLINE;
+    }
+
     // Next iteration
     ++iter;
     ++totalNumIterations_;
@@ -201,12 +277,19 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 
   computeControllerTimer_.startTimer();
   setPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+  setDualSolutionAndMetrics(timeDiscretization);
   computeControllerTimer_.endTimer();
 
+  convergence_ = convergence;
   ++numProblems_;
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\nConvergence : " << toString(convergence) << "\n";
+    std::cerr << "QP iterations : " << totalNumQpIterations_ - numQpIterationsBefore << "\n";
+    if (settings_.shiftWarmStart) {
+      std::cerr << "Warm start : reused the LQ approximation of " << totalNumReusedNodes_ - numReusedNodesBefore << " out of "
+                << totalNumNodes_ - numNodesBefore << " nodes\n";
+    }
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver has terminated ++++++++++++++";
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
@@ -217,6 +300,54 @@ void MultipleShootingSolver::runParallel(std::function<void(int)> taskFunction)
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
+std::vector<AnnotatedTime> MultipleShootingSolver::getTimeDiscretization(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                                                         vector_array_t& x, vector_array_t& u) {
+  // Determine time discretization, taking into account event times.
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, timeStepPolicy_, eventTimes);
+  initializeStateInputTrajectories(initState, timeDiscretization, x, u);
+
+  // Error-adaptive refinement: bisect intervals where the discretization error of the initial guess is too large.
+  for (size_t refinement = 0; refinement < settings_.maxTimeRefinements; ++refinement) {
+    const auto intervalErrors = computeDiscretizationErrors(timeDiscretization, x, u);
+    auto refinedTimeDiscretization = refineTimeDiscretization(timeDiscretization, intervalErrors, settings_.timeRefinementTolerance);
+    if (refinedTimeDiscretization.size() == timeDiscretization.size()) {
+      break;  // Nothing was refined
+    }
+    timeDiscretization = std::move(refinedTimeDiscretization);
+    initializeStateInputTrajectories(initState, timeDiscretization, x, u);
+  }
+
+  return timeDiscretization;
+}
+
+scalar_array_t MultipleShootingSolver::computeDiscretizationErrors(const std::vector<AnnotatedTime>& time, const vector_array_t& x,
+                                                                   const vector_array_t& u) {
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  scalar_array_t intervalErrors(N, 0.0);
+  std::atomic_int timeIndex{0};
+  auto parallelTask = [&](int workerId) {
+    // Get worker specific resources
+    OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+
+    int i = timeIndex++;
+    while (i < N) {
+      if (time[i].event != AnnotatedTime::Event::PreEvent) {  // Event nodes have no discretization error
+        const scalar_t ti = getIntervalStart(time[i]);
+        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+        intervalErrors[i] = multiple_shooting::computeIntermediateDiscretizationError(ocpDefinition, discretizer_, ti, dt, x[i], u[i]);
+      }
+
+      i = timeIndex++;
+    }
+  };
+  runParallel(std::move(parallelTask));
+
+  return intervalErrors;
+}
+
 void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& initState,
                                                               const std::vector<AnnotatedTime>& timeDiscretization,
                                                               vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
@@ -265,25 +396,75 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   }
 }
 
-MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
+const MultipleShootingSolver::OcpSubproblemSolution& MultipleShootingSolver::getOCPSolution(const std::vector<AnnotatedTime>& time,
+                                                                                            const vector_t& delta_x0) {
   // Solve the QP
-  OcpSubproblemSolution solution;
+  auto& solution = subproblemSolution_;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, &constraints_));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, &constraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  const bool withConstraints = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+  // without constraints, or when using projection, we have an unconstrained QP.
+  auto* constraintsPtr = withConstraints ? &constraints_ : nullptr;
+  hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, constraintsPtr));
+
+  // Warm start with the multipliers of the previous QP, shifted to the current time discretization. Unmatched nodes are cold started.
+  if (settings_.shiftWarmStart && !qpMultipliersTime_.empty()) {
+    const auto previousNodeIndices = matchTimeDiscretization(time, qpMultipliersTime_);
+    auto& warmStart = qpWarmStart_;
+    warmStart.costate.resize(time.size() - 1);
+    for (int i = 0; i + 1 < time.size(); i++) {
+      const int j = previousNodeIndices[i];
+      if (j >= 0 && j < qpMultipliers_.costate.size()) {
+        warmStart.costate[i] = qpMultipliers_.costate[j];
+      } else {
+        warmStart.costate[i].resize(0);
+      }
+    }
+    if (withConstraints && !qpMultipliers_.lowerConstraint.empty()) {
+      const bool withSlacks = qpMultipliers_.lowerSlack.size() == qpMultipliers_.lowerConstraint.size();
+      warmStart.lowerConstraint.resize(time.size());
+      warmStart.upperConstraint.resize(time.size());
+      warmStart.lowerSlack.resize(withSlacks ? time.size() : 0);
+      warmStart.upperSlack.resize(withSlacks ? time.size() : 0);
+      for (int i = 0; i < time.size(); i++) {
+        const int j = previousNodeIndices[i];
+        if (j >= 0) {
+          warmStart.lowerConstraint[i] = qpMultipliers_.lowerConstraint[j];
+          warmStart.upperConstraint[i] = qpMultipliers_.upperConstraint[j];
+          if (withSlacks) {
+            warmStart.lowerSlack[i] = qpMultipliers_.lowerSlack[j];
+            warmStart.upperSlack[i] = qpMultipliers_.upperSlack[j];
+          }
+        } else {
+          warmStart.lowerConstraint[i].resize(0);
+          warmStart.upperConstraint[i].resize(0);
+          if (withSlacks) {
+            warmStart.lowerSlack[i].resize(0);
+            warmStart.upperSlack[i].resize(0);
+          }
+        }
+      }
+    } else {
+      warmStart.lowerConstraint.clear();
+      warmStart.upperConstraint.clear();
+      warmStart.lowerSlack.clear();
+      warmStart.upperSlack.clear();
+    }
+    hpipmInterface_.setWarmStart(warmStart);
   }
 
+  const auto status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+
   if (status != hpipm_status::SUCCESS) {
     throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
   }
 
+  totalNumQpIterations_ += hpipmInterface_.getNumIterations();
+  if (settings_.shiftWarmStart || hasStateInputConstraints) {
+    hpipmInterface_.getMultipliers(withConstraints, qpMultipliers_);
+  }
+
   // To determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
   solution.armijoDescentMetric = 0.0;
   for (int i = 0; i < cost_.size(); i++) {
@@ -307,12 +488,41 @@ MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolu
     }
   }
 
+  if (settings_.shiftWarmStart) {
+    qpMultipliersTime_ = time;
+  }
+
   return solution;
 }
 
+void MultipleShootingSolver::computeStateInputEqualityConstraintLagrangian(const std::vector<AnnotatedTime>& time, int i,
+                                                                           vector_t& nu) const {
+  const auto& solution = subproblemSolution_;
+  const auto& qpMultipliers = qpMultipliers_;
+  if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    nu.resize(0);
+  } else if (settings_.projectStateInputEqualityConstraints) {
+    const auto& coefficients = projectionMultiplierCoefficients_[i];
+    if (coefficients.f.size() > 0) {
+      nu = coefficients.f;
+      nu.noalias() += coefficients.dfdx * solution.deltaXSol[i];
+      nu.noalias() += coefficients.dfdu * solution.deltaUSol[i];
+      nu.noalias() += coefficients.dfdcostate * qpMultipliers.costate[i];
+    } else {
+      nu.resize(0);
+    }
+  } else if (!qpMultipliers.lowerConstraint.empty()) {
+    // The equality constraints are passed to HPIPM with lg = ug, scale the multiplier to continuous time
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    nu = (qpMultipliers.upperConstraint[i] - qpMultipliers.lowerConstraint[i]) / dt;
+  } else {
+    nu.resize(0);
+  }
+}
+
 void MultipleShootingSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0], valueFunction_);
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -348,7 +558,11 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
         // We computed u = u'(t) + K (x - x'(t));
         // >> uff = u'(t) - K x'(t)
         if (constraintsProjection_[i].f.size() > 0) {
-          controllerGain.push_back(std::move(constraintsProjection_[i].dfdx));  // Steal! Don't use after this.
+          if (settings_.shiftWarmStart) {
+            controllerGain.push_back(constraintsProjection_[i].dfdx);  // Copy, the projection can be reused in the next problem.
+          } else {
+            controllerGain.push_back(std::move(constraintsProjection_[i].dfdx));  // Steal! Don't use after this.
+          }
           controllerGain.back().noalias() += constraintsProjection_[i].dfdu * KMatrices[i];
         } else {
           controllerGain.push_back(std::move(KMatrices[i]));
@@ -382,16 +596,185 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
   }
 }
 
+void MultipleShootingSolver::setDualSolutionAndMetrics(const std::vector<AnnotatedTime>& timeDiscretization) {
+  const auto& time = primalSolution_.timeTrajectory_;
+  const auto& x = primalSolution_.stateTrajectory_;
+  const auto& u = primalSolution_.inputTrajectory_;
+  const int N = static_cast<int>(time.size()) - 1;
+
+  stateInputEqConstraintLagrangian_.resize(N + 1);
+
+  dualSolution_.clear();
+  dualSolution_.timeTrajectory = time;
+  dualSolution_.postEventIndices = primalSolution_.postEventIndices_;
+  dualSolution_.preJumps.resize(primalSolution_.postEventIndices_.size());
+  dualSolution_.intermediates.resize(N + 1);
+
+  problemMetrics_.clear();
+  problemMetrics_.preJumps.resize(primalSolution_.postEventIndices_.size());
+  problemMetrics_.intermediates.resize(N + 1);
+
+  // The solver does not update the multipliers of the Lagrangian terms, they keep their initial value. The metrics were computed with
+  // the same multipliers during the approximation and the line search of the accepted iterate.
+  std::atomic_int timeIndex{0};
+  auto parallelTask = [&](int workerId) {
+    // Get worker specific resources
+    const OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+
+    int i = timeIndex++;
+    while (i <= N) {
+      if (i < N) {
+        computeStateInputEqualityConstraintLagrangian(timeDiscretization, i, stateInputEqConstraintLagrangian_[i]);
+      }
+      initializeIntermediateMultiplierCollection(ocpDefinition, time[i], dualSolution_.intermediates[i]);
+      if (i < N && timeDiscretization[i].event != AnnotatedTime::Event::PreEvent) {
+        problemMetrics_.intermediates[i] = std::move(nodeMetrics_[i]);
+      }
+
+      i = timeIndex++;
+    }
+
+    if (i == N + 1) {  // Only one worker will execute this
+      for (size_t e = 0; e < primalSolution_.postEventIndices_.size(); e++) {
+        const auto preEventIndex = primalSolution_.postEventIndices_[e] - 1;
+        initializePreJumpMultiplierCollection(ocpDefinition, time[preEventIndex], dualSolution_.preJumps[e]);
+        problemMetrics_.preJumps[e] = std::move(nodeMetrics_[preEventIndex]);
+      }
+
+      initializeFinalMultiplierCollection(ocpDefinition, time[N], dualSolution_.final);
+      problemMetrics_.final = std::move(nodeMetrics_[N]);
+    }
+  };
+  runParallel(std::move(parallelTask));
+
+  // Align the multipliers and the intermediate metrics with the primal solution. Events take the values of the preceding node, and the
+  // final ones are repeated.
+  for (const auto postEventIndex : primalSolution_.postEventIndices_) {
+    const auto preEventIndex = postEventIndex - 1;
+    if (preEventIndex > 0) {
+      stateInputEqConstraintLagrangian_[preEventIndex] = stateInputEqConstraintLagrangian_[preEventIndex - 1];
+      problemMetrics_.intermediates[preEventIndex] = problemMetrics_.intermediates[preEventIndex - 1];
+    }
+  }
+  stateInputEqConstraintLagrangian_[N] = stateInputEqConstraintLagrangian_[N - 1];
+  problemMetrics_.intermediates[N] = problemMetrics_.intermediates[N - 1];
+}
+
+std::vector<int> MultipleShootingSolver::getReusableNodes(const std::vector<AnnotatedTime>& time, const vector_array_t& x,
+                                                          const vector_array_t& u) {
+  std::vector<int> reusableNodes(time.size(), -1);
+  if (!settings_.shiftWarmStart || lqTime_.empty()) {
+    return reusableNodes;
+  }
+
+  // The cost and dynamics depend on the references, only reuse if these did not change.
+  const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  if (lqTargetTrajectories_ != targetTrajectories || lqModeSchedule_.eventTimes != modeSchedule.eventTimes ||
+      lqModeSchedule_.modeSequence != modeSchedule.modeSequence) {
+    return reusableNodes;
+  }
+
+  const auto isClose = [this](const vector_t& lhs, const vector_t& rhs) {
+    return lhs.size() == rhs.size() && (lhs.size() == 0 || (lhs - rhs).lpNorm<Eigen::Infinity>() <= settings_.lqReuseTolerance);
+  };
+
+  // The next state enters the dynamics linearly, only the point of linearization of the node itself is compared.
+  const auto previousNodeIndices = matchTimeDiscretization(time, lqTime_);
+  const int N = static_cast<int>(time.size()) - 1;
+  for (int i = 0; i <= N; i++) {
+    const int j = previousNodeIndices[i];
+    if (j >= 0 && isClose(x[i], lqLinearizationState_[j])) {
+      if (i == N) {  // terminal node only depends on the state
+        reusableNodes[i] = (j + 1 == lqTime_.size()) ? j : -1;
+      } else if (j < lqLinearizationInput_.size() && isClose(u[i], lqLinearizationInput_[j])) {
+        reusableNodes[i] = j;
+      }
+    }
+  }
+  return reusableNodes;
+}
+
+void MultipleShootingSolver::shiftReusedNode(int i, const vector_t& dx, const vector_t& du, const vector_t& dxNext) {
+  // Projected nodes are expressed in the input of the constraint null space, which does not change with the iterate.
+  const bool projected = i < constraintsProjection_.size() && constraintsProjection_[i].f.size() > 0;
+  const bool shiftInput = !projected && du.size() > 0;
+
+  // Cost: second order Taylor expansion around the new point, gradients are updated after the value.
+  auto& cost = cost_[i];
+  if (cost.dfdx.size() == dx.size() && cost.dfdxx.rows() == dx.size()) {
+    cost.f += cost.dfdx.dot(dx) + 0.5 * dx.dot(cost.dfdxx * dx);
+    if (shiftInput && cost.dfdu.size() == du.size()) {
+      cost.f += cost.dfdu.dot(du) + du.dot(cost.dfdux * dx) + 0.5 * du.dot(cost.dfduu * du);
+      cost.dfdx.noalias() += cost.dfdux.transpose() * du;
+      cost.dfdu.noalias() += cost.dfduu * du;
+    }
+    cost.dfdx.noalias() += cost.dfdxx * dx;
+    if (cost.dfdux.cols() == dx.size() && cost.dfdu.size() > 0) {
+      cost.dfdu.noalias() += cost.dfdux * dx;
+    }
+  }
+
+  // Constraints: C * dx + D * du + e
+  auto& constraints = constraints_[i];
+  if (constraints.f.size() > 0) {
+    constraints.f.noalias() += constraints.dfdx * dx;
+    if (du.size() > 0 && constraints.dfdu.cols() == du.size()) {
+      constraints.f.noalias() += constraints.dfdu * du;
+    }
+  }
+
+  if (i < dynamics_.size()) {
+    // Dynamics: A * dx + B * du + b - x_next
+    auto& dynamics = dynamics_[i];
+    dynamics.f.noalias() += dynamics.dfdx * dx;
+    if (shiftInput && dynamics.dfdu.cols() == du.size()) {
+      dynamics.f.noalias() += dynamics.dfdu * du;
+    }
+    dynamics.f -= dxNext;
+
+    // Projection: du = Pu * du_tilde + Px * dx + Pf
+    if (projected) {
+      auto& projection = constraintsProjection_[i];
+      projection.f.noalias() += projection.dfdx * dx;
+      projection.f -= du;
+    }
+    auto& coefficients = projectionMultiplierCoefficients_[i];
+    if (coefficients.f.size() > 0) {
+      coefficients.f.noalias() += coefficients.dfdx * dx;
+      coefficients.f.noalias() += coefficients.dfdu * du;
+    }
+  }
+}
+
 PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                                   const vector_array_t& x, const vector_array_t& u) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
+  // Keep the previous approximation aside, nodes that did not change are moved into the new approximation
+  const auto reusableNodes = getReusableNodes(time, x, u);
+  std::vector<VectorFunctionLinearApproximation> previousDynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> previousCost;
+  std::vector<VectorFunctionLinearApproximation> previousConstraints;
+  std::vector<VectorFunctionLinearApproximation> previousConstraintsProjection;
+  std::vector<multiple_shooting::ProjectionMultiplierCoefficients> previousProjectionMultiplierCoefficients;
+  if (settings_.shiftWarmStart) {
+    previousDynamics.swap(dynamics_);
+    previousCost.swap(cost_);
+    previousConstraints.swap(constraints_);
+    previousConstraintsProjection.swap(constraintsProjection_);
+    previousProjectionMultiplierCoefficients.swap(projectionMultiplierCoefficients_);
+  }
+
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
   dynamics_.resize(N);
   cost_.resize(N + 1);
   constraints_.resize(N + 1);
   constraintsProjection_.resize(N);
+  projectionMultiplierCoefficients_.resize(N);
+  nodePerformance_.resize(N + 1);
+  nodeMetrics_.resize(N + 1);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
@@ -402,36 +785,70 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
 
     int i = timeIndex++;
     while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      const int j = reusableNodes[i];
+      if (j >= 0) {
+        // Unchanged node, reuse the approximation around the current iterate and only evaluate the performance
+        dynamics_[i] = std::move(previousDynamics[j]);
+        cost_[i] = std::move(previousCost[j]);
+        constraints_[i] = std::move(previousConstraints[j]);
+        constraintsProjection_[i] = std::move(previousConstraintsProjection[j]);
+        projectionMultiplierCoefficients_[i] = std::move(previousProjectionMultiplierCoefficients[j]);
+        shiftReusedNode(i, x[i] - lqState_[j], u[i] - lqInput_[j], x[i + 1] - lqState_[j + 1]);
+        if (time[i].event == AnnotatedTime::Event::PreEvent) {
+          nodePerformance_[i] =
+              multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1], &nodeMetrics_[i]);
+        } else {
+          const scalar_t ti = getIntervalStart(time[i]);
+          const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+          nodePerformance_[i] = multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1],
+                                                                                  u[i], &nodeMetrics_[i]);
+        }
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        workerPerformance += result.performance;
+        nodePerformance_[i] = result.performance;
+        nodeMetrics_[i] = std::move(result.metrics);
         dynamics_[i] = std::move(result.dynamics);
         cost_[i] = std::move(result.cost);
         constraints_[i] = std::move(result.constraints);
         constraintsProjection_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
+        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
         auto result =
             multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i]);
-        workerPerformance += result.performance;
+        nodePerformance_[i] = result.performance;
+        nodeMetrics_[i] = std::move(result.metrics);
         dynamics_[i] = std::move(result.dynamics);
         cost_[i] = std::move(result.cost);
         constraints_[i] = std::move(result.constraints);
         constraintsProjection_[i] = std::move(result.constraintsProjection);
+        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
       }
+      workerPerformance += nodePerformance_[i];
 
       i = timeIndex++;
     }
 
     if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      workerPerformance += result.performance;
-      cost_[i] = std::move(result.cost);
-      constraints_[i] = std::move(result.constraints);
+      const int j = reusableNodes[N];
+      if (j >= 0) {
+        cost_[i] = std::move(previousCost[j]);
+        constraints_[i] = std::move(previousConstraints[j]);
+        shiftReusedNode(i, x[N] - lqState_[j], vector_t(), vector_t());
+        nodePerformance_[i] =
+            multiple_shooting::computeTerminalPerformance(ocpDefinition, getIntervalStart(time[N]), x[N], &nodeMetrics_[i]);
+      } else {
+        const scalar_t tN = getIntervalStart(time[N]);
+        auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
+        nodePerformance_[i] = result.performance;
+        nodeMetrics_[i] = std::move(result.metrics);
+        cost_[i] = std::move(result.cost);
+        constraints_[i] = std::move(result.constraints);
+      }
+      workerPerformance += nodePerformance_[i];
     }
 
     // Accumulate! Same worker might run multiple tasks
@@ -439,6 +856,28 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   };
   runParallel(std::move(parallelTask));
 
+  // Store the operating point of this approximation
+  if (settings_.shiftWarmStart) {
+    totalNumNodes_ += time.size();
+    totalNumReusedNodes_ += std::count_if(reusableNodes.begin(), reusableNodes.end(), [](int j) { return j >= 0; });
+    vector_array_t linearizationState(N + 1);
+    vector_array_t linearizationInput(N);
+    for (int i = 0; i <= N; i++) {
+      const int j = reusableNodes[i];
+      linearizationState[i] = (j >= 0) ? lqLinearizationState_[j] : x[i];
+      if (i < N) {
+        linearizationInput[i] = (j >= 0) ? lqLinearizationInput_[j] : u[i];
+      }
+    }
+    lqLinearizationState_.swap(linearizationState);
+    lqLinearizationInput_.swap(linearizationInput);
+    lqTime_ = time;
+    lqState_ = x;
+    lqInput_ = u;
+    lqTargetTrajectories_ = this->getReferenceManager().getTargetTrajectories();
+    lqModeSchedule_ = this->getReferenceManager().getModeSchedule();
+  }
+
   // Account for init state in performance
   performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
@@ -454,6 +893,7 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
   const int N = static_cast<int>(time.size()) - 1;
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  stepMetrics_.resize(N + 1);
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
@@ -464,12 +904,14 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        workerPerformance += multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1]);
+        workerPerformance +=
+            multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1], &stepMetrics_[i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        workerPerformance += multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        workerPerformance += multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i],
+                                                                              &stepMetrics_[i]);
       }
 
       i = timeIndex++;
@@ -477,7 +919,7 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      workerPerformance += multiple_shooting::computeTerminalPerformance(ocpDefinition, tN, x[N]);
+      workerPerformance += multiple_shooting::computeTerminalPerformance(ocpDefinition, tN, x[N], &stepMetrics_[N]);
     }
 
     // Accumulate! Same worker might run multiple tasks
@@ -538,7 +980,10 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   scalar_t alpha = 1.0;
   vector_array_t xNew(x.size());
   vector_array_t uNew(u.size());
+  benchmark::RepeatedTimer stepTimer;
   do {
+    stepTimer.startTimer();
+
     // Compute step
     for (int i = 0; i < u.size(); i++) {
       if (du[i].size() > 0) {  // account for absence of inputs at events.
@@ -552,6 +997,7 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
     // Compute cost and constraints
     const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
     const scalar_t newConstraintViolation = totalConstraintViolation(performanceNew);
+    stepTimer.endTimer();
 
     // Step acceptance and record step type
     const bool stepAccepted = [&]() {
@@ -582,6 +1028,7 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
     if (stepAccepted) {  // Return if step accepted
       x = std::move(xNew);
       u = std::move(uNew);
+      nodeMetrics_.swap(stepMetrics_);
 
       stepInfo.stepSize = alpha;
       stepInfo.dx_norm = alpha * deltaXnorm;
@@ -600,6 +1047,14 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
         }
         break;
       }
+
+      // Stop if the evaluation of the smaller step is not expected to finish before the deadline. The current iterate is kept.
+      if (!fitsBeforeDeadline(stepTimer.getMaxIntervalInMilliseconds())) {
+        if (settings_.printLinesearch) {
+          std::cerr << "Exiting linesearch early since the next step is not expected to finish before the deadline\n";
+        }
+        break;
+      }
     }
   } while (alpha >= settings_.alpha_min);
 
@@ -624,6 +1079,9 @@ multiple_shooting::Convergence MultipleShootingSolver::checkConvergence(int iter
   if ((iteration + 1) >= settings_.sqpIteration) {
     // Converged because the next iteration would exceed the specified number of iterations
     return Convergence::ITERATIONS;
+  } else if (isTerminatedByDeadline()) {
+    // Converged because the line search was cut short by the deadline
+    return Convergence::DEADLINE;
   } else if (stepInfo.stepSize < settings_.alpha_min) {
     // Converged because step size is below the specified minimum
     return Convergence::STEPSIZE;
@@ -59,6 +59,8 @@ std::string toString(const Convergence& convergence) {
       return "Cost decrease and constraint satisfaction below tolerance";
     case Convergence::PRIMAL:
       return "Primal update below tolerance";
+    case Convergence::DEADLINE:
+      return "Next iteration does not fit before the deadline";
     case Convergence::FALSE:
     default:
       return "Not Converged";
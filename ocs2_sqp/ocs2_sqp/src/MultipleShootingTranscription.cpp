@@ -31,12 +31,56 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 #include "ocs2_sqp/ConstraintProjection.h"
 
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Adds the state equality constraint and the Lagrangian terms to the metrics, the multipliers keep their initial value */
+void computeIntermediateLagrangianMetrics(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                          const vector_t& u, MetricsCollection& metrics) {
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+  MultiplierCollection multipliers;
+  initializeIntermediateMultiplierCollection(optimalControlProblem, t, multipliers);
+
+  metrics.stateEqConstraint = optimalControlProblem.stateEqualityConstraintPtr->getValue(t, x, preComputation);
+  metrics.stateEqLagrangian = optimalControlProblem.stateEqualityLagrangianPtr->getValue(t, x, multipliers.stateEq, preComputation);
+  metrics.stateIneqLagrangian = optimalControlProblem.stateInequalityLagrangianPtr->getValue(t, x, multipliers.stateIneq, preComputation);
+  metrics.stateInputEqLagrangian =
+      optimalControlProblem.equalityLagrangianPtr->getValue(t, x, u, multipliers.stateInputEq, preComputation);
+  metrics.stateInputIneqLagrangian =
+      optimalControlProblem.inequalityLagrangianPtr->getValue(t, x, u, multipliers.stateInputIneq, preComputation);
+}
+
+/** Adds the state equality constraint and the Lagrangian terms of the terminal node to the metrics */
+void computeFinalLagrangianMetrics(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                   MetricsCollection& metrics) {
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+  MultiplierCollection multipliers;
+  initializeFinalMultiplierCollection(optimalControlProblem, t, multipliers);
+
+  metrics.stateEqConstraint = optimalControlProblem.finalEqualityConstraintPtr->getValue(t, x, preComputation);
+  metrics.stateEqLagrangian = optimalControlProblem.finalEqualityLagrangianPtr->getValue(t, x, multipliers.stateEq, preComputation);
+  metrics.stateIneqLagrangian = optimalControlProblem.finalInequalityLagrangianPtr->getValue(t, x, multipliers.stateIneq, preComputation);
+}
+
+/** Adds the state equality constraint and the Lagrangian terms of an event node to the metrics */
+void computePreJumpLagrangianMetrics(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                     MetricsCollection& metrics) {
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+  MultiplierCollection multipliers;
+  initializePreJumpMultiplierCollection(optimalControlProblem, t, multipliers);
+
+  metrics.stateEqConstraint = optimalControlProblem.preJumpEqualityConstraintPtr->getValue(t, x, preComputation);
+  metrics.stateEqLagrangian = optimalControlProblem.preJumpEqualityLagrangianPtr->getValue(t, x, multipliers.stateEq, preComputation);
+  metrics.stateIneqLagrangian =
+      optimalControlProblem.preJumpInequalityLagrangianPtr->getValue(t, x, multipliers.stateIneq, preComputation);
+}
+}  // namespace
+
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
@@ -47,6 +91,7 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
   auto& cost = transcription.cost;
   auto& constraints = transcription.constraints;
   auto& projection = transcription.constraintsProjection;
+  auto& metrics = transcription.metrics;
 
   // Dynamics
   // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
@@ -60,18 +105,22 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
 
   // Costs: Approximate the integral with forward euler
   cost = approximateCost(optimalControlProblem, t, x, u);
+  metrics.cost = cost.f;
   cost *= dt;
   performance.cost = cost.f;
 
   // Constraints
+  computeIntermediateLagrangianMetrics(optimalControlProblem, t, x, u, metrics);
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
     // C_{k} * dx_{k} + D_{k} * du_{k} + e_{k} = 0
     constraints = optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+    metrics.stateInputEqConstraint = constraints.f;
     if (constraints.f.size() > 0) {
       performance.equalityConstraintsSSE = dt * constraints.f.squaredNorm();
       if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
         // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
         projection = luConstraintProjection(constraints);
+        computeProjectionMultiplierCoefficients(dynamics, cost, constraints, dt, transcription.projectionMultiplierCoefficients);
         constraints = VectorFunctionLinearApproximation();
 
         // Adapt dynamics and cost
@@ -84,8 +133,24 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
   return transcription;
 }
 
+void computeProjectionMultiplierCoefficients(const VectorFunctionLinearApproximation& dynamics,
+                                             const ScalarFunctionQuadraticApproximation& cost,
+                                             const VectorFunctionLinearApproximation& constraints, scalar_t dt,
+                                             ProjectionMultiplierCoefficients& coefficients) {
+  // nu = -1/dt * (D * D^T)^-1 * D * (r + P * dx + R * du + B^T * costate)
+  const auto& D = constraints.dfdu;
+  matrix_t negPseudoInverseTranspose = (D * D.transpose()).ldlt().solve(D);
+  negPseudoInverseTranspose *= -1.0 / dt;
+
+  coefficients.dfdx.noalias() = negPseudoInverseTranspose * cost.dfdux;
+  coefficients.dfdu.noalias() = negPseudoInverseTranspose * cost.dfduu;
+  coefficients.dfdcostate.noalias() = negPseudoInverseTranspose * dynamics.dfdu.transpose();
+  coefficients.f.noalias() = negPseudoInverseTranspose * cost.dfdu;
+}
+
 PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
-                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                                MetricsCollection* metricsPtr) {
   PerformanceIndex performance;
 
   // Dynamics
@@ -98,45 +163,73 @@ PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& opt
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
 
   // Costs
-  performance.cost = dt * computeCost(optimalControlProblem, t, x, u);
+  const scalar_t cost = computeCost(optimalControlProblem, t, x, u);
+  performance.cost = dt * cost;
 
   // Constraints
+  vector_t constraints;
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
-    const vector_t constraints = optimalControlProblem.equalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
+    constraints = optimalControlProblem.equalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
     if (constraints.size() > 0) {
       performance.equalityConstraintsSSE = dt * constraints.squaredNorm();
     }
   }
 
+  if (metricsPtr != nullptr) {
+    metricsPtr->cost = cost;
+    metricsPtr->stateInputEqConstraint = std::move(constraints);
+    computeIntermediateLagrangianMetrics(optimalControlProblem, t, x, u, *metricsPtr);
+  }
+
   return performance;
 }
 
+scalar_t computeIntermediateDiscretizationError(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
+                                                scalar_t t, scalar_t dt, const vector_t& x, const vector_t& u) {
+  const scalar_t halfStep = 0.5 * dt;
+  const vector_t x_mid = discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, halfStep);
+  vector_t defect = discretizer(*optimalControlProblem.dynamicsPtr, t + halfStep, x_mid, u, halfStep);
+  defect -= discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  return dt * defect.squaredNorm();
+}
+
 TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
   // Results and short-hand notation
   TerminalTranscription transcription;
   auto& performance = transcription.performance;
   auto& cost = transcription.cost;
   auto& constraints = transcription.constraints;
+  auto& metrics = transcription.metrics;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Approximation;
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
 
   cost = approximateFinalCost(optimalControlProblem, t, x);
   performance.cost = cost.f;
 
+  metrics.cost = cost.f;
+  computeFinalLagrangianMetrics(optimalControlProblem, t, x, metrics);
+
   constraints = VectorFunctionLinearApproximation::Zero(0, x.size());
 
   return transcription;
 }
 
-PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
+PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                            MetricsCollection* metricsPtr) {
   PerformanceIndex performance;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint;
+  const auto request = (metricsPtr != nullptr) ? Request::Cost + Request::SoftConstraint + Request::Constraint
+                                               : Request::Cost + Request::SoftConstraint;
   optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
 
   performance.cost = computeFinalCost(optimalControlProblem, t, x);
 
+  if (metricsPtr != nullptr) {
+    metricsPtr->cost = performance.cost;
+    computeFinalLagrangianMetrics(optimalControlProblem, t, x, *metricsPtr);
+  }
+
   return performance;
 }
 
@@ -148,8 +241,9 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
   auto& dynamics = transcription.dynamics;
   auto& cost = transcription.cost;
   auto& constraints = transcription.constraints;
+  auto& metrics = transcription.metrics;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Dynamics + Request::Approximation;
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics + Request::Approximation;
   optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
 
   // Dynamics
@@ -162,15 +256,19 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
   cost = approximateEventCost(optimalControlProblem, t, x);
   performance.cost = cost.f;
 
+  metrics.cost = cost.f;
+  computePreJumpLagrangianMetrics(optimalControlProblem, t, x, metrics);
+
   constraints = VectorFunctionLinearApproximation::Zero(0, x.size());
   return transcription;
 }
 
 PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
-                                         const vector_t& x_next) {
+                                         const vector_t& x_next, MetricsCollection* metricsPtr) {
   PerformanceIndex performance;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Dynamics;
+  const auto request = (metricsPtr != nullptr) ? Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics
+                                               : Request::Cost + Request::SoftConstraint + Request::Dynamics;
   optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
 
   // Dynamics
@@ -179,6 +277,11 @@ PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalCon
 
   performance.cost = computeEventCost(optimalControlProblem, t, x);
 
+  if (metricsPtr != nullptr) {
+    metricsPtr->cost = performance.cost;
+    computePreJumpLagrangianMetrics(optimalControlProblem, t, x, *metricsPtr);
+  }
+
   return performance;
 }
 
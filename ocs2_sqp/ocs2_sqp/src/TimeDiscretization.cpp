@@ -29,10 +29,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/TimeDiscretization.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
 
+namespace time_discretization {
+
+std::string toString(TimeDiscretizationType type) {
+  static const std::unordered_map<TimeDiscretizationType, std::string> typeMap = {{TimeDiscretizationType::UNIFORM, "UNIFORM"},
+                                                                                  {TimeDiscretizationType::GEOMETRIC, "GEOMETRIC"},
+                                                                                  {TimeDiscretizationType::PIECEWISE, "PIECEWISE"}};
+
+  return typeMap.at(type);
+}
+
+TimeDiscretizationType fromString(const std::string& name) {
+  static const std::unordered_map<std::string, TimeDiscretizationType> typeMap = {{"UNIFORM", TimeDiscretizationType::UNIFORM},
+                                                                                  {"GEOMETRIC", TimeDiscretizationType::GEOMETRIC},
+                                                                                  {"PIECEWISE", TimeDiscretizationType::PIECEWISE}};
+
+  return typeMap.at(name);
+}
+
+}  // namespace time_discretization
+
 scalar_t getInterpolationTime(const AnnotatedTime& annotatedTime) {
   return annotatedTime.time + numeric_traits::limitEpsilon<scalar_t>();
 }
@@ -57,9 +80,43 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
   return getIntervalEnd(end) - getIntervalStart(start);
 }
 
+TimeStepPolicy uniformTimeStepPolicy(scalar_t dt) {
+  assert(dt > 0);
+  return [dt](scalar_t) { return dt; };
+}
+
+TimeStepPolicy geometricTimeStepPolicy(scalar_t dtInit, scalar_t growthFactor, scalar_t dtMax) {
+  assert(dtInit > 0);
+  assert(growthFactor >= 1.0);
+  assert(dtMax >= dtInit);
+  // The nodes of a geometric sequence satisfy tau_{k+1} = growthFactor * tau_{k} + dtInit, with tau the elapsed time.
+  // The step taken from tau_{k} is therefore dtInit + (growthFactor - 1) * tau_{k}.
+  return [=](scalar_t elapsedTime) { return std::min(dtInit + (growthFactor - 1.0) * elapsedTime, dtMax); };
+}
+
+TimeStepPolicy piecewiseTimeStepPolicy(scalar_array_t horizonList, scalar_array_t dtList) {
+  if (dtList.size() != horizonList.size() + 1) {
+    throw std::runtime_error("[piecewiseTimeStepPolicy] dtList should have exactly one more element than horizonList.");
+  }
+  if (!std::is_sorted(horizonList.cbegin(), horizonList.cend())) {
+    throw std::runtime_error("[piecewiseTimeStepPolicy] horizonList should be sorted.");
+  }
+  if (std::any_of(dtList.cbegin(), dtList.cend(), [](scalar_t dt) { return dt <= 0.0; })) {
+    throw std::runtime_error("[piecewiseTimeStepPolicy] All steps in dtList should be strictly positive.");
+  }
+  return [horizonList, dtList](scalar_t elapsedTime) {
+    const auto it = std::upper_bound(horizonList.cbegin(), horizonList.cend(), elapsedTime);
+    return dtList[std::distance(horizonList.cbegin(), it)];
+  };
+}
+
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
-  assert(dt > 0);
+  return timeDiscretizationWithEvents(initTime, finalTime, uniformTimeStepPolicy(dt), eventTimes, dt_min);
+}
+
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, const TimeStepPolicy& timeStepPolicy,
+                                                        const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(finalTime > initTime);
   std::vector<AnnotatedTime> timeDiscretization;
 
@@ -70,6 +127,8 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   // Fill iteratively with pre event, post events are added later
   AnnotatedTime nextNode = timeDiscretization.back();
   while (timeDiscretization.back().time < finalTime) {
+    const scalar_t dt = timeStepPolicy(nextNode.time - initTime);
+    assert(dt > 0);
     nextNode.time = nextNode.time + dt;
     nextNode.event = AnnotatedTime::Event::None;
 
@@ -113,4 +172,57 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   return timeDiscretizationWithDoubleEvents;
 }
 
+std::vector<AnnotatedTime> refineTimeDiscretization(const std::vector<AnnotatedTime>& timeDiscretization,
+                                                    const scalar_array_t& intervalErrors, scalar_t tolerance, scalar_t dt_min) {
+  assert(intervalErrors.size() + 1 == timeDiscretization.size());
+  std::vector<AnnotatedTime> refinedTimeDiscretization;
+  refinedTimeDiscretization.reserve(2 * timeDiscretization.size());  // upper bound on size
+
+  for (size_t i = 0; i + 1 < timeDiscretization.size(); i++) {
+    const auto& start = timeDiscretization[i];
+    const auto& end = timeDiscretization[i + 1];
+    refinedTimeDiscretization.push_back(start);
+
+    // PreEvent -> PostEvent is the jump itself and is never split
+    const bool isEventInterval = start.event == AnnotatedTime::Event::PreEvent;
+    const scalar_t halfStep = 0.5 * (end.time - start.time);
+    if (!isEventInterval && intervalErrors[i] > tolerance && halfStep > dt_min) {
+      refinedTimeDiscretization.emplace_back(start.time + halfStep, AnnotatedTime::Event::None);
+    }
+  }
+  refinedTimeDiscretization.push_back(timeDiscretization.back());
+
+  return refinedTimeDiscretization;
+}
+
+std::vector<int> matchTimeDiscretization(const std::vector<AnnotatedTime>& timeDiscretization,
+                                         const std::vector<AnnotatedTime>& previousTimeDiscretization) {
+  const auto isSameNode = [](const AnnotatedTime& lhs, const AnnotatedTime& rhs) { return lhs.time == rhs.time && lhs.event == rhs.event; };
+  // Orders nodes in time, a PostEvent comes after a PreEvent at the same time
+  const auto isBefore = [](const AnnotatedTime& lhs, const AnnotatedTime& rhs) {
+    return lhs.time < rhs.time ||
+           (lhs.time == rhs.time && lhs.event != AnnotatedTime::Event::PostEvent && rhs.event == AnnotatedTime::Event::PostEvent);
+  };
+
+  std::vector<int> matches(timeDiscretization.size(), -1);
+  size_t j = 0;
+  for (size_t i = 0; i < timeDiscretization.size(); i++) {
+    while (j < previousTimeDiscretization.size() && isBefore(previousTimeDiscretization[j], timeDiscretization[i])) {
+      j++;
+    }
+
+    if (j < previousTimeDiscretization.size() && isSameNode(timeDiscretization[i], previousTimeDiscretization[j])) {
+      const bool isTerminal = (i + 1) == timeDiscretization.size();
+      const bool wasTerminal = (j + 1) == previousTimeDiscretization.size();
+      if (isTerminal && wasTerminal) {
+        matches[i] = j;
+      } else if (!isTerminal && !wasTerminal && isSameNode(timeDiscretization[i + 1], previousTimeDiscretization[j + 1])) {
+        matches[i] = j;
+      }
+    }
+  }
+
+  return matches;
+}
+
 }  // namespace ocs2
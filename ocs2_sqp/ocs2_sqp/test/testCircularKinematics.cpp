@@ -29,10 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
 
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/test/circular_kinematics.h>
 
 TEST(test_circular_kinematics, solve_projected_EqConstraints) {
@@ -141,3 +145,157 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, dualSolutionAndMetrics) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.createValueFunction = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with the constraints projected and with the constraints in the QP subproblem
+  settings.projectStateInputEqualityConstraints = true;
+  ocs2::MultipleShootingSolver projectedSolver(settings, problem, zeroInitializer);
+  projectedSolver.run(startTime, initState, finalTime);
+
+  settings.projectStateInputEqualityConstraints = false;
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+
+  const auto primalSolution = solver.primalSolution(finalTime);
+  const auto& dualSolution = solver.getDualSolution();
+  const auto& problemMetrics = solver.getSolutionMetrics();
+  ASSERT_EQ(dualSolution.timeTrajectory, primalSolution.timeTrajectory_);
+  ASSERT_EQ(dualSolution.intermediates.size(), primalSolution.timeTrajectory_.size());
+  ASSERT_EQ(problemMetrics.intermediates.size(), primalSolution.timeTrajectory_.size());
+  ASSERT_TRUE(problemMetrics.preJumps.empty());
+
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    const auto& u = primalSolution.inputTrajectory_[i];
+
+    // Metrics are those of the primal solution
+    ASSERT_EQ(problemMetrics.intermediates[i].stateInputEqConstraint.size(), 1);
+    ASSERT_LT(problemMetrics.intermediates[i].stateInputEqConstraint.norm(), 1e-2);
+    ocs2::MultiplierCollection multipliers;
+    ocs2::initializeIntermediateMultiplierCollection(problem, t, multipliers);
+    const auto metrics = ocs2::computeIntermediateMetrics(problem, t, x, u, multipliers);
+    ASSERT_NEAR(problemMetrics.intermediates[i].cost, metrics.cost, 1e-9) << "time: " << t;
+    ASSERT_TRUE(problemMetrics.intermediates[i].stateInputEqConstraint.isApprox(metrics.stateInputEqConstraint)) << "time: " << t;
+
+    // Both ways of handling the constraints recover the same multipliers
+    const auto nu = solver.getStateInputEqualityConstraintLagrangian(t, x);
+    const auto nuProjected = projectedSolver.getStateInputEqualityConstraintLagrangian(t, x);
+    ASSERT_EQ(nu.size(), 1);
+    ASSERT_LT((nu - nuProjected).norm(), 1e-3 * (1.0 + nu.norm())) << "time: " << t;
+
+    // Hamiltonian
+    const auto hamiltonian = solver.getHamiltonian(t, x, u);
+    ASSERT_EQ(hamiltonian.dfdx.size(), x.size());
+    ASSERT_EQ(hamiltonian.dfdu.size(), u.size());
+  }
+  ASSERT_NEAR(problemMetrics.final.cost, ocs2::computeFinalCost(problem, finalTime, primalSolution.stateTrajectory_.back()), 1e-9);
+}
+
+TEST(test_circular_kinematics, shiftWarmStart) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  const ocs2::scalar_t horizon = 1.0;
+
+  for (const bool projection : {true, false}) {
+    settings.projectStateInputEqualityConstraints = projection;
+    settings.shiftWarmStart = false;
+    ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+    settings.shiftWarmStart = true;
+    ocs2::MultipleShootingSolver warmStartSolver(settings, problem, zeroInitializer);
+
+    // Receding horizon, shifted by one discretization step each time. The nonlinear problem is solved to the same solution whether the
+    // approximation of converged nodes is reused or not.
+    ocs2::scalar_t startTime = 0.0;
+    for (int iter = 0; iter < 3; iter++) {
+      solver.run(startTime, initState, startTime + horizon);
+      warmStartSolver.run(startTime, initState, startTime + horizon);
+
+      const auto performance = warmStartSolver.getPerformanceIndeces();
+      ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+      ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+
+      const auto solution = solver.primalSolution(startTime + horizon);
+      const auto warmStartSolution = warmStartSolver.primalSolution(startTime + horizon);
+      ASSERT_EQ(solution.timeTrajectory_.size(), warmStartSolution.timeTrajectory_.size());
+      for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+        ASSERT_LT((solution.stateTrajectory_[i] - warmStartSolution.stateTrajectory_[i]).norm(), 1e-3) << "projection: " << projection;
+        ASSERT_LT((solution.inputTrajectory_[i] - warmStartSolution.inputTrajectory_[i]).norm(), 1e-3) << "projection: " << projection;
+      }
+
+      startTime = solution.timeTrajectory_[1];
+    }
+    ASSERT_GT(warmStartSolver.getNumReusedNodes(), 0) << "projection: " << projection;
+  }
+}
+
+TEST(test_circular_kinematics, expired_deadline) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.printLinesearch = true;
+  settings.nThreads = 1;
+  settings.g_max = 0.1;  // the full step, which violates the constraint, is rejected and the line search is entered
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with an expired deadline
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.setDeadline(std::chrono::steady_clock::now());
+  testing::internal::CaptureStderr();
+  solver.run(startTime, initState, finalTime);
+  const std::string linesearchOutput = testing::internal::GetCapturedStderr();
+
+  // the line search is cut short after the rejected full step, and the deadline is reported instead of a too small step size
+  EXPECT_NE(linesearchOutput.find("not expected to finish before the deadline"), std::string::npos);
+  EXPECT_TRUE(solver.isTerminatedByDeadline());
+  EXPECT_EQ(solver.getConvergence(), ocs2::multiple_shooting::Convergence::DEADLINE);
+  EXPECT_EQ(solver.getNumIterations(), 1);
+
+  // the initial iterate is kept
+  EXPECT_DOUBLE_EQ(solver.getPerformanceIndeces().equalityConstraintsSSE, 0.0);
+}
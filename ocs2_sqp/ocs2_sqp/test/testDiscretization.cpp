@@ -127,4 +127,105 @@ TEST(test_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+
+TEST(test_discretization, geometricSteps) {
+  scalar_t initTime = 1.0;
+  scalar_t finalTime = 2.0;
+  scalar_t dtInit = 0.05;
+  scalar_t growthFactor = 1.5;
+  scalar_t dtMax = 0.2;
+  scalar_array_t eventTimes{};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, geometricTimeStepPolicy(dtInit, growthFactor, dtMax), eventTimes);
+  ASSERT_EQ(time.front().time, initTime);
+  ASSERT_EQ(time.back().time, finalTime);
+
+  // Steps grow geometrically until saturation, only the last step can be shortened by the final time
+  scalar_t expectedStep = dtInit;
+  for (int i = 0; i + 2 < time.size(); i++) {
+    ASSERT_NEAR(time[i + 1].time - time[i].time, expectedStep, 1e-12);
+    expectedStep = std::min(growthFactor * expectedStep, dtMax);
+  }
+  ASSERT_LE(time.back().time - time[time.size() - 2].time, expectedStep + 1e-12);
+
+  // Fewer nodes than a uniform grid with the initial step
+  ASSERT_LT(time.size(), timeDiscretizationWithEvents(initTime, finalTime, dtInit, eventTimes).size());
+}
+
+TEST(test_discretization, piecewiseStepsWithEvents) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_array_t eventTimes{0.45};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, piecewiseTimeStepPolicy({0.2}, {0.1, 0.25}), eventTimes);
+  //  timeDiscretization = {0.0, 0.1, 0.2, 0.45, 0.45, 0.7, 0.95, 1.0}
+  ASSERT_EQ(time.size(), 8);
+  ASSERT_EQ(time[0].time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, 0.1);
+  ASSERT_DOUBLE_EQ(time[2].time, 0.2);
+  ASSERT_EQ(time[3].time, eventTimes[0]);
+  ASSERT_EQ(time[4].time, eventTimes[0]);
+  ASSERT_DOUBLE_EQ(time[5].time, 0.7);
+  ASSERT_DOUBLE_EQ(time[6].time, 0.95);
+  ASSERT_EQ(time[7].time, finalTime);
+
+  ASSERT_EQ(time[3].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(time[4].event, AnnotatedTime::Event::PostEvent);
+
+  // Inconsistent list sizes
+  ASSERT_ANY_THROW(piecewiseTimeStepPolicy({0.2}, {0.1}));
+}
+
+TEST(test_discretization, refinement) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 0.4;
+  scalar_t dt = 0.1;
+  scalar_array_t eventTimes{0.2};
+
+  //  timeDiscretization = {0.0, 0.1, 0.2, 0.2, 0.3, 0.4}
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  ASSERT_EQ(time.size(), 6);
+
+  // Errors above tolerance in the first interval, the event interval, and the last interval
+  const scalar_t tolerance = 1.0;
+  const scalar_array_t intervalErrors{2.0, 0.5, 2.0, 0.5, 2.0};
+  auto refinedTime = refineTimeDiscretization(time, intervalErrors, tolerance);
+
+  //  refinedTimeDiscretization = {0.0, 0.05, 0.1, 0.2, 0.2, 0.3, 0.35, 0.4}
+  ASSERT_EQ(refinedTime.size(), 8);
+  ASSERT_DOUBLE_EQ(refinedTime[1].time, 0.05);
+  ASSERT_EQ(refinedTime[1].event, AnnotatedTime::Event::None);
+  ASSERT_EQ(refinedTime[3].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(refinedTime[4].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_DOUBLE_EQ(refinedTime[6].time, 0.35);
+  ASSERT_EQ(refinedTime.back().time, finalTime);
+}
+
+TEST(test_discretization, matchShiftedDiscretization) {
+  scalar_t dt = 0.1;
+  scalar_array_t eventTimes{0.25};
+
+  //  previous = {0.0, 0.1, 0.2, 0.25, 0.25, 0.35, 0.45, 0.5}
+  const auto previousTime = timeDiscretizationWithEvents(0.0, 0.5, dt, eventTimes);
+  //  shifted = {0.1, 0.2, 0.25, 0.25, 0.35, 0.45, 0.55, 0.6}
+  const auto time = timeDiscretizationWithEvents(previousTime[1].time, 0.6, dt, eventTimes);
+  ASSERT_EQ(time.size(), 8);
+
+  const auto matches = matchTimeDiscretization(time, previousTime);
+  ASSERT_EQ(matches.size(), time.size());
+  ASSERT_EQ(matches[0], 1);
+  ASSERT_EQ(matches[1], 2);
+  ASSERT_EQ(matches[2], 3);  // PreEvent
+  ASSERT_EQ(matches[3], 4);  // PostEvent
+  ASSERT_EQ(matches[4], 5);
+  ASSERT_EQ(matches[5], -1);  // Interval [0.45, 0.55] differs from [0.45, 0.5]
+  ASSERT_EQ(matches[6], -1);
+  ASSERT_EQ(matches[7], -1);
+
+  // Identical discretization matches everywhere
+  const auto identity = matchTimeDiscretization(previousTime, previousTime);
+  for (int i = 0; i < identity.size(); i++) {
+    ASSERT_EQ(identity[i], i);
+  }
+}
@@ -60,9 +60,13 @@ TEST(test_transcription, intermediate_performance) {
   const vector_t u = (vector_t(2) << 0.1, 1.3).finished();
   const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x, x_next, u);
 
-  const auto performance = computeIntermediatePerformance(problem, discretizer, t, dt, x, x_next, u);
+  MetricsCollection metrics;
+  const auto performance = computeIntermediatePerformance(problem, discretizer, t, dt, x, x_next, u, &metrics);
 
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
+  ASSERT_DOUBLE_EQ(metrics.cost, transcription.metrics.cost);
+  ASSERT_TRUE(metrics.stateInputEqConstraint.isApprox(transcription.metrics.stateInputEqConstraint));
+  ASSERT_EQ(metrics.stateInputEqConstraint.size(), 1);
 }
 
 TEST(test_transcription, terminal_performance) {
@@ -160,3 +160,61 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, shiftWarmStart) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr(new ocs2::ReferenceManager(targetTrajectories));
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.nThreads = 4;
+  settings.printSolverStatus = true;
+
+  ocs2::multiple_shooting::Settings warmStartSettings = settings;
+  warmStartSettings.shiftWarmStart = true;
+
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  ocs2::MultipleShootingSolver warmStartSolver(warmStartSettings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  warmStartSolver.setReferenceManager(referenceManagerPtr);
+
+  // Receding horizon, shifted by one discretization step each time
+  const ocs2::vector_t initState = ocs2::vector_t::Ones(n);
+  const ocs2::scalar_t horizon = 1.0;
+  ocs2::scalar_t startTime = 0.0;
+  for (int iter = 0; iter < 3; iter++) {
+    solver.run(startTime, initState, startTime + horizon);
+    warmStartSolver.run(startTime, initState, startTime + horizon);
+
+    // Same solution with and without warm start
+    const auto solution = solver.primalSolution(startTime + horizon);
+    const auto warmStartSolution = warmStartSolver.primalSolution(startTime + horizon);
+    ASSERT_EQ(solution.timeTrajectory_.size(), warmStartSolution.timeTrajectory_.size());
+    for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+      ASSERT_DOUBLE_EQ(solution.timeTrajectory_[i], warmStartSolution.timeTrajectory_[i]);
+      ASSERT_TRUE(solution.stateTrajectory_[i].isApprox(warmStartSolution.stateTrajectory_[i], tol));
+      ASSERT_TRUE(solution.inputTrajectory_[i].isApprox(warmStartSolution.inputTrajectory_[i], tol));
+    }
+
+    startTime = solution.timeTrajectory_[1];
+  }
+
+  // The shifted problem overlaps with the converged previous one, the approximation of those nodes is reused with the default tolerance
+  ASSERT_GT(warmStartSolver.getNumReusedNodes(), 0);
+  ASSERT_EQ(solver.getNumReusedNodes(), 0);
+}